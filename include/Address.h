@@ -2,33 +2,35 @@
 #define ADDRESS_H
 
 #include <string>
+#include <utility>
+#include "StringPool.h"
 using namespace std;
 
 class Address {
 private:
     int id;
     string line;
-    string city;
-    string state;
+    InternedString city;            // pooled: repeats across customers
+    InternedString state;
     string postalCode;
-    string country;
+    InternedString country;
     int isDefaultFlag;
 
 public:
-    Address() {}
+    Address() : id(0), isDefaultFlag(0) {}
 
-    Address(int _id, string _line, string _city, string _state,
-            string _postalCode, string _country, int _isDefault)
-        : id(_id), line(_line), city(_city), state(_state),
-          postalCode(_postalCode), country(_country),
+    Address(int _id, string _line, const string &_city, const string &_state,
+            string _postalCode, const string &_country, int _isDefault)
+        : id(_id), line(std::move(_line)), city(_city), state(_state),
+          postalCode(std::move(_postalCode)), country(_country),
           isDefaultFlag(_isDefault) {}
 
     int getId() const { return id; }
-    string getLine() const { return line; }
-    string getCity() const { return city; }
-    string getState() const { return state; }
-    string getPostalCode() const { return postalCode; }
-    string getCountry() const { return country; }
+    const string& getLine() const { return line; }
+    const string& getCity() const { return city; }
+    const string& getState() const { return state; }
+    const string& getPostalCode() const { return postalCode; }
+    const string& getCountry() const { return country; }
 
     // NEW CLEAN NAME
     bool isDefault() const { return isDefaultFlag == 1; }
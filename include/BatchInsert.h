@@ -0,0 +1,46 @@
+#ifndef BATCHINSERT_H
+#define BATCHINSERT_H
+
+#include <string>
+#include <cppconn/connection.h>
+#include <cppconn/prepared_statement.h>
+
+// Multi-row INSERT helper.
+// Builds "<prefix> VALUES (?,..),(?,..) <suffix>" once per row count and keeps
+// the full-size statement prepared, so a batch of N rows is one round trip.
+// Parameters are bound with param(row, col) (both 0-based).
+class MultiRowStatement {
+private:
+    sql::Connection* con;
+    std::string prefix;
+    std::string suffix;
+    int columns;
+    size_t batchRows;
+
+    sql::PreparedStatement* fullStmt;     // prepared for batchRows rows
+    sql::PreparedStatement* tailStmt;     // last short batch
+    size_t tailRows;
+
+    std::string buildSQL(size_t rows) const;
+
+public:
+    MultiRowStatement(sql::Connection* con, const std::string &prefix,
+                      int columns, size_t batchRows,
+                      const std::string &suffix = "");
+    ~MultiRowStatement();
+
+    MultiRowStatement(const MultiRowStatement&) = delete;
+    MultiRowStatement& operator=(const MultiRowStatement&) = delete;
+
+    size_t getBatchRows() const { return batchRows; }
+
+    // Returns the statement for `rows` rows (1..batchRows), parameters cleared.
+    sql::PreparedStatement* begin(size_t rows);
+
+    // 1-based parameter index for (row, col)
+    unsigned int param(size_t row, int col) const {
+        return (unsigned int)(row * columns + col + 1);
+    }
+};
+
+#endif
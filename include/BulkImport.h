@@ -0,0 +1,57 @@
+#ifndef BULKIMPORT_H
+#define BULKIMPORT_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Bulk catalog import: loads a product feed (CSV with header row, or JSON
+// lines with flat objects) into PRODUCT and Supplier.
+//
+// Recognised fields (case-insensitive):
+//   Product_ID, Product_Name, Category, Subcategory, Price, Stock_Qtn,
+//   Company_name, ExpiryDate, SID, Sname, Supplier_Contact, Supplier_Email,
+//   Supplier_Address
+// Product_ID may be omitted (AUTO_INCREMENT assigns one); existing IDs are
+// updated in place. Supplier columns are optional; when Sname is present
+// each distinct SID is upserted once, before the products that reference it.
+//
+// The file is split into chunks on line boundaries and parsed in parallel,
+// so quoted CSV fields must not contain newlines.
+
+enum class FeedFormat { CSV, JSONL };
+
+struct ImportOptions {
+    FeedFormat format = FeedFormat::CSV;
+    int parseThreads = 0;         // 0 = hardware_concurrency
+    int writerConnections = 4;    // parallel DB connections for writing
+    size_t batchRows = 1000;      // rows per multi-row INSERT
+    bool dryRun = false;          // parse + validate only
+};
+
+struct ImportStats {
+    size_t rowsRead = 0;
+    size_t rowsRejected = 0;
+    size_t productsWritten = 0;
+    size_t suppliersWritten = 0;
+    size_t distinctCategories = 0;
+    size_t distinctCompanies = 0;
+    double parseSeconds = 0.0;
+    double writeSeconds = 0.0;
+    std::vector<std::string> errors;   // first few rejected rows (line: reason)
+
+    double totalSeconds() const { return parseSeconds + writeSeconds; }
+    double rowsPerSecond() const {
+        double t = totalSeconds();
+        return t > 0.0 ? rowsRead / t : 0.0;
+    }
+};
+
+// Runs the whole pipeline. Returns false if the file could not be read or
+// any batch failed to write (already-committed batches stay committed).
+bool importProductFeed(const std::string &path, const ImportOptions &opt, ImportStats &stats);
+
+// Guess the format from the extension (.jsonl / .ndjson / .json -> JSONL).
+FeedFormat feedFormatFromPath(const std::string &path);
+
+#endif
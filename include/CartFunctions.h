@@ -2,7 +2,9 @@
 #define CARTFUNCTIONS_H
 
 #include "Cart.h"
+#include "CartSnapshot.h"
 #include <vector>
+#include <utility>
 #include <cppconn/connection.h>
 
 bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty);
@@ -11,6 +13,15 @@ bool removeFromCart(sql::Connection* con, int customer_id, int product_id);
 bool updateCartQuantity(sql::Connection* con, int customer_id, int product_id, int newQty);
 bool checkoutCart(sql::Connection* con, int customer_id);
 
+// Add many (product, quantity) lines in one stock-validated batch: one read of
+// stock and current cart quantities, then one multi-row upsert. Lines that do
+// not fully fit are added with what is left (possibly nothing) and listed in
+// `shortfalls` (available = quantity actually added). `addedLines` counts the
+// lines that added anything. Needs UNIQUE (Customer_ID, Product_ID) on Cart.
+bool addManyToCart(sql::Connection* con, int customer_id,
+                   const std::vector<std::pair<int, int>> &productQty,
+                   std::vector<StockShortfall> &shortfalls, int &addedLines);
+
 void runCartMenu(sql::Connection* con, int customer_id);
 
 #endif
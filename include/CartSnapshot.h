@@ -0,0 +1,69 @@
+#ifndef CARTSNAPSHOT_H
+#define CARTSNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cppconn/connection.h>
+#include "Money.h"
+
+// A customer's cart read once (Cart ⋈ PRODUCT) and passed along the whole
+// checkout: shown to the user, checked against stock, then turned into the
+// order. version() fingerprints the (product, quantity) lines; order creation
+// re-reads the Cart rows under lock and refuses if the fingerprint differs,
+// so a cart edited from another session is reported instead of ordered.
+
+struct CartLine {
+    int productId;
+    std::string name;
+    int quantity;
+    Money price;        // PRODUCT.Price when loaded; charged as shown
+    int stock;          // Stock_Qtn when loaded / last checked
+
+    Money subtotal() const { return price * quantity; }
+};
+
+struct StockShortfall {
+    int productId;
+    std::string name;
+    int requested;
+    int available;      // 0 when the product no longer exists
+};
+
+class CartSnapshot {
+private:
+    int customerId;
+    std::vector<CartLine> lines;    // ordered by product id
+    uint64_t fingerprint;
+
+    // lines' quantity and price as flat columns, for the batched total
+    std::vector<int32_t> quantities;
+    std::vector<int64_t> pricesPaise;
+
+    bool loadSharded(sql::Connection* global, sql::Connection* shard);
+
+public:
+    CartSnapshot();
+
+    // Read the cart; false on SQL error (the snapshot is then empty)
+    bool load(sql::Connection* con, int customerId);
+
+    int getCustomerId() const { return customerId; }
+    const std::vector<CartLine>& getLines() const { return lines; }
+    bool empty() const { return lines.empty(); }
+    Money total() const;
+    uint64_t version() const { return fingerprint; }
+
+    // Refresh stock of every line in one query and list the lines that
+    // cannot be filled. False on SQL error.
+    bool checkStock(sql::Connection* con, std::vector<StockShortfall> &shortfalls);
+
+    // Table of lines with subtotals and the total
+    void print(const std::string &title) const;
+};
+
+// Fingerprint of (product id, quantity) pairs sorted by product id
+uint64_t cartVersion(const std::vector<std::pair<int, int>> &productQty);
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef CATALOGCACHE_H
+#define CATALOGCACHE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <cppconn/connection.h>
+#include "Product.h"
+#include "Supplier.h"
+#include "ExpiryIndex.h"
+#include "StringPool.h"
+
+// Stock levels of a catalog's products, by products[] index. Counted in
+// place: patched copies of a catalog share their original's table.
+struct LiveStock {
+    std::unique_ptr<std::atomic<int>[]> qty;
+    size_t size = 0;
+};
+
+// In-memory catalog, built once and published as an immutable whole.
+// Readers grab the shared_ptr and never see a half-built catalog. Stock is
+// the exception: read it with stockOf(), not Product::getStock().
+struct CatalogData {
+    std::vector<InternedString> categories;                       // sorted
+    std::map<InternedString, std::vector<InternedString>> subcategories;  // category -> sorted list
+    std::vector<Product> products;                                // sorted by id
+    std::unordered_map<int, size_t> productIndex;                 // id -> products[]
+    std::map<std::pair<InternedString, InternedString>, std::vector<size_t>> byGroup;  // (cat, sub) -> products[]
+    std::unordered_map<int, int> productSupplier;                 // product id -> SID
+    std::unordered_map<int, Supplier> suppliers;                  // SID -> supplier
+    ExpiryIndex expiry;                                           // products by expiry date
+    std::shared_ptr<LiveStock> stock;                             // current stock, see LiveStock
+
+    const Product* findProduct(int productId) const;
+    const Supplier* supplierFor(int productId) const;
+
+    // Current stock of `p`, which must be one of this catalog's products
+    int stockOf(const Product &p) const;
+
+    // Start the stock table from the products' loaded Stock_Qtn
+    void initStock();
+};
+
+std::shared_ptr<const CatalogData> catalogCache();
+void publishCatalog(std::shared_ptr<const CatalogData> data);
+
+// Applies `patch` to a copy of the current catalog and publishes it. If
+// another publish lands first, the patch is redone on that catalog, so no
+// update is lost. Returns false (and does nothing) while the catalog is
+// not warm.
+bool updateCatalog(const std::function<void(CatalogData &)> &patch);
+
+// Subtracts (product id, quantity) sales from the cached stock in place, so
+// lists show stock this process sold without waiting for the change feed or
+// a re-warm. No-op while the catalog is not warm.
+void adjustCatalogStock(const std::vector<std::pair<int, int>> &sold);
+
+// Sets the cached stock of (product id, quantity) pairs read from the database
+void setCatalogStock(const std::vector<std::pair<int, int>> &levels);
+
+struct WarmupStats {
+    double millis = 0.0;           // start -> publish
+    size_t products = 0;
+    size_t suppliers = 0;
+    size_t categories = 0;
+    int connections = 0;
+    bool ok = false;
+};
+
+// Fetches categories, subcategories, suppliers and products over a pool of
+// `connections` connections in parallel and publishes the result.
+// Time-to-warm is appended to the metrics log (PROJECT1_METRICS_LOG, default
+// ./project1_metrics.log) so startup regressions show up over time.
+class CatalogWarmup {
+private:
+    int connections;
+    std::thread worker;
+    WarmupStats stats;
+
+public:
+    explicit CatalogWarmup(int connections = 4);
+    ~CatalogWarmup();                // waits for a running warm-up
+
+    CatalogWarmup(const CatalogWarmup&) = delete;
+    CatalogWarmup& operator=(const CatalogWarmup&) = delete;
+
+    void start();                    // returns immediately
+    const WarmupStats& wait();       // blocks until done
+};
+
+// Runs the warm-up on the calling thread (used by CatalogWarmup and tools).
+WarmupStats warmCatalogCache(int connections);
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef CATALOGSNAPSHOT_H
+#define CATALOGSNAPSHOT_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cppconn/connection.h>
+#include "Date.h"
+#include "Money.h"
+
+// Binary, memory-mapped snapshot of the product catalog.
+//
+// File layout (little-endian, every section 8-byte aligned):
+//   SnapshotHeader
+//   columns       : id, price (int64 paise), stock, expiry (days since epoch),
+//                   name offsets + heap, and dictionary codes for
+//                   category / subcategory / company / supplier
+//   dictionaries  : sorted distinct strings for each coded column
+//   indexes       : (id -> row) sorted by id, and (category, subcategory) ->
+//                   row range, rows being ordered by (category, subcategory, id)
+//
+// The payload is covered by a 64-bit checksum and the header carries a
+// fingerprint of the PRODUCT table at build time, used to detect staleness.
+
+const uint32_t SNAPSHOT_VERSION = 3;      // 2: expiry as packed days, 3: price as paise
+
+enum SnapshotSection {
+    SEC_IDS, SEC_PRICE, SEC_STOCK, SEC_NAME_OFFSETS, SEC_NAME_HEAP,
+    SEC_CATEGORY, SEC_SUBCATEGORY, SEC_COMPANY, SEC_EXPIRY, SEC_SUPPLIER,
+    SEC_DICT_CATEGORY, SEC_DICT_SUBCATEGORY, SEC_DICT_COMPANY,
+    SEC_DICT_SUPPLIER, SEC_ID_INDEX, SEC_GROUPS,
+    SECTION_COUNT
+};
+
+struct SnapshotHeader {
+    char magic[8];                  // "P1CATSNP"
+    uint32_t version;
+    uint32_t productCount;
+    uint64_t createdAt;             // unix seconds
+    uint64_t fingerprint;           // catalogFingerprint() at build time
+    uint64_t checksum;              // over everything after the header
+    uint64_t payloadSize;
+    uint64_t sectionOffset[SECTION_COUNT];   // from start of file
+    uint64_t sectionSize[SECTION_COUNT];
+};
+
+// One product as seen through the snapshot (views point into the mapping)
+struct SnapshotProduct {
+    int id;
+    std::string_view name;
+    std::string_view category;
+    std::string_view subcategory;
+    std::string_view company;
+    Date expiry;
+    std::string_view supplier;
+    Money price;
+    int stock;
+};
+
+class CatalogSnapshot {
+private:
+    const char* base;
+    size_t length;
+    const SnapshotHeader* header;
+
+    template <typename T>
+    const T* section(SnapshotSection s) const {
+        return reinterpret_cast<const T*>(base + header->sectionOffset[s]);
+    }
+    std::string_view dictString(SnapshotSection dict, uint32_t code) const;
+    uint32_t dictCount(SnapshotSection dict) const;
+    int dictFind(SnapshotSection dict, const std::string &value) const;   // -1 if absent
+    SnapshotProduct rowAt(uint32_t row) const;
+
+public:
+    CatalogSnapshot();
+    ~CatalogSnapshot();
+
+    CatalogSnapshot(const CatalogSnapshot&) = delete;
+    CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+
+    // mmap the file and verify magic, version, bounds and checksum
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Stale when older than maxAgeSeconds or, if con is given, when PRODUCT no
+    // longer matches the fingerprint it was built from. Pass con = nullptr for
+    // the age-only check used at startup (the writer verifies the fingerprint).
+    bool isStale(sql::Connection* con, long maxAgeSeconds) const;
+
+    size_t productCount() const { return header ? header->productCount : 0; }
+    uint64_t fingerprint() const { return header ? header->fingerprint : 0; }
+    uint64_t createdAt() const { return header ? header->createdAt : 0; }
+
+    std::vector<std::string> categories() const;
+    std::vector<std::string> subcategories(const std::string &category) const;
+    std::vector<SnapshotProduct> productsIn(const std::string &category,
+                                            const std::string &subcategory) const;
+    bool findProduct(int productId, SnapshotProduct &out) const;
+};
+
+// One aggregate pass over PRODUCT (row count, max id, stock and price sums,
+// CRC of the descriptive columns). Returns 0 on error.
+uint64_t catalogFingerprint(sql::Connection* con);
+
+// Build a snapshot from the DB and atomically replace `path` (tmp + rename).
+bool writeCatalogSnapshot(sql::Connection* con, const std::string &path);
+
+// Background job: every intervalSeconds, rebuild the snapshot on its own
+// connection if the catalog fingerprint changed, then make the new file the
+// active snapshot.
+void startSnapshotWriter(const std::string &path, int intervalSeconds);
+void stopSnapshotWriter();
+
+// Default location (PROJECT1_CATALOG_SNAPSHOT or ./catalog.snap)
+std::string defaultSnapshotPath();
+
+// Snapshot the loaders serve from (empty = go to the DB). Callers keep the
+// shared_ptr for as long as they use views into it.
+std::shared_ptr<const CatalogSnapshot> activeCatalogSnapshot();
+void setActiveCatalogSnapshot(std::shared_ptr<const CatalogSnapshot> snap);
+
+#endif
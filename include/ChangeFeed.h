@@ -0,0 +1,66 @@
+#ifndef CHANGEFEED_H
+#define CHANGEFEED_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cppconn/connection.h>
+
+// Change-data capture for the in-process caches.
+//
+// Triggers on PRODUCT and Supplier append one CHANGE_LOG row per
+// changed row (see installChangeFeed()), whichever process made the change.
+// A background consumer tails CHANGE_LOG by sequence number and applies
+// targeted invalidations:
+//
+//   PRODUCT stock/price only (Q)  patch stock and price in the catalog cache,
+//                                 forget the prefetched details, drop the
+//                                 stock- and price-ordered query results
+//   PRODUCT insert/update/delete  forget the prefetched details, clear the
+//                                 query results, re-warm the catalog cache
+//   Supplier                      drop prefetched details, re-warm the catalog
+//
+// The consumer reads through the replica when one is configured, so it
+// invalidates only once the replica (where the caches refill from) has the
+// change.
+
+struct ChangeEvent {
+    int64_t seq;
+    std::string table;      // "PRODUCT" or "Supplier"
+    char op;                // 'I', 'U', 'D', or 'Q' (PRODUCT stock/price-only update)
+    int rowKey;             // Product_ID or SID
+};
+
+// Create CHANGE_LOG and (re)create its triggers. Needs the TRIGGER privilege.
+bool installChangeFeed(sql::Connection* con);
+
+// Drop the triggers (CHANGE_LOG itself is kept). Both also drop the Cart
+// triggers older versions installed.
+bool uninstallChangeFeed(sql::Connection* con);
+
+// Delete CHANGE_LOG rows older than `hours`; returns rows deleted, -1 on error
+long pruneChangeLog(sql::Connection* con, int hours);
+
+// Events after `afterSeq` plus any of `gapSeqs` that have since committed,
+// in sequence order. Throws sql::SQLException (ER_NO_SUCH_TABLE when there
+// is no CHANGE_LOG).
+void readChanges(sql::Connection* con, int64_t afterSeq, const std::vector<int64_t> &gapSeqs,
+                 size_t limit, std::vector<ChangeEvent> &out);
+
+// Apply a batch to this process's caches (what the consumer does per poll).
+// Catalog cache patches and re-warms need a connection and run on the
+// consumer's next pass.
+void applyChanges(const std::vector<ChangeEvent> &events);
+
+// Current end of CHANGE_LOG, or -1 if it cannot be read. Take it before
+// warming caches and start the feed from it, so nothing in between is missed.
+int64_t changeLogPosition(sql::Connection* con);
+
+// Background consumer: follows CHANGE_LOG after fromSeq (-1 = its current
+// end) and polls every intervalMs. Full catalog re-warms use
+// warmConnections connections. Stops by itself (with a message) if
+// CHANGE_LOG does not exist.
+void startChangeFeed(int64_t fromSeq, int intervalMs, int warmConnections);
+void stopChangeFeed();
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cppconn/connection.h>
+
+// Fixed-size pool of MySQL connections.
+// Connections are opened lazily (up to `size`) and handed out as RAII leases;
+// acquire() blocks while every connection is leased.
+class ConnectionPool {
+public:
+    using Factory = std::function<sql::Connection*()>;
+
+    class Lease {
+    private:
+        ConnectionPool* pool;
+        sql::Connection* con;
+    public:
+        Lease() : pool(nullptr), con(nullptr) {}
+        Lease(ConnectionPool* p, sql::Connection* c) : pool(p), con(c) {}
+        Lease(Lease &&o) noexcept : pool(o.pool), con(o.con) { o.pool = nullptr; o.con = nullptr; }
+        Lease& operator=(Lease &&o) noexcept;
+        ~Lease() { release(); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        sql::Connection* get() const { return con; }
+        sql::Connection* operator->() const { return con; }
+        explicit operator bool() const { return con != nullptr; }
+
+        // Return to the pool now. Pass broken = true if the connection failed
+        // so the pool closes it and opens a fresh one next time.
+        void release(bool broken = false);
+    };
+
+    ConnectionPool(size_t size, Factory factory);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Throws sql::SQLException if a new connection cannot be opened.
+    Lease acquire();
+
+    size_t size() const { return maxSize; }
+
+private:
+    size_t maxSize;
+    Factory factory;
+    std::mutex mtx;
+    std::condition_variable available;
+    std::vector<sql::Connection*> idle;
+    size_t opened;
+
+    void giveBack(sql::Connection* con, bool broken);
+};
+
+#endif
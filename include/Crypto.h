@@ -0,0 +1,32 @@
+#ifndef CRYPTO_H
+#define CRYPTO_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// Small self-contained primitives (no OpenSSL dependency).
+// All functions take and return raw byte strings unless named *Hex.
+
+std::string sha256(const std::string &data);                 // 32 bytes
+std::string hmacSha256(const std::string &key, const std::string &msg);
+
+// PBKDF2-HMAC-SHA256 (RFC 8018)
+std::string pbkdf2Sha256(const std::string &password, const std::string &salt,
+                         unsigned iterations, size_t dkLen);
+
+// scrypt (RFC 7914): memory-hard KDF using 128 * r * N bytes of RAM.
+// N must be a power of two > 1.
+std::string scrypt(const std::string &password, const std::string &salt,
+                   uint64_t N, unsigned r, unsigned p, size_t dkLen);
+
+std::string toHex(const std::string &bytes);
+bool fromHex(const std::string &hex, std::string &bytes);
+
+// Compares without early exit, so timing does not leak the mismatch position
+bool constantTimeEquals(const std::string &a, const std::string &b);
+
+// Bytes from std::random_device (the OS CSPRNG on Linux)
+std::string randomBytes(size_t n);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef CUSTOMER_H
 #define CUSTOMER_H
 #include <string>
+#include <utility>
 class Customer{
     private:
         int id;
@@ -13,24 +14,24 @@ class Customer{
         Customer();
 
         Customer(int i,
-             const std::string& n,
-             const std::string& num,
-             const std::string& e,
-             const std::string& add);
+             std::string n,
+             std::string num,
+             std::string e,
+             std::string add);
 
         // Getters
         int getId() const { return id; }
-        std::string getName() const { return name; }
-        std::string getContactnumber() const { return cont_num; }
-        std::string getEmail() const { return email; }
-        std::string getAddress() const { return address; }
+        const std::string& getName() const { return name; }
+        const std::string& getContactnumber() const { return cont_num; }
+        const std::string& getEmail() const { return email; }
+        const std::string& getAddress() const { return address; }
 
         // Setters
         void setId(int id) { this->id = id; }
-        void setName(const std::string& name) { this->name = name; }
-        void setContactnumber(const std::string& cnumber) { this->cont_num = cnumber; }
-        void setEmail(const std::string& eml) { this-> email = eml; }
-        void setAddress(const std::string& ad) {this-> address = ad; }
+        void setName(std::string name) { this->name = std::move(name); }
+        void setContactnumber(std::string cnumber) { this->cont_num = std::move(cnumber); }
+        void setEmail(std::string eml) { this->email = std::move(eml); }
+        void setAddress(std::string ad) { this->address = std::move(ad); }
 
 };
 
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <memory_resource>
 
 // MySQL Connector/C++ headers
 #include <mysql_driver.h>
@@ -16,6 +17,8 @@
 #include "Order.h"
 #include "OrderItem.h"
 #include "Address.h"
+#include "CartSnapshot.h"
+#include "Money.h"
 
 
 using namespace std;
@@ -42,6 +45,7 @@ vector<string> loadSubcategories(sql::Connection* con, const string &category);
 // Customer details 
 //-----------------
 void inputCustomerDetails(sql::Connection* con, const std::string& emailFromLogin);
+Customer promptCustomerDetails(const std::string& emailFromLogin);
 void insertCustomerDetails(sql::Connection* con, const Customer& c);
 
 void displayProductDetailsById(int productId);
@@ -56,11 +60,16 @@ int getCustomerIdByEmail(sql::Connection* con, const std::string& email);
 // Creates an order from the cart
 bool createOrderFromCart(sql::Connection* con, int customerId, int &orderId);
 
+// Result loaders take an optional memory resource (usually a RequestArena)
+// that the returned vector, and any strings in it, are allocated from.
+
 // Load all orders of a customer (most recent first)
-std::vector<Order> loadOrdersForCustomer(sql::Connection* con, int customerId);
+std::pmr::vector<Order> loadOrdersForCustomer(sql::Connection* con, int customerId,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
 
-// Load all items in a particular order
-std::vector<OrderItem> loadOrderItems(sql::Connection* con, int orderId);
+// Load all items in a particular order of a customer
+std::pmr::vector<OrderItem> loadOrderItems(sql::Connection* con, int customerId, int orderId,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
 
 // Fetch a Customer by ID
 bool getCustomerById(sql::Connection* con, int customerId, Customer &outCustomer);
@@ -74,11 +83,24 @@ bool updateLoginPassword(sql::Connection* con, const std::string &email, const s
 // create order from cart; sets created orderId
 bool createOrderFromCart(sql::Connection* con, int customerId, int addressId, int &orderId);
 
-// load orders (most recent first)
-std::vector<Order> loadOrdersForCustomer(sql::Connection* con, int customerId);
-
-// load order items
-std::vector<OrderItem> loadOrderItems(sql::Connection* con, int orderId);
+enum OrderResult {
+    ORDER_OK,
+    ORDER_EMPTY_CART,
+    ORDER_CART_CHANGED,     // Cart rows differ from the snapshot's version
+    ORDER_OUT_OF_STOCK,     // some line exceeds current stock; nothing written
+    ORDER_UNCONFIRMED,      // sharded: the order's commit failed and whether it
+                            // went through could not be checked; stock stays taken
+    ORDER_ERROR
+};
+
+// Create the order from a cart snapshot in one transaction: locks the Cart
+// rows, checks them against cart.version(), writes Orders/OrderItems at the
+// snapshot prices, clears the cart and finally takes the quantities off
+// PRODUCT in one conditional UPDATE. If any line is short the whole order is
+// rolled back and, when `shortfalls` is given, the short lines are listed.
+OrderResult createOrderFromSnapshot(sql::Connection* con, const CartSnapshot &cart,
+                                    int addressId, int &orderId,
+                                    std::vector<StockShortfall>* shortfalls = nullptr);
 
 // customer helpers
 bool getCustomerById(sql::Connection* con, int customerId, Customer &outCustomer);
@@ -86,10 +108,18 @@ bool updateCustomerDetails(sql::Connection* con, const Customer &c);
 bool updateLoginPassword(sql::Connection* con, const std::string &email, const std::string &newPassword);
 
 // ---- PRODUCT SEARCH ----
-vector<int> searchProductsByName(sql::Connection* con, const string &name);
-vector<int> searchProductsByCompany(sql::Connection* con, const string &company);
-vector<int> searchProductsByCategory(sql::Connection* con, const string &category);
-vector<int> searchProductsByPriceRange(sql::Connection* con, double minPrice, double maxPrice);
+std::pmr::vector<int> searchProductsByName(sql::Connection* con, const string &name,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+std::pmr::vector<int> searchProductsByCompany(sql::Connection* con, const string &company,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+std::pmr::vector<int> searchProductsByCategory(sql::Connection* con, const string &category,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+std::pmr::vector<int> searchProductsByPriceRange(sql::Connection* con, Money minPrice, Money maxPrice,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+// Products expiring today or within `days` days, soonest first. Served from
+// the catalog cache's expiry index when warm, else an ExpiryDate range query.
+vector<int> productsExpiringWithin(sql::Connection* con, int days);
 
 vector<int> sortProductsByPriceAsc(sql::Connection*, const string&, const string&);
 vector<int> sortProductsByPriceDesc(sql::Connection*, const string&, const string&);
@@ -97,11 +127,11 @@ vector<int> sortProductsByName(sql::Connection*, const string&, const string&);
 vector<int> sortProductsByStock(sql::Connection*, const string&, const string&);
 
 vector<int> filterProductsByCompany(sql::Connection*, const string&, const string&, const string&);
-vector<int> filterProductsByPriceRange(sql::Connection*, const string&, const string&, float, float);
+vector<int> filterProductsByPriceRange(sql::Connection*, const string&, const string&, Money, Money);
 void displayCompactProductRow(sql::Connection* con, int productId, int index);
 bool addAddress(sql::Connection* con, int customerId, const string &line, const string &city, const string &state, const string &pincode);
 vector<pair<int,string>> loadAddresses(sql::Connection* con, int customerId);
-bool deleteAddress(sql::Connection* con, int addressId);
+bool deleteAddress(sql::Connection* con, int customerId, int addressId);
 vector<Address> loadFullAddresses(sql::Connection* con, int customerId);
 
 #endif // DBFUNCTIONS_H
@@ -0,0 +1,48 @@
+#ifndef DBROUTER_H
+#define DBROUTER_H
+
+#include <string>
+#include <cppconn/connection.h>
+
+// Read/write splitting between a primary and an (optional) replica.
+//
+// Endpoints come from the environment:
+//   PROJECT1_DB_PRIMARY   tcp://host:port of the primary (default tcp://127.0.0.1:3306)
+//   PROJECT1_DB_REPLICA   tcp://host:port of a read replica (unset = no splitting)
+//   PROJECT1_DB_USER, PROJECT1_DB_PASSWORD, PROJECT1_DB_SCHEMA   shared credentials
+//   PROJECT1_DB_STICKY_SECONDS   read-your-writes window (default 5)
+//
+// Writes always use the connection the caller already holds (the primary).
+// Read-only functions pass that connection through routeRead(), which swaps
+// in a per-thread replica connection unless the caller wrote recently.
+
+enum DBRole { DB_PRIMARY, DB_REPLICA };
+
+struct DBEndpoint {
+    std::string url;
+    std::string user;
+    std::string password;
+    std::string schema;
+};
+
+// false when role is DB_REPLICA and no replica is configured
+bool dbEndpoint(DBRole role, DBEndpoint &out);
+
+// New connection to `ep` with its schema selected. Caller owns it.
+sql::Connection* openConnection(const DBEndpoint &ep);
+
+// New connection to the replica, or to the primary when no replica is
+// configured or it cannot be reached. Caller owns it (bulk readers, warm-up).
+sql::Connection* createReadConnection();
+
+// Connection to run a read on. Returns `primary` when no replica is usable,
+// when this thread wrote within the sticky window, or when `customerId` wrote
+// within the window from any thread; otherwise this thread's replica
+// connection (opened on first use, closed when the thread exits, and pinged
+// at most every 10 seconds rather than on every call).
+sql::Connection* routeRead(sql::Connection* primary, int customerId = 0);
+
+// Record a committed write so following reads see it (0 = not customer-specific)
+void noteWrite(int customerId = 0);
+
+#endif
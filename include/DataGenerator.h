@@ -0,0 +1,65 @@
+#ifndef DATAGENERATOR_H
+#define DATAGENERATOR_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Synthetic dataset generator for load and scaling tests.
+//
+// Fills Supplier, PRODUCT, CUSTOMER_DETAILS, LOGIN, ADDRESS, Cart, WISHLIST,
+// Orders and OrderItems to the requested sizes. Every row is a pure function
+// of (seed, table, row number), so the same options always produce the same
+// data no matter how many writer threads are used.
+//
+// Skew:
+//   - product popularity (cart, wishlist, order lines) is Zipfian, with the
+//     popular ranks scattered over the id range rather than the lowest ids
+//   - brands and suppliers are Zipfian too (a few big ones, a long tail)
+//   - a Zipfian share of customers places most of the orders
+//
+// New rows are appended after the current MAX(id) of each table, so the
+// generator can run on top of the seeded 400-product database.
+// All generated logins share one password (GenOptions::password).
+
+struct GenOptions {
+    uint64_t seed = 1;
+
+    size_t suppliers = 500;
+    size_t brands = 0;              // 0 = products / 100 (at least 20)
+    size_t products = 100000;
+    size_t customers = 10000;
+    size_t orders = 50000;
+    size_t orderItems = 150000;     // spread evenly over the orders
+    size_t cartRows = 20000;
+    size_t wishlistRows = 20000;
+
+    double zipfExponent = 1.0;      // popularity skew (0 = uniform)
+    std::string asOf = "2026-01-01";   // orders fall in the two years before
+    std::string password = "Shopper#2024";
+
+    int writerConnections = 4;
+    size_t batchRows = 1000;
+    bool dryRun = false;            // generate and checksum only
+};
+
+struct GenTableStats {
+    std::string table;
+    size_t rows = 0;
+    double seconds = 0.0;
+    uint64_t checksum = 0;          // order-independent digest of the rows
+
+    double rowsPerSecond() const { return seconds > 0.0 ? rows / seconds : 0.0; }
+};
+
+struct GenStats {
+    std::vector<GenTableStats> tables;
+    double totalSeconds = 0.0;
+};
+
+// Returns false if the options are invalid or any batch failed to write
+// (already-committed batches stay committed).
+bool generateDataset(const GenOptions &opt, GenStats &stats);
+
+#endif
@@ -2,18 +2,79 @@
 #define DATE_H
 
 #include <string>
+#include <cstdint>
 using namespace std;
 
+// Civil date <-> days since 1970-01-01 (proleptic Gregorian), after Howard
+// Hinnant's days_from_civil / civil_from_days. Usable at compile time.
+constexpr int32_t daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (unsigned)(m > 2 ? m - 3 : m + 9) + 2) / 5 + (unsigned)d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+struct CivilDate {
+    int year;
+    int month;
+    int day;
+};
+
+constexpr CivilDate civilFromDays(int32_t z) {
+    z += 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    const int d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    const int m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    return CivilDate{ (int)yoe + era * 400 + (m <= 2), m, d };
+}
+
+// A calendar date packed into one int32 (days since 1970-01-01), so dates
+// compare, sort and subtract as integers. Default-constructed dates are unset
+// (NULL in the DB) and order before every real date.
 class Date {
+private:
+    int32_t days;
+
 public:
-    int day;
-    int month;
-    int year;
+    static constexpr int32_t NONE = INT32_MIN;
+
+    constexpr Date() : days(NONE) {}
+    constexpr Date(int d, int m, int y) : days(daysFromCivil(y, m, d)) {}
+
+    static constexpr Date fromDays(int32_t n) { Date x; x.days = n; return x; }
+    static Date fromSQL(const string &s);     // "YYYY-MM-DD[...]"; unset if NULL/malformed
+    static Date today();                      // local time
 
-    Date();
-    Date(int d, int m, int y);
-    void setDate(int d, int m, int y);
-    string toSQL();
+    void setDate(int d, int m, int y) { days = daysFromCivil(y, m, d); }
+
+    constexpr bool isSet() const { return days != NONE; }
+    constexpr int32_t toDays() const { return days; }
+    constexpr int day() const { return civilFromDays(days).day; }
+    constexpr int month() const { return civilFromDays(days).month; }
+    constexpr int year() const { return civilFromDays(days).year; }
+
+    string toSQL() const;                     // "YYYY-MM-DD", or "" when unset
+
+    constexpr Date operator+(int n) const { return isSet() ? fromDays(days + n) : *this; }
+    constexpr Date operator-(int n) const { return *this + (-n); }
+    constexpr int operator-(const Date &o) const { return days - o.days; }
+    constexpr bool operator==(const Date &o) const { return days == o.days; }
+    constexpr bool operator!=(const Date &o) const { return days != o.days; }
+    constexpr bool operator<(const Date &o) const { return days < o.days; }
+    constexpr bool operator<=(const Date &o) const { return days <= o.days; }
+    constexpr bool operator>(const Date &o) const { return days > o.days; }
+    constexpr bool operator>=(const Date &o) const { return days >= o.days; }
 };
 
+static_assert(sizeof(Date) == 4, "Date is one packed int32");
+static_assert(Date(1, 1, 1970).toDays() == 0, "epoch");
+static_assert(Date(29, 2, 2024).toDays() == 19782, "leap day");
+static_assert(civilFromDays(19782).month == 2 && civilFromDays(19782).day == 29, "round trip");
+
 #endif
@@ -0,0 +1,44 @@
+#ifndef EXPIRYINDEX_H
+#define EXPIRYINDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Date.h"
+
+// Products ordered by expiry date, for expiry sweeps.
+// One (expiry, product id) pair per product that has an expiry date, sorted,
+// so "expiring between A and B" is two binary searches and a contiguous copy.
+class ExpiryIndex {
+private:
+    struct Entry {
+        int32_t expiry;     // Date::toDays()
+        int32_t productId;
+
+        bool operator<(const Entry &o) const {
+            return expiry != o.expiry ? expiry < o.expiry : productId < o.productId;
+        }
+    };
+    std::vector<Entry> entries;
+
+public:
+    // Collect with add(), then finish() once; lookups need a finished index
+    void reserve(size_t n) { entries.reserve(n); }
+    void add(int productId, Date expiry);
+    void finish();
+
+    size_t size() const { return entries.size(); }
+
+    // Product ids with from <= expiry <= to, soonest first
+    std::vector<int> expiringBetween(Date from, Date to) const;
+
+    // Expiring today or within the next `days` days
+    std::vector<int> expiringWithin(int days, Date today = Date::today()) const {
+        return expiringBetween(today, today + days);
+    }
+
+    // Already past their expiry date
+    std::vector<int> expiredBefore(Date today = Date::today()) const;
+};
+
+#endif
@@ -6,6 +6,16 @@
 #include <cppconn/connection.h>  // for sql::Connection*
 #include "Address.h"
 
+// ANSI colour codes, for color()
+extern const std::string ANSI_RESET;
+extern const std::string ANSI_BOLD;
+extern const std::string ANSI_RED;
+extern const std::string ANSI_GREEN;
+extern const std::string ANSI_YELLOW;
+extern const std::string ANSI_BLUE;
+extern const std::string ANSI_MAGENTA;
+extern const std::string ANSI_CYAN;
+
 // Basic UI helpers
 void clearScreen();
 void pressEnterToContinue();
@@ -24,12 +34,13 @@ void handleSubcategoryFlow(sql::Connection *con,
                            int customerId);
 void runCategoryMenu(sql::Connection *con, int customerId);
 void runSearchMenu(sql::Connection* con, int customerId);
+void showExpiringSoon(sql::Connection* con, int customerId);
 
 // My Profile + Orders
 void showMyProfile(sql::Connection* con, int customerId, const std::string &loggedInEmail);
 void editProfileMenu(sql::Connection* con, int customerId, const std::string &loggedInEmail);
 void showMyOrders(sql::Connection* con, int customerId);
-void showOrderDetails(sql::Connection* con, int orderId, int orderNumber);
+void showOrderDetails(sql::Connection* con, int orderId, int orderNumber, int customerId);
 
 // Addresses (NEW)
 int selectDeliveryAddress(sql::Connection* con, int customerId);
@@ -0,0 +1,105 @@
+#ifndef LISTVIEW_H
+#define LISTVIEW_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cppconn/connection.h>
+#include "Money.h"
+#include "Date.h"
+
+// Scrolling product list for result sets of any size.
+// Only the rows on screen are fetched (one batch query per window) and
+// printed, so showing a page costs the same for 20 results or 2 million.
+
+// One line of the list (the compact product row)
+struct ListRow {
+    int productId = 0;
+    std::string name;
+    int stock = 0;
+    Money price;
+    Date expiry;
+    std::string supplier;
+};
+
+// Rows for `count` ids starting at `ids`, in that order, from the catalog
+// cache when warm, else with one IN (...) query. Ids that no longer exist
+// come back as "(unavailable)" rows so positions stay aligned.
+bool loadListRows(sql::Connection* con, const int* ids, size_t count, std::vector<ListRow> &out);
+
+// Where the rows come from
+class ListSource {
+public:
+    virtual ~ListSource() {}
+    virtual size_t size() = 0;
+    // rows [first, first + count); false on SQL error
+    virtual bool fetch(size_t first, size_t count, std::vector<ListRow> &out) = 0;
+};
+
+// A list of product ids already in hand (search, sort, filter results).
+// Views the ids; the caller keeps them alive.
+class IdListSource : public ListSource {
+private:
+    sql::Connection* con;
+    const int* ids;
+    size_t count;
+
+public:
+    IdListSource(sql::Connection* c, const int* productIds, size_t n) : con(c), ids(productIds), count(n) {}
+    size_t size() override { return count; }
+    bool fetch(size_t first, size_t n, std::vector<ListRow> &out) override;
+};
+
+// Every product by id. Paging forward continues from the last id shown
+// (keyset); jumps use LIMIT/OFFSET on the primary key.
+class AllProductsSource : public ListSource {
+private:
+    sql::Connection* con;
+    long total;             // -1 until counted
+    size_t nextFirst;       // row after the last window fetched...
+    int lastId;             // ...and its last product id
+
+public:
+    explicit AllProductsSource(sql::Connection* c) : con(c), total(-1), nextFirst(0), lastId(0) {}
+    size_t size() override;
+    bool fetch(size_t first, size_t n, std::vector<ListRow> &out) override;
+};
+
+// What the user did in the list
+struct ListAction {
+    enum Kind { BACK, OPEN, COMMAND };
+    Kind kind = BACK;
+    int productId = 0;      // OPEN
+    char command = 0;       // COMMAND: one of the view's command keys
+};
+
+class ListView {
+private:
+    ListSource &source;
+    std::string title;
+    std::string commandKeys;        // extra single-letter commands, e.g. "sf"
+    std::string commandHelp;        // shown in the footer
+    size_t top;                     // index of the first row on screen
+    std::vector<ListRow> window;
+    size_t windowFirst;             // rows in `window` start here (SIZE_MAX: none)
+
+    size_t pageSize() const;
+    void render(size_t rows);
+
+public:
+    ListView(ListSource &src, std::string title,
+             std::string commandKeys = "", std::string commandHelp = "");
+
+    // Show pages until the user opens a row, runs a command or goes back.
+    // Keys: Enter / n / PgDn next page, p / PgUp previous, g N jump to row N,
+    // a row number opens it, 0 goes back.
+    ListAction run();
+
+    size_t position() const { return top; }
+    void scrollTo(size_t row) { top = row; }
+};
+
+// Terminal height in lines (TIOCGWINSZ, then $LINES, then 24)
+int terminalRows();
+
+#endif
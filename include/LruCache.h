@@ -0,0 +1,92 @@
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <cstddef>
+
+// Fixed-capacity map that evicts the least recently used entry.
+// Not synchronised: the owner locks around it.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LruCache {
+public:
+    using Entry = std::pair<K, V>;
+
+private:
+    size_t cap;
+    std::list<Entry> order;     // front = most recently used
+    std::unordered_map<K, typename std::list<Entry>::iterator, Hash> index;
+
+public:
+    explicit LruCache(size_t capacity) : cap(capacity ? capacity : 1) {
+        index.reserve(cap);
+    }
+
+    // Entry for `key` (now most recently used), or nullptr
+    V* find(const K &key) {
+        auto it = index.find(key);
+        if (it == index.end()) return nullptr;
+        order.splice(order.begin(), order, it->second);
+        return &it->second->second;
+    }
+
+    // Without touching the recency order
+    bool contains(const K &key) const { return index.count(key) != 0; }
+    V* peek(const K &key) {
+        auto it = index.find(key);
+        return it == index.end() ? nullptr : &it->second->second;
+    }
+
+    // Next entry put() would evict (nullptr when empty)
+    const Entry* leastRecent() const { return order.empty() ? nullptr : &order.back(); }
+
+    void put(const K &key, V value) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            it->second->second = std::move(value);
+            order.splice(order.begin(), order, it->second);
+            return;
+        }
+        if (order.size() >= cap) {
+            index.erase(order.back().first);
+            order.pop_back();
+        }
+        order.emplace_front(key, std::move(value));
+        index.emplace(key, order.begin());
+    }
+
+    bool erase(const K &key) {
+        auto it = index.find(key);
+        if (it == index.end()) return false;
+        order.erase(it->second);
+        index.erase(it);
+        return true;
+    }
+
+    // Erase every entry for which pred(key, value) holds; returns the count
+    template <typename Pred>
+    size_t eraseIf(Pred pred) {
+        size_t n = 0;
+        for (auto it = order.begin(); it != order.end();) {
+            if (pred(it->first, it->second)) {
+                index.erase(it->first);
+                it = order.erase(it);
+                ++n;
+            } else {
+                ++it;
+            }
+        }
+        return n;
+    }
+
+    void clear() {
+        order.clear();
+        index.clear();
+    }
+
+    size_t size() const { return order.size(); }
+    size_t capacity() const { return cap; }
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+
+// An amount in rupees held as whole paise in an int64, so sums and
+// price x quantity are exact. Read from and written to the DB as DECIMAL
+// text ("1234.50"), never through float/double.
+class Money {
+private:
+    int64_t paise;
+
+    constexpr explicit Money(int64_t p) : paise(p) {}
+
+public:
+    constexpr Money() : paise(0) {}
+
+    static constexpr Money fromPaise(int64_t p) { return Money(p); }
+    static Money fromRupees(double rupees);         // rounded to the nearest paisa
+    static bool parseSQL(const std::string &s, Money &out);   // "123", "123.4", "-0.05"; false if NULL/malformed
+    static Money fromSQL(const std::string &s);     // parseSQL, or 0 if NULL/malformed (display only)
+
+    constexpr int64_t toPaise() const { return paise; }
+    double toRupees() const { return paise / 100.0; }
+    std::string toString() const;                   // "1234.50"; also the SQL form
+
+    constexpr Money operator+(Money o) const { return Money(paise + o.paise); }
+    constexpr Money operator-(Money o) const { return Money(paise - o.paise); }
+    constexpr Money operator*(int64_t qty) const { return Money(paise * qty); }
+    Money& operator+=(Money o) { paise += o.paise; return *this; }
+    Money& operator-=(Money o) { paise -= o.paise; return *this; }
+
+    constexpr bool operator==(Money o) const { return paise == o.paise; }
+    constexpr bool operator!=(Money o) const { return paise != o.paise; }
+    constexpr bool operator<(Money o) const { return paise < o.paise; }
+    constexpr bool operator<=(Money o) const { return paise <= o.paise; }
+    constexpr bool operator>(Money o) const { return paise > o.paise; }
+    constexpr bool operator>=(Money o) const { return paise >= o.paise; }
+};
+
+// Honours setw() like a string does
+std::ostream& operator<<(std::ostream &os, Money m);
+
+// ---------------------------------------------
+// Batched arithmetic over contiguous columns
+// ---------------------------------------------
+// Plain loops over parallel arrays with no aliasing and no branches, so the
+// compiler vectorises them (-O2 -ftree-vectorize / -O3). Used for cart and
+// order totals, where B2B carts run to thousands of lines.
+
+// sum of qty[i] * pricePaise[i]
+int64_t sumLineTotals(const int32_t* qty, const int64_t* pricePaise, size_t n);
+
+// out[i] = qty[i] * pricePaise[i]
+void lineTotals(const int32_t* qty, const int64_t* pricePaise, int64_t* out, size_t n);
+
+#endif
@@ -3,39 +3,44 @@
 
 #include <string>
 #include <vector>
+#include <memory_resource>
 #include "OrderItem.h"
+#include "Date.h"
+#include "Money.h"
 
 class Order {
 private:
     int orderId;
     int customerId;
-    std::string orderDate;
-    std::string deliveryDate;
-    double totalAmount;
+    Date orderDate;
+    Date deliveryDate;
+    Money totalAmount;
 
-    std::vector<OrderItem> items;   // list of products in this order
+    std::pmr::vector<OrderItem> items;   // list of products in this order
 
 public:
     Order();
-    Order(int oid, int cid, const std::string &od, const std::string &dd, double total);
+    Order(int oid, int cid, Date od, Date dd, Money total);
 
     // Getters
     int getOrderId() const { return orderId; }
     int getCustomerId() const { return customerId; }
-    std::string getOrderDate() const { return orderDate; }
-    std::string getDeliveryDate() const { return deliveryDate; }
-    double getTotalAmount() const { return totalAmount; }
-    const std::vector<OrderItem>& getItems() const { return items; }
+    Date getOrderDate() const { return orderDate; }
+    Date getDeliveryDate() const { return deliveryDate; }
+    Money getTotalAmount() const { return totalAmount; }
+    const std::pmr::vector<OrderItem>& getItems() const { return items; }
 
     // Setters
     void setOrderId(int id) { orderId = id; }
     void setCustomerId(int id) { customerId = id; }
-    void setOrderDate(const std::string &d) { orderDate = d; }
-    void setDeliveryDate(const std::string &d) { deliveryDate = d; }
-    void setTotalAmount(double amt) { totalAmount = amt; }
+    void setOrderDate(Date d) { orderDate = d; }
+    void setDeliveryDate(Date d) { deliveryDate = d; }
+    void setTotalAmount(Money amt) { totalAmount = amt; }
 
     // Add items
     void addItem(const OrderItem &item);
+    void addItem(OrderItem &&item);
+    void setItems(std::pmr::vector<OrderItem> list) { items = std::move(list); }
 
     // Utility
     void displayOrder() const;
@@ -2,32 +2,50 @@
 #define ORDERITEM_H
 
 #include <string>
+#include <string_view>
+#include <memory_resource>
+#include "Money.h"
 
+// Allocator-aware: inside a std::pmr::vector the name is stored in the
+// vector's memory resource (e.g. a RequestArena), see loadOrderItems().
 class OrderItem {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
 private:
     int productId;
-    std::string productName;
+    std::pmr::string productName;
     int quantity;
-    double price;
-    double subtotal;
+    Money price;
+    Money subtotal;
 
 public:
-    OrderItem();
-    OrderItem(int pid, const std::string &name, int qty, double p, double sub);
+    OrderItem() : OrderItem(allocator_type()) {}
+    explicit OrderItem(const allocator_type &alloc);
+    OrderItem(int pid, std::string_view name, int qty, Money p, Money sub,
+              const allocator_type &alloc = allocator_type());
+
+    OrderItem(const OrderItem &o, const allocator_type &alloc = allocator_type());
+    OrderItem(OrderItem &&o) noexcept = default;
+    OrderItem(OrderItem &&o, const allocator_type &alloc);
+    OrderItem& operator=(const OrderItem &o) = default;
+    OrderItem& operator=(OrderItem &&o) = default;
+
+    allocator_type get_allocator() const { return productName.get_allocator(); }
 
     // Getters
     int getProductId() const { return productId; }
-    std::string getProductName() const { return productName; }
+    const std::pmr::string& getProductName() const { return productName; }
     int getQuantity() const { return quantity; }
-    double getPrice() const { return price; }
-    double getSubtotal() const { return subtotal; }
+    Money getPrice() const { return price; }
+    Money getSubtotal() const { return subtotal; }
 
     // Setters
     void setProductId(int id) { productId = id; }
-    void setProductName(const std::string &n) { productName = n; }
+    void setProductName(std::string_view n) { productName = n; }
     void setQuantity(int q) { quantity = q; }
-    void setPrice(double p) { price = p; }
-    void setSubtotal(double s) { subtotal = s; }
+    void setPrice(Money p) { price = p; }
+    void setSubtotal(Money s) { subtotal = s; }
 };
 
 #endif
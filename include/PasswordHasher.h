@@ -0,0 +1,71 @@
+#ifndef PASSWORDHASHER_H
+#define PASSWORDHASHER_H
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// scrypt cost parameters. Memory per hash = 128 * r * 2^logN bytes
+// (logN 14, r 8 -> 16 MiB, roughly 50-100 ms of CPU).
+struct HashCost {
+    int logN = 14;
+    int r = 8;
+    int p = 1;
+};
+
+// Result of checking a password against the stored LOGIN.Password value
+enum VerifyResult {
+    VERIFY_MISMATCH,
+    VERIFY_OK,
+    VERIFY_OK_NEEDS_REHASH,   // legacy plain text or weaker cost than current
+    VERIFY_BUSY               // hashing queue full, caller should retry later
+};
+
+// Dedicated pool of hashing threads with a bounded queue.
+// Session threads submit work and wait for the answer, but at most `workers`
+// hashes run at once and surplus requests are rejected immediately (BUSY),
+// so a credential-stuffing burst cannot pile unbounded CPU work on the box.
+//
+// Configuration (read once, on first use):
+//   PROJECT1_SCRYPT_LOGN   cost (default 14, at most 18 = 256 MiB per hash)
+//   PROJECT1_HASH_WORKERS  threads (default 2)
+//   PROJECT1_HASH_QUEUE    pending requests allowed (default 32)
+class PasswordHasher {
+public:
+    static PasswordHasher& instance();
+
+    // "$scrypt$ln=14,r=8,p=1$<salt hex>$<hash hex>", or "" if busy or the
+    // hash could not be computed
+    std::string hash(const std::string &password);
+
+    // A stored hash that is malformed or needs more than 256 MiB to check
+    // is a mismatch
+    VerifyResult verify(const std::string &password, const std::string &stored);
+
+    const HashCost& cost() const { return current; }
+
+    ~PasswordHasher();
+
+private:
+    PasswordHasher(int workers, size_t capacity, HashCost cost);
+
+    bool submit(std::function<void()> job);
+    void workerLoop();
+
+    HashCost current;
+    size_t capacity;
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> queue;
+    std::mutex mtx;
+    std::condition_variable wake;
+    bool stopping = false;
+};
+
+// True if the stored value is already in the hashed format
+bool isPasswordHash(const std::string &stored);
+
+#endif
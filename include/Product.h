@@ -2,18 +2,21 @@
 #define PRODUCT_H
 
 #include <string>
+#include <utility>
 #include "Date.h"
+#include "StringPool.h"
+#include "Money.h"
 using namespace std;
 
 class Product {
 private:
     int Product_id;
     string Product_name;
-    string Category;
-    string Subcategory;
-    float Price;
+    InternedString Category;        // pooled: a few hundred distinct values
+    InternedString Subcategory;
+    Money Price;
     int Stock_Qtn;
-    string Company_name;
+    InternedString Company_name;
     Date ExpiryDate;
 
 public:
@@ -21,25 +24,27 @@ public:
     Product();
 
     // Constructor used when loading from DB
-    Product(int id, string name, string cat, string subc,
-            float price, int qty, string comp, Date exp);
+    Product(int id, string name, const string &cat, const string &subc,
+            Money price, int qty, const string &comp, Date exp);
 
     // Getters
     int getId() const { return Product_id; }
-    string getName() const { return Product_name; }
-    string getCategory() const { return Category; }
-    string getSubcategory() const { return Subcategory; }
-    float getPrice() const { return Price; }
+    const string& getName() const { return Product_name; }
+    const string& getCategory() const { return Category; }
+    const string& getSubcategory() const { return Subcategory; }
+    Money getPrice() const { return Price; }
     int getStock() const { return Stock_Qtn; }
-    string getCompany() const { return Company_name; }
+    const string& getCompany() const { return Company_name; }
+    InternedString getCategoryKey() const { return Category; }         // for pooled-key maps
+    InternedString getSubcategoryKey() const { return Subcategory; }
     Date getExpiry() const { return ExpiryDate; }
 
     // Setters
     void setId(int id) { Product_id = id; }
-    void setName(const string& name) { Product_name = name; }
+    void setName(string name) { Product_name = std::move(name); }
     void setCategory(const string& cat) { Category = cat; }
     void setSubcategory(const string& subc) { Subcategory = subc; }
-    void setPrice(float price) { Price = price; }
+    void setPrice(Money price) { Price = price; }
     void setStock(int qty) { Stock_Qtn = qty; }
     void setCompany(const string& comp) { Company_name = comp; }
     void setExpiry(const Date& exp) { ExpiryDate = exp; }
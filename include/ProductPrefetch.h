@@ -0,0 +1,52 @@
+#ifndef PRODUCTPREFETCH_H
+#define PRODUCTPREFETCH_H
+
+#include <string>
+#include <cstddef>
+#include "Money.h"
+#include "Date.h"
+
+// Background prefetch of the product details screen.
+//
+// While a product list is on screen, the list view hands over the visible
+// ids; a worker thread loads their product and supplier details in one
+// query on its own read connection and keeps them in a small LRU. Opening
+// a product then renders from memory. Entries older than
+// PREFETCH_TTL_SECONDS are ignored, so stock shown is never far behind.
+
+const size_t PREFETCH_CAPACITY = 256;     // products kept
+const int PREFETCH_TTL_SECONDS = 30;
+
+struct ProductDetails {
+    int productId = 0;
+    std::string name;
+    std::string category;
+    std::string subcategory;
+    Money price;
+    int stock = 0;
+    std::string company;
+    Date expiry;
+
+    bool hasSupplier = false;
+    std::string supplierName;
+    std::string supplierContact;
+    std::string supplierEmail;
+    std::string supplierAddress;
+};
+
+// Queue `count` ids for loading; replaces whatever was still queued (only
+// the current screen matters). Ids already fresh in the cache are skipped.
+// Starts the worker on first use.
+void prefetchProductDetails(const int* ids, size_t count);
+
+// Fresh prefetched details for productId, if any
+bool findPrefetchedDetails(int productId, ProductDetails &out);
+
+// Drop one product (e.g. after its stock changed) or everything
+void forgetPrefetchedDetails(int productId);
+void clearPrefetchedDetails();
+
+// Stops and joins the worker; further prefetch requests are ignored
+void stopProductPrefetcher();
+
+#endif
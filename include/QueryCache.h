@@ -0,0 +1,198 @@
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include "LruCache.h"
+#include "Money.h"
+
+// Result cache for small read queries, keyed on the query and its parameters.
+//
+// Entries are dropped when older than the TTL, least recently used first
+// when the entry count or the byte budget is exceeded, or explicitly via
+// invalidate(). Values are shared_ptr<const Value>, so a hit hands out the
+// cached result without copying it under the lock. Thread-safe.
+//
+// A result read while an invalidation ran would be stale once stored, so
+// find() reports the cache generation and store() drops the value if an
+// invalidate() or clear() has bumped it since.
+
+struct QueryCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;        // includes expired entries
+    uint64_t expired = 0;
+    uint64_t evictions = 0;     // LRU drops for count or byte budget
+    uint64_t invalidations = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class QueryCache {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Ptr = std::shared_ptr<const Value>;
+
+private:
+    struct Slot {
+        Ptr value;
+        size_t bytes;
+        Clock::time_point storedAt;
+    };
+
+    mutable std::mutex mtx;
+    LruCache<Key, Slot, Hash> lru;
+    size_t maxBytes;
+    std::chrono::milliseconds ttl;
+    QueryCacheStats counters;
+    uint64_t generation = 0;        // bumped by invalidate() and clear()
+
+    void dropLeastRecent() {
+        auto* victim = lru.leastRecent();
+        counters.bytes -= victim->second.bytes;
+        lru.erase(Key(victim->first));
+        ++counters.evictions;
+    }
+
+public:
+    // maxBytes == 0 or ttl == 0 disables the cache (every lookup misses)
+    QueryCache(size_t maxEntries, size_t maxBytes, std::chrono::milliseconds ttl)
+        : lru(maxEntries), maxBytes(maxBytes), ttl(ttl) {}
+
+    bool enabled() const { return maxBytes > 0 && ttl.count() > 0; }
+
+    // Cached result, or nullptr on a miss or an expired entry. `readAt`
+    // receives the generation to pass to store() after a miss.
+    Ptr find(const Key &key, uint64_t* readAt = nullptr) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (readAt) *readAt = generation;
+        Slot* s = lru.find(key);
+        if (s && Clock::now() - s->storedAt >= ttl) {
+            counters.bytes -= s->bytes;
+            lru.erase(key);
+            ++counters.expired;
+            s = nullptr;
+        }
+        if (!s) {
+            ++counters.misses;
+            return nullptr;
+        }
+        ++counters.hits;
+        return s->value;
+    }
+
+    // `bytes` is what the entry costs against the budget (key + value);
+    // `readAt` is the generation find() gave before the value was read
+    void store(const Key &key, Value value, size_t bytes, uint64_t readAt) {
+        if (!enabled() || bytes > maxBytes) return;
+        Ptr p = std::make_shared<const Value>(std::move(value));
+
+        std::lock_guard<std::mutex> lock(mtx);
+        if (readAt != generation) return;      // invalidated while it was read
+        if (Slot* old = lru.peek(key)) {
+            counters.bytes -= old->bytes;
+            lru.erase(key);
+        }
+        while (lru.size() > 0 && (lru.size() >= lru.capacity() || counters.bytes + bytes > maxBytes))
+            dropLeastRecent();
+
+        lru.put(key, Slot{std::move(p), bytes, Clock::now()});
+        counters.bytes += bytes;
+    }
+
+    // Drop every entry whose key matches; returns how many
+    template <typename Pred>
+    size_t invalidate(Pred pred) {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++generation;
+        size_t freed = 0;
+        size_t n = lru.eraseIf([&](const Key &k, const Slot &s) {
+            if (!pred(k)) return false;
+            freed += s.bytes;
+            return true;
+        });
+        counters.bytes -= freed;
+        counters.invalidations += n;
+        return n;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++generation;
+        counters.invalidations += lru.size();
+        lru.clear();
+        counters.bytes = 0;
+    }
+
+    QueryCacheStats stats() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        QueryCacheStats s = counters;
+        s.entries = lru.size();
+        return s;
+    }
+};
+
+// ---------------------------------------------
+// Product-id query results
+// ---------------------------------------------
+// searchProductsBy*, sortProductsBy* and filterProductsBy* consult this
+// cache before going to the DB, so a repeated search is a hash lookup.
+// Configured from the environment:
+//   PROJECT1_RESULT_CACHE_MB    byte budget (default 16, 0 = off)
+//   PROJECT1_RESULT_CACHE_TTL   seconds an entry stays valid (default 60)
+
+enum ResultQuery {
+    RQ_SEARCH_NAME, RQ_SEARCH_COMPANY, RQ_SEARCH_CATEGORY, RQ_SEARCH_PRICE,
+    RQ_SORT_PRICE_ASC, RQ_SORT_PRICE_DESC, RQ_SORT_NAME, RQ_SORT_STOCK,
+    RQ_FILTER_COMPANY, RQ_FILTER_PRICE
+};
+
+struct ResultKey {
+    ResultQuery kind;
+    std::string text1;          // search term / category
+    std::string text2;          // subcategory
+    std::string text3;          // company filter
+    int64_t low = 0;            // price bounds in paise
+    int64_t high = 0;
+
+    ResultKey(ResultQuery k, std::string a = "", std::string b = "", std::string c = "")
+        : kind(k), text1(std::move(a)), text2(std::move(b)), text3(std::move(c)) {}
+    ResultKey(ResultQuery k, std::string a, std::string b, Money lo, Money hi)
+        : kind(k), text1(std::move(a)), text2(std::move(b)), low(lo.toPaise()), high(hi.toPaise()) {}
+
+    bool operator==(const ResultKey &o) const {
+        return kind == o.kind && low == o.low && high == o.high &&
+               text1 == o.text1 && text2 == o.text2 && text3 == o.text3;
+    }
+
+    struct Hash {
+        size_t operator()(const ResultKey &k) const;
+    };
+};
+
+using ProductResultCache = QueryCache<ResultKey, std::vector<int>, ResultKey::Hash>;
+
+ProductResultCache& productResultCache();
+
+// Store `ids` as the result for `key`, read at generation `readAt` (see find())
+void cacheProductResult(const ResultKey &key, const std::vector<int> &ids, uint64_t readAt);
+
+// Which results a product change makes stale:
+//   stock change   -> sort by stock
+//   price change   -> sort by price, price-range search and filter
+//   anything else (names, categories, companies, rows added or removed)
+//                  -> every result
+void invalidateStockResults();
+void invalidatePriceResults();
+void invalidateProductResults();
+
+// Appends hit/miss counters to the metrics log (PROJECT1_METRICS_LOG)
+void logResultCacheStats();
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef RECOMMENDATIONS_H
+#define RECOMMENDATIONS_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <cppconn/connection.h>
+
+// "Frequently bought together": product -> top neighbours by co-purchase count.
+//
+// Each product keeps a bounded set of neighbour counters (Space-Saving: when
+// the set is full the smallest counter is recycled), so memory stays
+// O(products * NEIGHBOUR_SLOTS) however many orders are seen, and the
+// heavy co-purchases are kept exactly. The top-k list is refreshed on every
+// update, which makes lookups a hash probe plus a copy of k ids.
+
+const size_t NEIGHBOUR_SLOTS = 64;     // counters kept per product
+const size_t TOP_NEIGHBOURS = 10;      // list served to the detail screen
+const size_t MAX_ITEMS_PER_ORDER = 50; // larger orders only pair their first 50 lines
+
+class CoPurchaseIndex {
+private:
+    struct Counter {
+        int productId;
+        uint32_t count;
+    };
+    struct Neighbours {
+        std::vector<Counter> counters;   // unsorted, at most NEIGHBOUR_SLOTS
+        std::vector<int> top;            // best first, at most TOP_NEIGHBOURS
+    };
+
+    mutable std::mutex mtx;
+    std::unordered_map<int, Neighbours> byProduct;
+    int64_t lastOrderId;                 // orders <= this are counted (from the DB)
+    std::unordered_set<int64_t> recordedAhead;   // local orders above lastOrderId
+    bool dirty;
+
+    void addPair(int a, int b);
+    void recordLocked(const std::vector<int> &productIds);
+
+public:
+    CoPurchaseIndex();
+
+    // Count one committed order. Orders recorded here are skipped when the
+    // DB catch-up reaches their id, so nothing is counted twice.
+    void recordOrder(int64_t orderId, const std::vector<int> &productIds);
+
+    // Up to k products most often bought with productId (best first)
+    std::vector<int> recommend(int productId, size_t k = TOP_NEIGHBOURS) const;
+
+    // Read OrderItems with OrderID > lastOrderId and count those orders
+    // (picks up orders placed by other app instances). Returns orders added.
+    size_t catchUp(sql::Connection* con);
+
+    // Binary file with checksum; written to path + ".tmp" then renamed
+    bool save(const std::string &path);
+    bool load(const std::string &path);
+
+    bool isDirty() const;
+    size_t productCount() const;
+};
+
+// Process-wide index
+CoPurchaseIndex& coPurchaseIndex();
+
+// Background job: load `path`, catch up from OrderItems, then every
+// intervalSeconds catch up again and save if anything changed. Stopping
+// saves one last time.
+void startRecommendationService(const std::string &path, int intervalSeconds);
+void stopRecommendationService();
+
+// PROJECT1_RECOMMENDATIONS or ./recommendations.bin
+std::string defaultRecommendationsPath();
+
+#endif
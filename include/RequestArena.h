@@ -0,0 +1,36 @@
+#ifndef REQUESTARENA_H
+#define REQUESTARENA_H
+
+#include <memory_resource>
+#include <cstddef>
+
+// Memory for one screen's (or one request's) query results.
+// Loaders that take a std::pmr::memory_resource* build their vectors and
+// strings here; everything is dropped at once when the arena goes out of
+// scope or on release(), with no per-object frees. The first few KB come
+// from an inline buffer, after which the arena grabs geometrically growing
+// blocks, so a screen costs a handful of global allocations at most and
+// concurrent sessions rarely meet in malloc.
+//
+// One arena per screen and thread; results must not outlive it.
+class RequestArena {
+public:
+    static const size_t INLINE_BYTES = 8 * 1024;
+
+private:
+    alignas(std::max_align_t) char initial[INLINE_BYTES];
+    std::pmr::monotonic_buffer_resource pool;
+
+public:
+    RequestArena() : pool(initial, sizeof(initial)) {}
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &pool; }
+
+    // Frees everything allocated so far; earlier results become invalid
+    void release() { pool.release(); }
+};
+
+#endif
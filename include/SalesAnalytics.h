@@ -0,0 +1,120 @@
+#ifndef SALESANALYTICS_H
+#define SALESANALYTICS_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+#include <cppconn/connection.h>
+
+// In-process sales analytics over a columnar copy of the order lines.
+//
+// Each OrderItems row becomes one entry in every column below; product
+// attributes (category, company) are copied onto the line when it is loaded,
+// so a query scans plain arrays and never joins. Strings are dictionary
+// encoded. Queries split the lines into one contiguous range per thread, each
+// thread aggregates into its own arrays, and the partials are summed at the
+// end — no locks, no MySQL.
+//
+// Loading reads PRODUCT once, then OrderItems ⋈ Orders in OrderID order in
+// pages; refresh() appends only orders newer than the last one loaded.
+// Not thread-safe: do not refresh() while a query is running.
+
+struct SalesColumns {
+    std::vector<int32_t> day;          // OrderDate, days since 1970-01-01
+    std::vector<int32_t> product;      // index into SalesAnalytics::productIds
+    std::vector<uint16_t> category;    // index into SalesAnalytics::categories
+    std::vector<uint32_t> company;     // index into SalesAnalytics::companies
+    std::vector<int32_t> quantity;
+    std::vector<double> price;         // PriceAtPurchase
+
+    size_t size() const { return day.size(); }
+    void reserve(size_t n);
+};
+
+struct CategoryDayRevenue {
+    std::string category;
+    int day;
+    double revenue;
+    long long quantity;
+};
+
+struct ProductSales {
+    int productId;
+    std::string name;
+    std::string category;
+    double revenue;
+    long long quantity;
+};
+
+struct BrandShare {
+    std::string company;
+    double revenue;
+    double share;                      // of the revenue in the query, 0..1
+};
+
+class SalesAnalytics {
+private:
+    SalesColumns lines;
+
+    std::vector<int> productIds;       // dense product index -> Product_ID
+    std::vector<std::string> productNames;
+    std::vector<uint16_t> productCategory;
+    std::vector<uint32_t> productCompany;
+    std::unordered_map<int, int32_t> productIndex;
+
+    std::vector<std::string> categories;
+    std::vector<std::string> companies;
+    std::unordered_map<std::string, uint32_t> categoryCodes;
+    std::unordered_map<std::string, uint32_t> companyCodes;
+
+    int64_t lastOrderId;
+    int minDay, maxDay;
+    int threads;
+
+    uint32_t codeFor(std::vector<std::string> &dict,
+                     std::unordered_map<std::string, uint32_t> &codes,
+                     const std::string &value);
+    int32_t productFor(int productId);
+    bool loadProducts(sql::Connection* con);
+    int threadsFor(size_t bytesPerThread) const;
+
+public:
+    // threads = 0: one per hardware thread
+    explicit SalesAnalytics(int threads = 0);
+
+    // Append order lines with OrderID above the last one loaded (everything
+    // on the first call). Returns false on SQL error; pages already read stay.
+    bool refresh(sql::Connection* con);
+
+    size_t lineCount() const { return lines.size(); }
+    size_t productCount() const { return productIds.size(); }
+    size_t memoryBytes() const;
+    int threadCount() const { return threads; }
+    int firstDay() const { return minDay; }   // INT_MAX / INT_MIN while empty
+    int lastDay() const { return maxDay; }
+
+    // Days are days since 1970-01-01, inclusive. Empty results when nothing
+    // falls in the range.
+
+    // One row per (category, day) that sold something; by category then day
+    std::vector<CategoryDayRevenue> revenueByCategoryDay(int fromDay = INT_MIN,
+                                                         int toDay = INT_MAX) const;
+
+    // Best k products by revenue (or by quantity); category "" = all
+    std::vector<ProductSales> topSellers(size_t k, int fromDay = INT_MIN, int toDay = INT_MAX,
+                                         const std::string &category = "",
+                                         bool byQuantity = false) const;
+
+    // Revenue per company, largest first; category "" = all
+    std::vector<BrandShare> brandShare(int fromDay = INT_MIN, int toDay = INT_MAX,
+                                       const std::string &category = "") const;
+};
+
+// "YYYY-MM-DD" <-> days since 1970-01-01 (INT_MIN when invalid)
+int dayNumber(const std::string &ymd);
+std::string dayString(int day);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <string>
+
+// Everything the app needs about the logged-in customer, resolved once at
+// login (see loginAndResolve / registerCustomer in login.h).
+struct CustomerSession {
+    int customerId = -1;
+    std::string email;
+    std::string name;
+    std::string contact;
+    int defaultAddressId = -1;       // -1 = no saved address
+    std::string defaultAddress;      // "line, city, state pincode"
+    int cartItems = 0;               // total quantity in Cart
+};
+
+const long SESSION_TTL_SECONDS = 7L * 24 * 60 * 60;
+
+// Signed token: "1|<customerId>|<expiry>|<hex email>|<hex name>|<hmac>".
+// The HMAC-SHA256 key comes from PROJECT1_SESSION_KEY, or a random key kept
+// in ~/.project1_session_key (created on first use, mode 0600).
+std::string issueSessionToken(const CustomerSession &s, long ttlSeconds = SESSION_TTL_SECONDS);
+
+// Checks signature and expiry; fills customerId, email and name.
+bool verifySessionToken(const std::string &token, CustomerSession &out);
+
+// Remembered session in ~/.project1_session, so re-entry needs no DB lookup
+bool saveSessionToken(const std::string &token);
+bool loadSavedSession(CustomerSession &out);
+void clearSavedSession();
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef SHARDROUTER_H
+#define SHARDROUTER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cppconn/connection.h>
+#include "DBRouter.h"
+#include "Money.h"
+
+// Customer-ID sharding.
+//
+// The customer-owned tables (Cart, WISHLIST, ADDRESS, Orders, OrderItems)
+// can be spread over several schemas or servers. PRODUCT, Supplier, LOGIN,
+// CUSTOMER_DETAILS and SHARD_MAP stay in the global schema (the primary's
+// PROJECT1_DB_SCHEMA, see DBRouter.h).
+//
+//   PROJECT1_DB_SHARDS          comma-separated shards, shard 0 first. An entry
+//                               is a schema on the primary ("shop_s1") or
+//                               tcp://host:port/schema. Unset = not sharded.
+//   PROJECT1_SHARD_MAP_SECONDS  how long the bucket map is cached (default 10)
+//
+// A customer's bucket is customerId % SHARD_BUCKETS. SHARD_MAP assigns
+// buckets to shards; a bucket without a row lives on shard 0, so listing the
+// global schema first keeps existing data where it is until shard_rebalance
+// moves it. While a bucket is being moved its customers can read but not write.
+//
+// Customer-scoped functions take the global connection as before and swap in
+// the customer's shard with shardRead() / shardWrite(). Not sharded, these
+// are routeRead() and the global connection itself.
+
+const int SHARD_BUCKETS = 1024;
+
+// Auto-increment ids on shard k start at k * SHARD_ID_STRIDE + 1
+// (shard_rebalance --init), so rows keep their ids when they move
+const int64_t SHARD_ID_STRIDE = 100000000;
+
+inline int shardBucket(int customerId) { return customerId % SHARD_BUCKETS; }
+
+bool shardingEnabled();
+
+// Configured shards (1 when not sharded)
+int shardCount();
+
+// Seconds a SHARD_MAP change can take to reach every process
+int shardMapSeconds();
+
+// Age in seconds past which shardWrite() stops trusting a bucket map it
+// could not refresh (shardMapSeconds() plus one failed refresh's retry).
+// A move waits longer than this before copying.
+int shardMapMaxAge();
+
+// Endpoint of `shard`; false if there is no such shard
+bool shardEndpoint(int shard, DBEndpoint &out);
+
+// True when `shard` is the global schema itself
+bool isGlobalShard(int shard);
+
+// New connection to `shard`. Caller owns it (tools, bulk copies).
+sql::Connection* openShardConnection(int shard);
+
+// Shard holding `customerId`'s rows (0 when not sharded)
+int shardOf(int customerId);
+
+// True when the customer's rows are in the global schema (always, when not
+// sharded), so queries can join them with PRODUCT
+bool inGlobalSchema(int customerId);
+
+// Connection for reading the customer's rows: this thread's connection to
+// their shard (opened on first use, pinged at most every 10 seconds), or
+// routeRead(global, customerId) when the rows are in the global schema.
+sql::Connection* shardRead(sql::Connection* global, int customerId);
+
+// Connection for writing the customer's rows: this thread's connection to
+// their shard, or `global` when the rows are in the global schema. Throws
+// sql::SQLException while the customer's bucket is being moved, or while
+// SHARD_MAP cannot be read and the map in hand is older than
+// shardMapMaxAge(), so callers report it like any failed statement.
+sql::Connection* shardWrite(sql::Connection* global, int customerId);
+
+// Drop the cached bucket map (the next lookup reads SHARD_MAP)
+void reloadShardMap();
+
+// The PRODUCT columns of a Cart / WISHLIST / OrderItems join, for rows read
+// from a shard. Reads the global schema the way routeRead(global, customerId)
+// does; products that no longer exist are left out. Throws on SQL errors.
+struct ProductFacts {
+    int productId;
+    std::string name;
+    Money price;
+    int stock;
+};
+
+void loadProductFacts(sql::Connection* global, int customerId, const std::vector<int> &productIds,
+                      std::unordered_map<int, ProductFacts> &out);
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef SQLREGISTRY_H
+#define SQLREGISTRY_H
+
+#include <string>
+#include <tuple>
+#include <optional>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <cppconn/connection.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+#include "Money.h"
+#include "Date.h"
+
+// Typed SQL statements.
+//
+// A Statement carries its SQL text plus its parameter and column types:
+//
+//   inline constexpr Statement<Params<int>, Row<int, std::string, Money>> X{
+//       "SELECT Product_ID, Product_Name, Price FROM PRODUCT WHERE SID = ?"};
+//   static_assert(X.valid(), "...");
+//
+// valid() counts the ? placeholders and the select-list columns at compile
+// time, so SQL and types cannot drift apart. prepare() binds arguments by
+// position with the declared types; readRow() / readAs<Model>() decode a row
+// by column ordinal (no per-cell name lookup) into a tuple or straight into
+// a model type. Statements live in Statements.h.
+
+namespace sqlreg {
+
+template <typename... Ts> struct Params { static constexpr size_t size = sizeof...(Ts); };
+template <typename... Ts> struct Row { static constexpr size_t size = sizeof...(Ts); };
+
+// ---------------------------------------------
+// Compile-time checks on the SQL text
+// ---------------------------------------------
+constexpr bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t'; }
+
+constexpr bool wordAt(const char* s, const char* word) {
+    while (*word) {
+        if (*s != *word) return false;
+        ++s; ++word;
+    }
+    return true;
+}
+
+// ? outside string literals
+constexpr size_t countPlaceholders(const char* s) {
+    size_t n = 0;
+    bool quoted = false;
+    for (; *s; ++s) {
+        if (*s == '\'') quoted = !quoted;
+        else if (*s == '?' && !quoted) ++n;
+    }
+    return n;
+}
+
+// Columns between SELECT and the first top-level FROM (0 if not a SELECT)
+constexpr size_t countSelectColumns(const char* s) {
+    while (isSpace(*s)) ++s;
+    if (!wordAt(s, "SELECT")) return 0;
+    s += 6;
+    size_t cols = 1;
+    int depth = 0;
+    bool quoted = false;
+    for (; *s; ++s) {
+        char c = *s;
+        if (c == '\'') quoted = !quoted;
+        if (quoted) continue;
+        if (c == '(') ++depth;
+        else if (c == ')') --depth;
+        else if (c == ',' && depth == 0) ++cols;
+        else if (depth == 0 && isSpace(c) && wordAt(s + 1, "FROM") && isSpace(s[5])) return cols;
+    }
+    return 0;
+}
+
+template <typename P, typename R>
+struct Statement {
+    using ParamTypes = P;
+    using RowType = R;
+
+    const char* sql;
+
+    constexpr explicit Statement(const char* text) : sql(text) {}
+
+    constexpr bool valid() const {
+        return countPlaceholders(sql) == P::size &&
+               (R::size == 0 || countSelectColumns(sql) == R::size);
+    }
+};
+
+// A SELECT ... FROM ... head whose WHERE clause is built at run time
+// (IN lists, keyset paging). Only the column list is checked.
+template <typename R>
+using Select = Statement<Params<>, R>;
+
+// ---------------------------------------------
+// Binding
+// ---------------------------------------------
+inline void setParam(sql::PreparedStatement* ps, unsigned int i, int v) { ps->setInt(i, v); }
+inline void setParam(sql::PreparedStatement* ps, unsigned int i, int64_t v) { ps->setInt64(i, v); }
+inline void setParam(sql::PreparedStatement* ps, unsigned int i, const std::string &v) { ps->setString(i, v); }
+inline void setParam(sql::PreparedStatement* ps, unsigned int i, Money v) { ps->setString(i, v.toString()); }
+inline void setParam(sql::PreparedStatement* ps, unsigned int i, Date v) { ps->setString(i, v.toSQL()); }
+
+template <typename... Ps, typename... Args, size_t... I>
+void bindAll(sql::PreparedStatement* ps, std::index_sequence<I...>, const Args&... args) {
+    (setParam(ps, (unsigned int)(I + 1), Ps(args)), ...);
+}
+
+// Prepared and bound; caller deletes it (like prepareStatement)
+template <typename... Ps, typename R, typename... Args>
+sql::PreparedStatement* prepare(sql::Connection* con, const Statement<Params<Ps...>, R> &st,
+                                const Args&... args) {
+    static_assert(sizeof...(Args) == sizeof...(Ps), "wrong number of SQL parameters");
+    sql::PreparedStatement* ps = con->prepareStatement(st.sql);
+    try {
+        bindAll<Ps...>(ps, std::index_sequence_for<Ps...>{}, args...);
+    } catch (...) {
+        delete ps;
+        throw;
+    }
+    return ps;
+}
+
+// ---------------------------------------------
+// Decoding
+// ---------------------------------------------
+template <typename T> struct Column;
+
+template <> struct Column<int> {
+    static int read(sql::ResultSet* r, unsigned int i) { return r->getInt(i); }
+};
+template <> struct Column<int64_t> {
+    static int64_t read(sql::ResultSet* r, unsigned int i) { return r->getInt64(i); }
+};
+template <> struct Column<std::string> {
+    static std::string read(sql::ResultSet* r, unsigned int i) { return r->getString(i); }
+};
+// An amount that does not parse fails the whole read (prices feed orders)
+template <> struct Column<Money> {
+    static Money read(sql::ResultSet* r, unsigned int i) {
+        std::string s = r->getString(i);
+        Money m;
+        if (!Money::parseSQL(s, m))
+            throw sql::SQLException("column " + std::to_string(i) + " is not a DECIMAL amount: '" + s + "'");
+        return m;
+    }
+};
+template <> struct Column<Date> {
+    static Date read(sql::ResultSet* r, unsigned int i) { return Date::fromSQL(r->getString(i)); }
+};
+template <typename T> struct Column<std::optional<T>> {
+    static std::optional<T> read(sql::ResultSet* r, unsigned int i) {
+        if (r->isNull(i)) return std::nullopt;
+        return Column<T>::read(r, i);
+    }
+};
+
+// Braced init evaluates left to right, so columns are read in order
+template <typename Model, typename... Cs, size_t... I>
+Model buildRow(sql::ResultSet* r, std::index_sequence<I...>) {
+    return Model{Column<Cs>::read(r, (unsigned int)(I + 1))...};
+}
+
+// Current row as a tuple of the statement's column types
+template <typename P, typename... Cs>
+std::tuple<Cs...> readRow(sql::ResultSet* r, const Statement<P, Row<Cs...>> &) {
+    return buildRow<std::tuple<Cs...>, Cs...>(r, std::index_sequence_for<Cs...>{});
+}
+
+// Current row as Model{col1, col2, ...} (aggregate or matching constructor)
+template <typename Model, typename P, typename... Cs>
+Model readAs(sql::ResultSet* r, const Statement<P, Row<Cs...>> &) {
+    return buildRow<Model, Cs...>(r, std::index_sequence_for<Cs...>{});
+}
+
+// "?, ?, ?" for IN lists
+inline std::string placeholders(size_t n) {
+    std::string s;
+    s.reserve(n * 3);
+    for (size_t i = 0; i < n; ++i) s += i ? ", ?" : "?";
+    return s;
+}
+
+} // namespace sqlreg
+
+#endif
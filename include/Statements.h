@@ -0,0 +1,121 @@
+#ifndef STATEMENTS_H
+#define STATEMENTS_H
+
+#include <string>
+#include <optional>
+#include "SqlRegistry.h"
+
+// The SQL behind the hot loaders, with parameter and column types.
+// Column order is the order readRow()/readAs() decode in, so for models
+// built with readAs<> it follows the model's field order.
+
+namespace stmts {
+
+using sqlreg::Statement;
+using sqlreg::Select;
+using sqlreg::Params;
+using sqlreg::Row;
+using std::string;
+
+// ---------------------------------------------
+// Cart
+// ---------------------------------------------
+// -> CartLine {productId, name, quantity, price, stock}
+inline constexpr Statement<Params<int>, Row<int, string, int, Money, int>> CART_LINES{
+    "SELECT c.Product_ID, p.Product_Name, c.Quantity, p.Price, p.Stock_Qtn "
+    "FROM Cart c JOIN PRODUCT p ON c.Product_ID = p.Product_ID "
+    "WHERE c.Customer_ID = ? ORDER BY c.Product_ID"};
+static_assert(CART_LINES.valid(), "CART_LINES");
+
+// ---------------------------------------------
+// Orders
+// ---------------------------------------------
+// OrderID, OrderDate, DeliveryDate, TotalAmount
+inline constexpr Statement<Params<int>, Row<int, Date, Date, Money>> ORDERS_FOR_CUSTOMER{
+    "SELECT OrderID, OrderDate, DeliveryDate, TotalAmount "
+    "FROM Orders WHERE CustomerID = ? ORDER BY OrderDate DESC, OrderID DESC"};
+static_assert(ORDERS_FOR_CUSTOMER.valid(), "ORDERS_FOR_CUSTOMER");
+
+// -> OrderItem(productId, name, quantity, price, subtotal)
+inline constexpr Statement<Params<int>, Row<int, string, int, Money, Money>> ORDER_ITEMS{
+    "SELECT oi.ProductID, p.Product_Name, oi.Quantity, oi.PriceAtPurchase, oi.Subtotal "
+    "FROM OrderItems oi JOIN PRODUCT p ON oi.ProductID = p.Product_ID "
+    "WHERE oi.OrderID = ?"};
+static_assert(ORDER_ITEMS.valid(), "ORDER_ITEMS");
+
+// ---------------------------------------------
+// Customer
+// ---------------------------------------------
+// ID, Name, Contact_Num, Email, Address
+inline constexpr Statement<Params<int>, Row<int, string, string, string, string>> CUSTOMER_BY_ID{
+    "SELECT ID, Name, Contact_Num, Email, Address FROM CUSTOMER_DETAILS WHERE ID = ?"};
+static_assert(CUSTOMER_BY_ID.valid(), "CUSTOMER_BY_ID");
+
+// AddressID, AddressLine
+inline constexpr Statement<Params<int>, Row<int, string>> ADDRESS_LINES{
+    "SELECT AddressID, AddressLine FROM ADDRESS WHERE CustomerID = ?"};
+static_assert(ADDRESS_LINES.valid(), "ADDRESS_LINES");
+
+// WishlistID, ProductID, Product_Name, Price
+inline constexpr Statement<Params<int>, Row<int, int, string, Money>> WISHLIST_ITEMS{
+    "SELECT W.WishlistID, W.ProductID, P.Product_Name, P.Price "
+    "FROM WISHLIST W JOIN PRODUCT P ON W.ProductID = P.Product_ID "
+    "WHERE W.CustomerID = ?"};
+static_assert(WISHLIST_ITEMS.valid(), "WISHLIST_ITEMS");
+
+// ---------------------------------------------
+// Customer rows without the PRODUCT join, for customers whose rows live on
+// a shard (ShardRouter.h); PRODUCT_FACTS supplies the product columns
+// ---------------------------------------------
+// Product_ID, Quantity
+inline constexpr Statement<Params<int>, Row<int, int>> CART_ROWS{
+    "SELECT Product_ID, Quantity FROM Cart WHERE Customer_ID = ? ORDER BY Product_ID"};
+static_assert(CART_ROWS.valid(), "CART_ROWS");
+
+// WishlistID, ProductID
+inline constexpr Statement<Params<int>, Row<int, int>> WISHLIST_ROWS{
+    "SELECT WishlistID, ProductID FROM WISHLIST WHERE CustomerID = ?"};
+static_assert(WISHLIST_ROWS.valid(), "WISHLIST_ROWS");
+
+// ProductID, Quantity, PriceAtPurchase, Subtotal
+inline constexpr Statement<Params<int>, Row<int, int, Money, Money>> ORDER_ITEM_ROWS{
+    "SELECT ProductID, Quantity, PriceAtPurchase, Subtotal FROM OrderItems WHERE OrderID = ?"};
+static_assert(ORDER_ITEM_ROWS.valid(), "ORDER_ITEM_ROWS");
+
+// ---------------------------------------------
+// Products
+// ---------------------------------------------
+// -> ProductFacts; callers add the WHERE
+inline constexpr Select<Row<int, string, Money, int>> PRODUCT_FACTS{
+    "SELECT Product_ID, Product_Name, Price, Stock_Qtn FROM PRODUCT"};
+static_assert(PRODUCT_FACTS.valid(), "PRODUCT_FACTS");
+
+// Catalog warm-up, one id range per connection:
+// Product(id, name, category, subcategory, price, stock, company, expiry) + SID
+inline constexpr Statement<Params<int64_t, int64_t>,
+                           Row<int, string, string, string, Money, int, string, Date, int>> PRODUCT_RANGE{
+    "SELECT Product_ID, Product_Name, Category, Subcategory, Price, Stock_Qtn, "
+    "       Company_name, ExpiryDate, SID "
+    "FROM PRODUCT WHERE Product_ID BETWEEN ? AND ? ORDER BY Product_ID"};
+static_assert(PRODUCT_RANGE.valid(), "PRODUCT_RANGE");
+
+// List view rows -> ListRow {productId, name, stock, price, expiry, supplier};
+// callers add the WHERE / ORDER BY / LIMIT
+inline constexpr Select<Row<int, string, int, Money, Date, string>> LIST_ROWS{
+    "SELECT p.Product_ID, p.Product_Name, p.Stock_Qtn, p.Price, p.ExpiryDate, "
+    "       COALESCE(s.Sname, '') "
+    "FROM PRODUCT p LEFT JOIN Supplier s ON p.SID = s.SID"};
+static_assert(LIST_ROWS.valid(), "LIST_ROWS");
+
+// Product details screen with its supplier (SID NULL = no supplier);
+// callers add the WHERE
+inline constexpr Select<Row<int, string, string, string, Money, int, string, Date,
+                            std::optional<int>, string, string, string, string>> PRODUCT_DETAILS{
+    "SELECT p.Product_ID, p.Product_Name, p.Category, p.Subcategory, p.Price, p.Stock_Qtn, "
+    "       p.Company_name, p.ExpiryDate, s.SID, s.Sname, s.Contact_Num, s.Email, s.Address "
+    "FROM PRODUCT p LEFT JOIN Supplier s ON p.SID = s.SID"};
+static_assert(PRODUCT_DETAILS.valid(), "PRODUCT_DETAILS");
+
+} // namespace stmts
+
+#endif
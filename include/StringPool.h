@@ -0,0 +1,80 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+
+// Process-wide pool of interned strings, for the short values that repeat on
+// every row: category, subcategory, brand, city, state, country.
+// Each distinct value is stored once and never freed or moved, so pointers
+// into the pool stay valid until exit. Split into shards by hash so parallel
+// loaders (catalog warm-up) rarely wait on each other.
+class StringPool {
+private:
+    static const size_t SHARDS = 16;
+
+    struct Shard {
+        std::mutex mtx;
+        std::deque<std::string> values;     // stable addresses
+        std::unordered_map<std::string_view, const std::string*> index;
+        size_t bytes = 0;                   // heap used by values
+    };
+    Shard shards[SHARDS];
+    std::string emptyValue;
+
+    Shard& shardFor(std::string_view s);
+
+public:
+    static StringPool& global();
+
+    const std::string* empty() const { return &emptyValue; }
+
+    // The pooled copy of s, added on first use
+    const std::string* intern(std::string_view s);
+
+    // The pooled copy of s, or nullptr if it was never interned
+    const std::string* find(std::string_view s);
+
+    size_t size();
+    size_t memoryBytes();           // strings + index, approximate
+};
+
+// 8-byte handle to a pooled string. Copies are free, equality is a pointer
+// compare, and ordering is by string value.
+class InternedString {
+private:
+    const std::string* value;
+
+    explicit InternedString(const std::string* p) : value(p) {}
+
+public:
+    InternedString() : value(StringPool::global().empty()) {}
+    InternedString(std::string_view s) : value(StringPool::global().intern(s)) {}
+    InternedString(const std::string &s) : InternedString(std::string_view(s)) {}
+    InternedString(const char* s) : InternedString(std::string_view(s)) {}
+
+    // Lookup without adding (e.g. for user input): false if s is not pooled
+    static bool find(std::string_view s, InternedString &out) {
+        const std::string* p = StringPool::global().find(s);
+        if (p) out.value = p;
+        return p != nullptr;
+    }
+
+    const std::string& str() const { return *value; }
+    operator const std::string&() const { return *value; }
+    bool empty() const { return value->empty(); }
+
+    bool operator==(const InternedString &o) const { return value == o.value; }
+    bool operator!=(const InternedString &o) const { return value != o.value; }
+    bool operator<(const InternedString &o) const { return value != o.value && *value < *o.value; }
+
+    struct Hash {
+        size_t operator()(const InternedString &s) const { return std::hash<const void*>()(s.value); }
+    };
+};
+
+#endif
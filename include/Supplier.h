@@ -2,6 +2,7 @@
 #define SUPPLIER_H
 
 #include <string>
+#include <utility>
 using namespace std;
 
 class Supplier {
@@ -13,7 +14,7 @@ public:
         string email;
         string address;
 
-        Supplier();
+        Supplier() : id(0), cont_num(0) {}
         Supplier(int i, string n, long int cnum, string e, string add);
 
 };
@@ -2,12 +2,35 @@
 #define WISHLISTFUNCTIONS_H
 
 #include <vector>
+#include <memory_resource>
 #include <cppconn/connection.h>
 #include "Wishlist.h"
+#include "CartSnapshot.h"
 
-bool addToWishlist(sql::Connection* con, int customerId, int productId);
+// Single-statement writes (INSERT / DELETE), safe to repeat: a duplicate add
+// is reported as already there, an unknown product as such.
+// Needs UNIQUE (CustomerID, ProductID) on WISHLIST.
+bool addToWishlist(sql::Connection* con, int customerId, int productId);   // false if already there / unknown
 bool removeFromWishlist(sql::Connection* con, int customerId, int productId);
-std::vector<Wishlist> viewWishlist(sql::Connection* con, int customerId);
+std::pmr::vector<Wishlist> viewWishlist(sql::Connection* con, int customerId,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+// Batched: one statement for all ids (adds also look up which products exist
+// and which are already listed). Return rows added / removed, -1 on SQL error.
+int addManyToWishlist(sql::Connection* con, int customerId, const std::vector<int> &productIds);
+int removeManyFromWishlist(sql::Connection* con, int customerId, const std::vector<int> &productIds);
+
+// Every wishlist item goes to the cart (quantity 1) through one stock-checked
+// batch (addManyToCart); items that were added leave the wishlist, the rest
+// stay and are listed in `unavailable`.
+bool moveWishlistToCart(sql::Connection* con, int customerId, int &moved,
+                        std::vector<StockShortfall> &unavailable);
+
+// Wishlist product ids of the logged-in customer, loaded once per session and
+// kept up to date by the functions above, so product lists can mark wishlist
+// items without a query.
+void loadWishlistMembership(sql::Connection* con, int customerId);
+bool inSessionWishlist(int productId);
 
 // Menu
 void runWishlistMenu(sql::Connection* con, int customerId);
@@ -3,6 +3,16 @@
 
 #include <string>
 #include <cppconn/connection.h>
+#include "Customer.h"
+#include "Session.h"
+
+enum LoginResult {
+    LOGIN_OK,
+    LOGIN_BAD_CREDENTIALS,
+    LOGIN_NO_PROFILE,      // LOGIN row exists but no CUSTOMER_DETAILS
+    LOGIN_BUSY,            // password hashing queue full, retry shortly
+    LOGIN_ERROR
+};
 
 // Interactive login window: prompts user for email+password and authenticates.
 // On success it sets `email` to the logged-in email and returns true.
@@ -16,6 +26,20 @@ bool registerUser(sql::Connection* con);
 bool registerNewLogin(sql::Connection* con, const std::string& email, const std::string& pass);
 
 // Authenticate a given email+password against the Login table (returns true if match).
+// Plain-text or weaker-cost rows are rehashed on a successful match.
 bool authenticateLogin(sql::Connection* con, const std::string& email, const std::string& pass);
 
+// Authenticate and resolve customer ID, profile, default address and cart size
+// in one joined query.
+LoginResult loginAndResolve(sql::Connection* con, const std::string& email,
+                            const std::string& pass, CustomerSession& out);
+
+// Interactive login that fills the whole session in one round trip.
+LoginResult loginWindow(sql::Connection* con, CustomerSession& session);
+
+// Create LOGIN + CUSTOMER_DETAILS in one transaction and return the new
+// customer in `out`. Nothing is written if either insert fails.
+bool registerCustomer(sql::Connection* con, const Customer& c,
+                      const std::string& pass, CustomerSession& out);
+
 #endif // LOGIN_H
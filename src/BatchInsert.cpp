@@ -0,0 +1,53 @@
+// BatchInsert.cpp
+#include "BatchInsert.h"
+
+using namespace std;
+
+MultiRowStatement::MultiRowStatement(sql::Connection* c, const string &pre,
+                                     int cols, size_t rows, const string &suf)
+    : con(c), prefix(pre), suffix(suf), columns(cols),
+      batchRows(rows == 0 ? 1 : rows),
+      fullStmt(nullptr), tailStmt(nullptr), tailRows(0) {}
+
+MultiRowStatement::~MultiRowStatement() {
+    if (fullStmt) delete fullStmt;
+    if (tailStmt) delete tailStmt;
+}
+
+string MultiRowStatement::buildSQL(size_t rows) const {
+    string tuple = "(";
+    for (int c = 0; c < columns; ++c)
+        tuple += (c == 0 ? "?" : ",?");
+    tuple += ")";
+
+    string sql;
+    sql.reserve(prefix.size() + suffix.size() + rows * (tuple.size() + 1) + 16);
+    sql += prefix;
+    sql += " VALUES ";
+    for (size_t r = 0; r < rows; ++r) {
+        if (r) sql += ',';
+        sql += tuple;
+    }
+    if (!suffix.empty()) {
+        sql += ' ';
+        sql += suffix;
+    }
+    return sql;
+}
+
+sql::PreparedStatement* MultiRowStatement::begin(size_t rows) {
+    if (rows == batchRows) {
+        if (!fullStmt) fullStmt = con->prepareStatement(buildSQL(rows));
+        fullStmt->clearParameters();
+        return fullStmt;
+    }
+
+    // short batch (usually the last one): re-prepare only if the size changed
+    if (!tailStmt || tailRows != rows) {
+        if (tailStmt) delete tailStmt;
+        tailStmt = con->prepareStatement(buildSQL(rows));
+        tailRows = rows;
+    }
+    tailStmt->clearParameters();
+    return tailStmt;
+}
@@ -0,0 +1,590 @@
+// BulkImport.cpp
+// Parallel parse -> validate -> dictionary-encode -> multi-row upsert
+
+#include "BulkImport.h"
+#include "BatchInsert.h"
+#include "DBFunctions.h"
+#include "Date.h"
+#include "Money.h"
+#include "QueryCache.h"
+
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <unordered_map>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+
+#include <cppconn/prepared_statement.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+// -----------------------------
+// Feed fields
+// -----------------------------
+enum Field {
+    F_PRODUCT_ID, F_NAME, F_CATEGORY, F_SUBCATEGORY, F_PRICE, F_STOCK,
+    F_COMPANY, F_EXPIRY, F_SID, F_SNAME, F_SCONTACT, F_SEMAIL, F_SADDRESS,
+    FIELD_COUNT
+};
+
+const char* FIELD_NAMES[FIELD_COUNT] = {
+    "product_id", "product_name", "category", "subcategory", "price", "stock_qtn",
+    "company_name", "expirydate", "sid", "sname", "supplier_contact",
+    "supplier_email", "supplier_address"
+};
+
+const size_t MAX_REPORTED_ERRORS = 10;
+
+int fieldIndex(string key) {
+    for (auto &ch : key) ch = (char)tolower((unsigned char)ch);
+    for (int i = 0; i < FIELD_COUNT; ++i)
+        if (key == FIELD_NAMES[i]) return i;
+    return -1;
+}
+
+// -----------------------------
+// String dictionary (per parse chunk, merged afterwards)
+// -----------------------------
+class Dictionary {
+public:
+    vector<string> values;
+    unordered_map<string, uint32_t> index;
+
+    uint32_t encode(const string &s) {
+        auto it = index.find(s);
+        if (it != index.end()) return it->second;
+        uint32_t id = (uint32_t)values.size();
+        values.push_back(s);
+        index.emplace(s, id);
+        return id;
+    }
+};
+
+// One validated product row; repeating strings are dictionary codes
+struct ProductRow {
+    int productId;         // 0 = let AUTO_INCREMENT assign
+    string name;
+    uint32_t category;
+    uint32_t subcategory;
+    uint32_t company;
+    uint32_t expiry;
+    Money price;
+    int stock;
+    int sid;               // 0 = no supplier
+};
+
+struct SupplierRow {
+    int sid;
+    string name, contact, email, address;
+};
+
+struct ChunkResult {
+    vector<ProductRow> rows;
+    map<int, SupplierRow> suppliers;
+    Dictionary categories, subcategories, companies, expiries;
+    size_t lines = 0;          // lines consumed (for absolute line numbers)
+    size_t read = 0;
+    size_t rejected = 0;
+    vector<pair<size_t, string>> errors;   // (local line, reason)
+};
+
+// -----------------------------
+// Field parsers / validators
+// -----------------------------
+bool parseInt(const string &s, int &out) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    long v = strtol(s.c_str(), &end, 10);
+    if (*end != '\0' || v < 0 || v > 2147483647L) return false;
+    out = (int)v;
+    return true;
+}
+
+// Plain decimal rupees, 0 .. 1e9. More than 10 integer digits is over the
+// limit anyway, and rejecting it first keeps parseSQL clear of overflow.
+bool parsePrice(const string &s, Money &out) {
+    size_t dot = s.find('.');
+    if ((dot == string::npos ? s.size() : dot) > 10) return false;
+    Money v;
+    if (!Money::parseSQL(s, v) || v < Money() || v > Money::fromPaise(100000000000LL)) return false;
+    out = v;
+    return true;
+}
+
+// YYYY-MM-DD with a real calendar day
+// strict YYYY-MM-DD: a date that survives the round trip (so no 2023-02-30)
+bool validDate(const string &s) {
+    if (s.size() != 10) return false;
+    Date d = Date::fromSQL(s);
+    return d.isSet() && d.toSQL() == s;
+}
+
+// -----------------------------
+// CSV: split one line into fields (RFC 4180 quoting, no embedded newlines)
+// -----------------------------
+void splitCsvLine(const char* p, const char* end, vector<string> &out) {
+    out.clear();
+    string cur;
+    bool quoted = false;
+
+    for (; p < end; ++p) {
+        char ch = *p;
+        if (quoted) {
+            if (ch == '"') {
+                if (p + 1 < end && p[1] == '"') { cur += '"'; ++p; }
+                else quoted = false;
+            } else cur += ch;
+        }
+        else if (ch == '"') quoted = true;
+        else if (ch == ',') { out.push_back(cur); cur.clear(); }
+        else if (ch != '\r') cur += ch;
+    }
+    out.push_back(cur);
+}
+
+// -----------------------------
+// JSON lines: flat object of string / number / bool / null values
+// -----------------------------
+void skipSpace(const char* &p, const char* end) {
+    while (p < end && isspace((unsigned char)*p)) ++p;
+}
+
+void appendUtf8(string &s, unsigned cp) {
+    if (cp < 0x80) s += (char)cp;
+    else if (cp < 0x800) {
+        s += (char)(0xC0 | (cp >> 6));
+        s += (char)(0x80 | (cp & 0x3F));
+    } else {
+        s += (char)(0xE0 | (cp >> 12));
+        s += (char)(0x80 | ((cp >> 6) & 0x3F));
+        s += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+bool parseJsonString(const char* &p, const char* end, string &out) {
+    out.clear();
+    if (p >= end || *p != '"') return false;
+    ++p;
+    while (p < end && *p != '"') {
+        if (*p == '\\') {
+            if (++p >= end) return false;
+            switch (*p) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': {
+                    if (end - p < 5) return false;
+                    unsigned cp = (unsigned)strtoul(string(p + 1, 4).c_str(), nullptr, 16);
+                    appendUtf8(out, cp);
+                    p += 4;
+                    break;
+                }
+                default: out += *p; break;     // \" \\ \/
+            }
+            ++p;
+        } else {
+            out += *p++;
+        }
+    }
+    if (p >= end) return false;
+    ++p;   // closing quote
+    return true;
+}
+
+// Fills fields[] by key; unknown keys are ignored
+bool parseJsonLine(const char* p, const char* end, vector<string> &fields, string &err) {
+    fields.assign(FIELD_COUNT, string());
+    string key, value;
+
+    skipSpace(p, end);
+    if (p >= end || *p != '{') { err = "expected '{'"; return false; }
+    ++p;
+
+    while (true) {
+        skipSpace(p, end);
+        if (p < end && *p == '}') return true;
+
+        if (!parseJsonString(p, end, key)) { err = "bad key"; return false; }
+        skipSpace(p, end);
+        if (p >= end || *p != ':') { err = "expected ':'"; return false; }
+        ++p;
+        skipSpace(p, end);
+
+        if (p < end && *p == '"') {
+            if (!parseJsonString(p, end, value)) { err = "bad string value"; return false; }
+        } else {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '}' && !isspace((unsigned char)*p)) ++p;
+            value.assign(start, p);
+            if (value == "null") value.clear();
+            else if (value == "true") value = "1";
+            else if (value == "false") value = "0";
+        }
+
+        int idx = fieldIndex(key);
+        if (idx >= 0) fields[idx] = value;
+
+        skipSpace(p, end);
+        if (p < end && *p == ',') { ++p; continue; }
+        if (p < end && *p == '}') return true;
+        err = "expected ',' or '}'";
+        return false;
+    }
+}
+
+// -----------------------------
+// Validate + encode one record into the chunk
+// -----------------------------
+bool acceptRecord(const vector<string> &f, ChunkResult &out, string &err) {
+    ProductRow r;
+
+    r.productId = 0;
+    if (!f[F_PRODUCT_ID].empty() && !parseInt(f[F_PRODUCT_ID], r.productId)) {
+        err = "invalid Product_ID '" + f[F_PRODUCT_ID] + "'"; return false;
+    }
+    if (f[F_NAME].empty()) { err = "missing Product_Name"; return false; }
+    if (f[F_NAME].size() > 255) { err = "Product_Name too long"; return false; }
+    if (f[F_CATEGORY].empty()) { err = "missing Category"; return false; }
+    if (!parsePrice(f[F_PRICE], r.price)) { err = "invalid Price '" + f[F_PRICE] + "'"; return false; }
+    if (!parseInt(f[F_STOCK], r.stock)) { err = "invalid Stock_Qtn '" + f[F_STOCK] + "'"; return false; }
+    if (!f[F_EXPIRY].empty() && !validDate(f[F_EXPIRY])) {
+        err = "invalid ExpiryDate '" + f[F_EXPIRY] + "'"; return false;
+    }
+
+    r.sid = 0;
+    if (!f[F_SID].empty() && !parseInt(f[F_SID], r.sid)) {
+        err = "invalid SID '" + f[F_SID] + "'"; return false;
+    }
+
+    r.name = f[F_NAME];
+    r.category = out.categories.encode(f[F_CATEGORY]);
+    r.subcategory = out.subcategories.encode(f[F_SUBCATEGORY]);
+    r.company = out.companies.encode(f[F_COMPANY]);
+    r.expiry = out.expiries.encode(f[F_EXPIRY]);
+
+    int sid = r.sid;
+    out.rows.push_back(std::move(r));
+
+    if (sid > 0 && !f[F_SNAME].empty() && out.suppliers.find(sid) == out.suppliers.end()) {
+        SupplierRow s{sid, f[F_SNAME], f[F_SCONTACT], f[F_SEMAIL], f[F_SADDRESS]};
+        out.suppliers.emplace(sid, std::move(s));
+    }
+    return true;
+}
+
+void reject(ChunkResult &out, size_t line, const string &why) {
+    out.rejected++;
+    if (out.errors.size() < MAX_REPORTED_ERRORS)
+        out.errors.push_back({line, why});
+}
+
+// Parse one chunk [begin, end) of whole lines
+void parseChunk(const char* begin, const char* end, FeedFormat format,
+                const vector<int> &csvColumns, ChunkResult &out) {
+    vector<string> cells;
+    vector<string> fields(FIELD_COUNT);
+    string err;
+
+    const char* p = begin;
+    while (p < end) {
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        if (!eol) eol = end;
+        out.lines++;
+
+        // skip blank lines
+        const char* q = p;
+        while (q < eol && isspace((unsigned char)*q)) ++q;
+        if (q == eol) { p = eol + 1; continue; }
+
+        out.read++;
+
+        bool ok;
+        if (format == FeedFormat::CSV) {
+            splitCsvLine(p, eol, cells);
+            fields.assign(FIELD_COUNT, string());
+            for (size_t c = 0; c < cells.size() && c < csvColumns.size(); ++c)
+                if (csvColumns[c] >= 0) fields[csvColumns[c]] = cells[c];
+            ok = acceptRecord(fields, out, err);
+        } else {
+            ok = parseJsonLine(p, eol, fields, err) && acceptRecord(fields, out, err);
+        }
+
+        if (!ok) reject(out, out.lines, err);
+        p = eol + 1;
+    }
+}
+
+double secondsSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// -----------------------------
+// Writers
+// -----------------------------
+bool writeSuppliers(const map<int, SupplierRow> &suppliers, size_t batchRows, size_t &written) {
+    if (suppliers.empty()) return true;
+
+    sql::Connection* con = nullptr;
+    try {
+        con = createConnection();
+        con->setAutoCommit(false);
+
+        MultiRowStatement stmt(con,
+            "INSERT INTO Supplier (SID, Sname, Contact_Num, Email, Address)", 5, batchRows,
+            "ON DUPLICATE KEY UPDATE Sname = VALUES(Sname), Contact_Num = VALUES(Contact_Num), "
+            "Email = VALUES(Email), Address = VALUES(Address)");
+
+        vector<const SupplierRow*> all;
+        for (auto &kv : suppliers) all.push_back(&kv.second);
+
+        for (size_t i = 0; i < all.size(); i += batchRows) {
+            size_t n = min(batchRows, all.size() - i);
+            sql::PreparedStatement* ps = stmt.begin(n);
+            for (size_t r = 0; r < n; ++r) {
+                const SupplierRow &s = *all[i + r];
+                ps->setInt(stmt.param(r, 0), s.sid);
+                ps->setString(stmt.param(r, 1), s.name);
+                ps->setString(stmt.param(r, 2), s.contact);
+                ps->setString(stmt.param(r, 3), s.email);
+                ps->setString(stmt.param(r, 4), s.address);
+            }
+            ps->executeUpdate();
+            con->commit();
+            written += n;
+        }
+
+        con->close();
+        delete con;
+        return true;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in writeSuppliers: " << e.what() << endl;
+        if (con) { con->close(); delete con; }
+        return false;
+    }
+}
+
+struct GlobalDicts {
+    vector<string> categories, subcategories, companies, expiries;
+};
+
+// Writes rows[begin, end) over its own connection, one commit per batch
+bool writeProductSlice(const vector<ProductRow> &rows, size_t begin, size_t end,
+                       const GlobalDicts &dict, size_t batchRows, size_t &written) {
+    sql::Connection* con = nullptr;
+    try {
+        con = createConnection();
+        con->setAutoCommit(false);
+
+        MultiRowStatement stmt(con,
+            "INSERT INTO PRODUCT (Product_ID, Product_Name, Category, Subcategory, "
+            "Price, Stock_Qtn, Company_name, ExpiryDate, SID)", 9, batchRows,
+            "ON DUPLICATE KEY UPDATE Product_Name = VALUES(Product_Name), "
+            "Category = VALUES(Category), Subcategory = VALUES(Subcategory), "
+            "Price = VALUES(Price), Stock_Qtn = VALUES(Stock_Qtn), "
+            "Company_name = VALUES(Company_name), ExpiryDate = VALUES(ExpiryDate), "
+            "SID = VALUES(SID)");
+
+        for (size_t i = begin; i < end; i += batchRows) {
+            size_t n = min(batchRows, end - i);
+            sql::PreparedStatement* ps = stmt.begin(n);
+
+            for (size_t r = 0; r < n; ++r) {
+                const ProductRow &p = rows[i + r];
+                if (p.productId > 0) ps->setInt(stmt.param(r, 0), p.productId);
+                else ps->setNull(stmt.param(r, 0), sql::DataType::INTEGER);
+                ps->setString(stmt.param(r, 1), p.name);
+                ps->setString(stmt.param(r, 2), dict.categories[p.category]);
+                ps->setString(stmt.param(r, 3), dict.subcategories[p.subcategory]);
+                ps->setString(stmt.param(r, 4), p.price.toString());
+                ps->setInt(stmt.param(r, 5), p.stock);
+                ps->setString(stmt.param(r, 6), dict.companies[p.company]);
+                const string &exp = dict.expiries[p.expiry];
+                if (!exp.empty()) ps->setString(stmt.param(r, 7), exp);
+                else ps->setNull(stmt.param(r, 7), sql::DataType::DATE);
+                if (p.sid > 0) ps->setInt(stmt.param(r, 8), p.sid);
+                else ps->setNull(stmt.param(r, 8), sql::DataType::INTEGER);
+            }
+
+            ps->executeUpdate();
+            con->commit();
+            written += n;
+        }
+
+        con->close();
+        delete con;
+        return true;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in writeProductSlice: " << e.what() << endl;
+        if (con) { con->close(); delete con; }
+        return false;
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------
+// PUBLIC
+// ---------------------------------------------
+FeedFormat feedFormatFromPath(const string &path) {
+    size_t dot = path.rfind('.');
+    if (dot != string::npos) {
+        string ext = path.substr(dot + 1);
+        for (auto &ch : ext) ch = (char)tolower((unsigned char)ch);
+        if (ext == "jsonl" || ext == "ndjson" || ext == "json") return FeedFormat::JSONL;
+    }
+    return FeedFormat::CSV;
+}
+
+bool importProductFeed(const string &path, const ImportOptions &opt, ImportStats &stats) {
+    auto t0 = chrono::steady_clock::now();
+
+    // 1) read whole file
+    ifstream in(path, ios::binary);
+    if (!in) {
+        cerr << "Cannot open feed: " << path << endl;
+        return false;
+    }
+    string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+
+    const char* begin = data.data();
+    const char* end = data.data() + data.size();
+    size_t headerLines = 0;
+
+    // 2) CSV header -> column mapping
+    vector<int> csvColumns;
+    if (opt.format == FeedFormat::CSV) {
+        const char* eol = (const char*)memchr(begin, '\n', end - begin);
+        if (!eol) eol = end;
+        vector<string> header;
+        splitCsvLine(begin, eol, header);
+        for (auto &h : header) csvColumns.push_back(fieldIndex(h));
+
+        bool hasName = find(csvColumns.begin(), csvColumns.end(), (int)F_NAME) != csvColumns.end();
+        if (!hasName) {
+            cerr << "CSV header must contain Product_Name.\n";
+            return false;
+        }
+        begin = (eol < end) ? eol + 1 : end;
+        headerLines = 1;
+    }
+
+    // 3) split into line-aligned chunks and parse in parallel
+    int threads = opt.parseThreads > 0 ? opt.parseThreads : (int)thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    size_t total = end - begin;
+    if (total < (size_t)threads * 64 * 1024) threads = max(1, (int)(total / (64 * 1024)));
+
+    vector<const char*> cuts{begin};
+    for (int i = 1; i < threads; ++i) {
+        const char* guess = begin + total * i / threads;
+        if (guess < cuts.back()) guess = cuts.back();
+        const char* nl = (const char*)memchr(guess, '\n', end - guess);
+        cuts.push_back(nl ? nl + 1 : end);
+    }
+    cuts.push_back(end);
+
+    vector<ChunkResult> chunks(threads);
+    vector<thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(parseChunk, cuts[i], cuts[i + 1], opt.format,
+                             cref(csvColumns), ref(chunks[i]));
+    }
+    for (auto &t : workers) t.join();
+    workers.clear();
+
+    // 4) merge chunk dictionaries into global ones and remap codes
+    GlobalDicts dict;
+    Dictionary gCat, gSub, gComp, gExp;
+    map<int, SupplierRow> suppliers;
+    vector<ProductRow> rows;
+
+    size_t totalRows = 0;
+    for (auto &c : chunks) totalRows += c.rows.size();
+    rows.reserve(totalRows);
+
+    size_t lineBase = headerLines;
+    for (auto &c : chunks) {
+        vector<uint32_t> mapCat, mapSub, mapComp, mapExp;
+        for (auto &s : c.categories.values) mapCat.push_back(gCat.encode(s));
+        for (auto &s : c.subcategories.values) mapSub.push_back(gSub.encode(s));
+        for (auto &s : c.companies.values) mapComp.push_back(gComp.encode(s));
+        for (auto &s : c.expiries.values) mapExp.push_back(gExp.encode(s));
+
+        for (auto &r : c.rows) {
+            r.category = mapCat[r.category];
+            r.subcategory = mapSub[r.subcategory];
+            r.company = mapComp[r.company];
+            r.expiry = mapExp[r.expiry];
+            rows.push_back(std::move(r));
+        }
+        c.rows.clear();
+        c.rows.shrink_to_fit();
+
+        for (auto &kv : c.suppliers) suppliers.emplace(kv.first, std::move(kv.second));
+
+        stats.rowsRead += c.read;
+        stats.rowsRejected += c.rejected;
+        for (auto &e : c.errors) {
+            if (stats.errors.size() >= MAX_REPORTED_ERRORS) break;
+            stats.errors.push_back("line " + to_string(lineBase + e.first) + ": " + e.second);
+        }
+        lineBase += c.lines;
+    }
+    chunks.clear();
+
+    dict.categories = std::move(gCat.values);
+    dict.subcategories = std::move(gSub.values);
+    dict.companies = std::move(gComp.values);
+    dict.expiries = std::move(gExp.values);
+    stats.distinctCategories = dict.categories.size();
+    stats.distinctCompanies = dict.companies.size();
+    stats.parseSeconds = secondsSince(t0);
+
+    if (opt.dryRun) return true;
+
+    // 5) write: suppliers first (FK target), then product slices in parallel
+    auto t1 = chrono::steady_clock::now();
+
+    // keep below MySQL's 65535 placeholder limit (9 params per product row)
+    size_t batchRows = min<size_t>(max<size_t>(opt.batchRows, 1), 7000);
+
+    if (!writeSuppliers(suppliers, batchRows, stats.suppliersWritten)) {
+        stats.writeSeconds = secondsSince(t1);
+        return false;
+    }
+
+    int writers = max(1, opt.writerConnections);
+    if ((size_t)writers > rows.size()) writers = max<int>(1, (int)rows.size());
+
+    vector<size_t> written(writers, 0);
+    vector<char> ok(writers, 1);
+    for (int w = 0; w < writers; ++w) {
+        size_t from = rows.size() * w / writers;
+        size_t to = rows.size() * (w + 1) / writers;
+        workers.emplace_back([&, w, from, to] {
+            ok[w] = writeProductSlice(rows, from, to, dict, batchRows, written[w]);
+        });
+    }
+    for (auto &t : workers) t.join();
+
+    bool allOk = true;
+    for (int w = 0; w < writers; ++w) {
+        stats.productsWritten += written[w];
+        allOk = allOk && ok[w];
+    }
+    stats.writeSeconds = secondsSince(t1);
+    if (stats.productsWritten > 0) invalidateProductResults();
+    return allOk;
+}
@@ -3,10 +3,16 @@
 #include "Cart.h"
 #include "DBFunctions.h"
 #include "Functions.h"
+#include "DBRouter.h"
+#include "ShardRouter.h"
+#include "CartSnapshot.h"
+#include "BatchInsert.h"
 
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <unordered_map>
+#include <algorithm>
 
 #include <cppconn/prepared_statement.h>
 #include <cppconn/resultset.h>
@@ -31,6 +37,7 @@ bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty) {
     try {
         sql::PreparedStatement* pstmt = nullptr;
         sql::ResultSet* res = nullptr;
+        sql::Connection* cartCon = shardWrite(con, customer_id);
 
         // 1) Check stock
         pstmt = con->prepareStatement("SELECT Stock_Qtn FROM PRODUCT WHERE Product_ID = ?");
@@ -52,7 +59,7 @@ bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty) {
         }
 
         // 2) Check if already in cart
-        pstmt = con->prepareStatement(
+        pstmt = cartCon->prepareStatement(
             "SELECT Quantity FROM Cart WHERE Customer_ID = ? AND Product_ID = ?"
         );
         pstmt->setInt(1, customer_id);
@@ -79,7 +86,7 @@ bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty) {
             delete res; delete pstmt;
 
             // Update cart
-            pstmt = con->prepareStatement(
+            pstmt = cartCon->prepareStatement(
                 "UPDATE Cart SET Quantity = ? WHERE Customer_ID = ? AND Product_ID = ?"
             );
             pstmt->setInt(1, newQty);
@@ -89,6 +96,7 @@ bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty) {
             delete pstmt;
 
             if (rows > 0) {
+                noteWrite(customer_id);
                 cout << "✅ Quantity updated in cart.\n";
                 return true;
             }
@@ -98,7 +106,7 @@ bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty) {
             // Insert new item
             delete res; delete pstmt;
 
-            pstmt = con->prepareStatement(
+            pstmt = cartCon->prepareStatement(
                 "INSERT INTO Cart (Customer_ID, Product_ID, Quantity) "
                 "VALUES (?, ?, ?)"
             );
@@ -110,6 +118,7 @@ bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty) {
             delete pstmt;
 
             if (rows > 0) {
+                noteWrite(customer_id);
                 cout << "✅ Added to cart.\n";
                 return true;
             }
@@ -128,57 +137,13 @@ bool addToCart(sql::Connection* con, int customer_id, int product_id, int qty) {
 vector<Cart> viewCart(sql::Connection* con, int customer_id) {
     vector<Cart> cartItems;
 
-    try {
-        sql::PreparedStatement* pstmt =
-            con->prepareStatement(
-                "SELECT c.Product_ID, c.Quantity, p.Product_Name, p.Price "
-                "FROM Cart c JOIN PRODUCT p ON c.Product_ID = p.Product_ID "
-                "WHERE c.Customer_ID = ?"
-            );
-        pstmt->setInt(1, customer_id);
-        sql::ResultSet* res = pstmt->executeQuery();
-
-        cout << "\n========== YOUR CART ==========\n";
-        cout << left << setw(10) << "PID"
-             << setw(35) << "Product Name"
-             << setw(10) << "Qty"
-             << setw(10) << "Price"
-             << setw(10) << "Subtotal"
-             << endl;
-        cout << string(75, '-') << endl;
-
-        double total = 0.0;
-
-        while (res->next()) {
-            int pid = res->getInt("Product_ID");
-            int qty = res->getInt("Quantity");
-            string pname = res->getString("Product_Name");
-            double price = res->getDouble("Price");
-            double subtotal = price * qty;
-
-            cout << left << setw(10) << pid
-                 << setw(35) << pname
-                 << setw(10) << qty
-                 << setw(10) << price
-                 << setw(10) << subtotal
-                 << endl;
-
-            total += subtotal;
-
-            Cart c(customer_id, pid, qty);
-            cartItems.push_back(c);
-        }
-
-        cout << string(75, '-') << endl;
-        cout << "TOTAL: " << total << endl << endl;
-
-        delete res;
-        delete pstmt;
-    }
-    catch (sql::SQLException &e) {
-        cerr << "SQL Error in viewCart: " << e.what() << endl;
-    }
+    CartSnapshot cart;
+    if (!cart.load(con, customer_id)) return cartItems;
+    cart.print("YOUR CART");
 
+    cartItems.reserve(cart.getLines().size());
+    for (const CartLine &l : cart.getLines())
+        cartItems.emplace_back(customer_id, l.productId, l.quantity);
     return cartItems;
 }
 
@@ -187,6 +152,7 @@ vector<Cart> viewCart(sql::Connection* con, int customer_id) {
 // ======================================================================
 bool removeFromCart(sql::Connection* con, int customer_id, int product_id) {
     try {
+        con = shardWrite(con, customer_id);
         sql::PreparedStatement* pstmt =
             con->prepareStatement("DELETE FROM Cart WHERE Customer_ID = ? AND Product_ID = ?");
         pstmt->setInt(1, customer_id);
@@ -196,6 +162,7 @@ bool removeFromCart(sql::Connection* con, int customer_id, int product_id) {
         delete pstmt;
 
         if (rows > 0) {
+            noteWrite(customer_id);
             cout << "✅ Removed from cart.\n";
             return true;
         }
@@ -216,6 +183,7 @@ bool updateCartQuantity(sql::Connection* con, int customer_id, int product_id, i
         return removeFromCart(con, customer_id, product_id);
 
     try {
+        con = shardWrite(con, customer_id);
         sql::PreparedStatement* pstmt =
             con->prepareStatement(
                 "UPDATE Cart SET Quantity = ? WHERE Customer_ID = ? AND Product_ID = ?"
@@ -228,6 +196,7 @@ bool updateCartQuantity(sql::Connection* con, int customer_id, int product_id, i
         delete pstmt;
 
         if (rows > 0) {
+            noteWrite(customer_id);
             cout << "✅ Quantity updated.\n";
             return true;
         }
@@ -241,6 +210,110 @@ bool updateCartQuantity(sql::Connection* con, int customer_id, int product_id, i
     }
 }
 
+// ======================================================================
+// ADD MANY TO CART (one stock check, one upsert)
+// ======================================================================
+bool addManyToCart(sql::Connection* con, int customer_id,
+                   const vector<pair<int, int>> &productQty,
+                   vector<StockShortfall> &shortfalls, int &addedLines) {
+    shortfalls.clear();
+    addedLines = 0;
+
+    // merge repeated products, keep first-seen order
+    vector<pair<int, int>> wanted;
+    unordered_map<int, size_t> slot;
+    for (auto &pq : productQty) {
+        if (pq.second <= 0) continue;
+        auto it = slot.find(pq.first);
+        if (it == slot.end()) {
+            slot.emplace(pq.first, wanted.size());
+            wanted.push_back(pq);
+        } else {
+            wanted[it->second].second += pq.second;
+        }
+    }
+    if (wanted.empty()) return true;
+
+    try {
+        sql::Connection* cartCon = shardWrite(con, customer_id);
+
+        // 1) stock and what is already in the cart, for every line at once
+        //    (a second query when the cart is on another shard)
+        string ids = "?";
+        for (size_t i = 1; i < wanted.size(); ++i) ids += ", ?";
+        bool joined = cartCon == con;
+        sql::PreparedStatement* pstmt = con->prepareStatement(
+            joined ? "SELECT p.Product_ID, p.Product_Name, p.Stock_Qtn, COALESCE(c.Quantity, 0) "
+                     "FROM PRODUCT p LEFT JOIN Cart c "
+                     "ON c.Product_ID = p.Product_ID AND c.Customer_ID = ? "
+                     "WHERE p.Product_ID IN (" + ids + ")"
+                   : "SELECT p.Product_ID, p.Product_Name, p.Stock_Qtn, 0 "
+                     "FROM PRODUCT p WHERE p.Product_ID IN (" + ids + ")"
+        );
+        unsigned int first = 1;
+        if (joined) pstmt->setInt(first++, customer_id);
+        for (size_t i = 0; i < wanted.size(); ++i) pstmt->setInt(first + i, wanted[i].first);
+        sql::ResultSet* res = pstmt->executeQuery();
+
+        struct Room { string name; int free; };
+        unordered_map<int, Room> room;
+        while (res->next()) {
+            int spare = res->getInt(3) - res->getInt(4);
+            room[res->getInt(1)] = { res->getString(2), spare > 0 ? spare : 0 };
+        }
+        delete res;
+        delete pstmt;
+
+        if (!joined) {
+            pstmt = cartCon->prepareStatement(
+                "SELECT Product_ID, Quantity FROM Cart "
+                "WHERE Customer_ID = ? AND Product_ID IN (" + ids + ")"
+            );
+            pstmt->setInt(1, customer_id);
+            for (size_t i = 0; i < wanted.size(); ++i) pstmt->setInt(i + 2, wanted[i].first);
+            res = pstmt->executeQuery();
+            while (res->next()) {
+                auto it = room.find(res->getInt(1));
+                if (it != room.end()) it->second.free = max(0, it->second.free - res->getInt(2));
+            }
+            delete res;
+            delete pstmt;
+        }
+
+        // 2) grant what fits
+        vector<pair<int, int>> grant;
+        for (auto &w : wanted) {
+            auto it = room.find(w.first);
+            int give = it == room.end() ? 0 : min(w.second, it->second.free);
+            if (give < w.second)
+                shortfalls.push_back({ w.first, it == room.end() ? "" : it->second.name,
+                                       w.second, give });
+            if (give > 0) grant.push_back({ w.first, give });
+        }
+        if (grant.empty()) return true;
+
+        // 3) one multi-row upsert
+        MultiRowStatement upsert(cartCon, "INSERT INTO Cart (Customer_ID, Product_ID, Quantity)",
+                                 3, grant.size(),
+                                 "ON DUPLICATE KEY UPDATE Quantity = Quantity + VALUES(Quantity)");
+        sql::PreparedStatement* ps = upsert.begin(grant.size());
+        for (size_t r = 0; r < grant.size(); ++r) {
+            ps->setInt(upsert.param(r, 0), customer_id);
+            ps->setInt(upsert.param(r, 1), grant[r].first);
+            ps->setInt(upsert.param(r, 2), grant[r].second);
+        }
+        ps->executeUpdate();
+
+        addedLines = (int)grant.size();
+        noteWrite(customer_id);
+        return true;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in addManyToCart: " << e.what() << endl;
+        return false;
+    }
+}
+
 // ======================================================================
 // SHOW CART SUMMARY (Checkout Helper)
 // ======================================================================
@@ -252,100 +325,95 @@ void showCartSummary(sql::Connection* con, int customer_id) {
 // CHECKOUT (with address selection)
 // ======================================================================
 bool checkoutCart(sql::Connection* con, int customer_id) {
-    try {
-        // Load items
-        sql::PreparedStatement* pstmt =
-            con->prepareStatement(
-                "SELECT c.Product_ID, c.Quantity, p.Product_Name, p.Price "
-                "FROM Cart c JOIN PRODUCT p ON c.Product_ID = p.Product_ID "
-                "WHERE c.Customer_ID = ?"
-            );
-        pstmt->setInt(1, customer_id);
-        sql::ResultSet* res = pstmt->executeQuery();
+    // One read of the cart serves the receipt and the order
+    CartSnapshot cart;
+    if (!cart.load(con, customer_id)) return false;
 
-        double total = 0;
-        vector<int> pids, qtys;
-        vector<double> prices;
-
-        cout << "\n================= RECEIPT =================\n";
-        cout << left << setw(10) << "PID"
-             << setw(30) << "Product Name"
-             << setw(10) << "Qty"
-             << setw(10) << "Price"
-             << setw(12) << "Subtotal" << endl;
-        cout << string(75, '-') << endl;
+    if (cart.empty()) {
+        cout << "⚠️ Your cart is empty.\n";
+        return false;
+    }
+    cart.print("RECEIPT");
 
-        while (res->next()) {
-            int pid = res->getInt("Product_ID");
-            int qty = res->getInt("Quantity");
-            string pname = res->getString("Product_Name");
-            double price = res->getDouble("Price");
-            double subtotal = price * qty;
-
-            cout << left << setw(10) << pid
-                 << setw(30) << pname
-                 << setw(10) << qty
-                 << setw(10) << price
-                 << setw(12) << subtotal << endl;
-
-            pids.push_back(pid);
-            qtys.push_back(qty);
-            prices.push_back(price);
-
-            total += subtotal;
-        }
+    // ADDRESS SELECTION
+    int addressId = selectDeliveryAddress(con, customer_id);
+    if (addressId == -1) {
+        cout << "\nCheckout cancelled.\n";
+        pressEnterToContinue();
+        return false;
+    }
 
-        cout << string(75, '-') << endl;
-        cout << "TOTAL AMOUNT: " << total << endl;
-        cout << "=============================================\n\n";
+    // Confirm
+    cout << "\nConfirm order? (1 = Yes, 0 = No): ";
+    int confirm;
+    cin >> confirm;
 
-        delete res;
-        delete pstmt;
+    if (confirm == 0) {
+        cout << "\nOrder cancelled.\n";
+        pressEnterToContinue();
+        return false;
+    }
 
-        if (pids.empty()) {
-            cout << "⚠️ Your cart is empty.\n";
-            return false;
-        }
+    // Create order (stock is checked and taken in the same transaction)
+    int orderId = -1;
+    vector<StockShortfall> shortfalls;
+    OrderResult result = createOrderFromSnapshot(con, cart, addressId, orderId, &shortfalls);
 
-        // ADDRESS SELECTION
-        int addressId = selectDeliveryAddress(con, customer_id);
-        if (addressId == -1) {
-            cout << "\nCheckout cancelled.\n";
+    // Some lines are short: cancel, or cut them to what is left and retry
+    while (result == ORDER_OUT_OF_STOCK) {
+        if (shortfalls.empty()) {
+            cout << "\n⚠️ Stock changed while placing the order; please try again.\n";
             pressEnterToContinue();
             return false;
         }
-
-        // Confirm
-        cout << "\nConfirm order? (1 = Yes, 0 = No): ";
-        int confirm;
-        cin >> confirm;
-
-        if (confirm == 0) {
-            cout << "\nOrder cancelled.\n";
+        cout << "\n❌ Not enough stock for:\n";
+        for (auto &s : shortfalls)
+            cout << "   " << s.name << " (PID " << s.productId << "): wanted "
+                 << s.requested << ", available " << s.available << "\n";
+
+        cout << "\nReduce these items to the available quantity and order? (1 = Yes, 0 = No): ";
+        int adjust;
+        cin >> adjust;
+        if (adjust != 1) {
+            cout << "\nOrder cancelled. Your cart is unchanged.\n";
             pressEnterToContinue();
             return false;
         }
 
-        // Create order
-        int orderId = -1;
-        bool ok = createOrderFromCart(con, customer_id, addressId, orderId);
-
-        if (!ok) {
-            cout << "\n❌ Failed to place order.\n";
+        for (auto &s : shortfalls)
+            updateCartQuantity(con, customer_id, s.productId, s.available);
+        if (!cart.load(con, customer_id) || cart.empty()) {
+            cout << "\nNothing left to order.\n";
             pressEnterToContinue();
             return false;
         }
+        cart.print("RECEIPT");
+        result = createOrderFromSnapshot(con, cart, addressId, orderId, &shortfalls);
+    }
 
-        cout << "\n✅ ORDER PLACED SUCCESSFULLY!\n";
-        cout << "🧾 ORDER ID: " << orderId << endl;
-        cout << "🛒 Cart cleared.\n";
+    if (result == ORDER_CART_CHANGED) {
+        cout << "\n⚠️ Your cart changed since it was shown (edited in another session).\n";
+        cout << "Nothing was ordered; please review the cart and check out again.\n";
         pressEnterToContinue();
-        return true;
+        return false;
     }
-    catch (sql::SQLException &e) {
-        cerr << "SQL Error in checkoutCart: " << e.what() << endl;
+    if (result == ORDER_UNCONFIRMED) {
+        cout << "\n⚠️ Order " << orderId << " could not be confirmed.\n";
+        cout << "Please check My Orders before checking out again.\n";
+        pressEnterToContinue();
         return false;
     }
+    if (result != ORDER_OK) {
+        cout << "\n❌ Failed to place order.\n";
+        pressEnterToContinue();
+        return false;
+    }
+
+    cout << "\n✅ ORDER PLACED SUCCESSFULLY!\n";
+    cout << "🧾 ORDER ID: " << orderId << endl;
+    cout << "🛒 Cart cleared.\n";
+    pressEnterToContinue();
+    return true;
 }
 
 // ======================================================================
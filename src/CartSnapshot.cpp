@@ -0,0 +1,168 @@
+// CartSnapshot.cpp
+#include "CartSnapshot.h"
+#include "DBRouter.h"
+#include "ShardRouter.h"
+#include "Statements.h"
+
+#include <iostream>
+#include <iomanip>
+#include <unordered_map>
+
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+uint64_t cartVersion(const vector<pair<int, int>> &productQty) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (auto &pq : productQty) {
+        h = (h ^ (uint32_t)pq.first) * 0x100000001B3ULL;
+        h = (h ^ (uint32_t)pq.second) * 0x100000001B3ULL;
+    }
+    return h ^ productQty.size();
+}
+
+CartSnapshot::CartSnapshot() : customerId(0), fingerprint(cartVersion({})) {}
+
+bool CartSnapshot::load(sql::Connection* con, int customer_id) {
+    customerId = customer_id;
+    lines.clear();
+    quantities.clear();
+    pricesPaise.clear();
+    fingerprint = cartVersion({});
+
+    try {
+        if (!inGlobalSchema(customer_id)) return loadSharded(con, shardRead(con, customer_id));
+
+        con = routeRead(con, customer_id);
+        sql::PreparedStatement* pstmt = sqlreg::prepare(con, stmts::CART_LINES, customer_id);
+        sql::ResultSet* res = nullptr;
+
+        vector<pair<int, int>> pq;
+        try {
+            res = pstmt->executeQuery();
+            size_t rows = res->rowsCount();
+            lines.reserve(rows);
+            quantities.reserve(rows);
+            pricesPaise.reserve(rows);
+            while (res->next()) {
+                // a price that does not parse fails the load, so checkout stops
+                CartLine line = sqlreg::readAs<CartLine>(res, stmts::CART_LINES);
+                pq.push_back({line.productId, line.quantity});
+                quantities.push_back(line.quantity);
+                pricesPaise.push_back(line.price.toPaise());
+                lines.push_back(std::move(line));
+            }
+        } catch (...) {
+            delete res;
+            delete pstmt;
+            throw;
+        }
+        delete res;
+        delete pstmt;
+
+        fingerprint = cartVersion(pq);
+        return true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in CartSnapshot::load: " << e.what() << endl;
+        lines.clear();
+        quantities.clear();
+        pricesPaise.clear();
+        return false;
+    }
+}
+
+// Cart rows from the customer's shard, names, prices and stock from PRODUCT
+bool CartSnapshot::loadSharded(sql::Connection* global, sql::Connection* shard) {
+    sql::PreparedStatement* pstmt = sqlreg::prepare(shard, stmts::CART_ROWS, customerId);
+    sql::ResultSet* res = pstmt->executeQuery();
+    vector<pair<int, int>> pq;
+    pq.reserve(res->rowsCount());
+    while (res->next()) pq.push_back(sqlreg::readAs<pair<int, int>>(res, stmts::CART_ROWS));
+    delete res;
+    delete pstmt;
+
+    vector<int> ids;
+    ids.reserve(pq.size());
+    for (auto &l : pq) ids.push_back(l.first);
+    unordered_map<int, ProductFacts> facts;
+    loadProductFacts(global, customerId, ids, facts);
+
+    // like the join: lines whose product is gone are not shown
+    vector<pair<int, int>> shown;
+    lines.reserve(pq.size());
+    quantities.reserve(pq.size());
+    pricesPaise.reserve(pq.size());
+    for (auto &l : pq) {
+        auto it = facts.find(l.first);
+        if (it == facts.end()) continue;
+        const ProductFacts &f = it->second;
+        shown.push_back(l);
+        quantities.push_back(l.second);
+        pricesPaise.push_back(f.price.toPaise());
+        lines.push_back(CartLine{l.first, f.name, l.second, f.price, f.stock});
+    }
+
+    fingerprint = cartVersion(shown);
+    return true;
+}
+
+Money CartSnapshot::total() const {
+    return Money::fromPaise(sumLineTotals(quantities.data(), pricesPaise.data(), quantities.size()));
+}
+
+bool CartSnapshot::checkStock(sql::Connection* con, vector<StockShortfall> &shortfalls) {
+    shortfalls.clear();
+    if (lines.empty()) return true;
+
+    // stock moves fast: always ask the primary
+    string sql = "SELECT Product_ID, Stock_Qtn FROM PRODUCT WHERE Product_ID IN (?";
+    for (size_t i = 1; i < lines.size(); ++i) sql += ", ?";
+    sql += ")";
+
+    try {
+        sql::PreparedStatement* pstmt = con->prepareStatement(sql);
+        for (size_t i = 0; i < lines.size(); ++i) pstmt->setInt(i + 1, lines[i].productId);
+        sql::ResultSet* res = pstmt->executeQuery();
+
+        unordered_map<int, int> stock;
+        while (res->next()) stock[res->getInt(1)] = res->getInt(2);
+        delete res;
+        delete pstmt;
+
+        for (auto &l : lines) {
+            auto it = stock.find(l.productId);
+            l.stock = it == stock.end() ? 0 : it->second;
+            if (l.stock < l.quantity)
+                shortfalls.push_back({l.productId, l.name, l.quantity, l.stock});
+        }
+        return true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in CartSnapshot::checkStock: " << e.what() << endl;
+        return false;
+    }
+}
+
+void CartSnapshot::print(const string &title) const {
+    cout << "\n========== " << title << " ==========\n";
+    cout << left << setw(10) << "PID"
+         << setw(35) << "Product Name"
+         << setw(10) << "Qty"
+         << setw(10) << "Price"
+         << setw(10) << "Subtotal"
+         << endl;
+    cout << string(75, '-') << endl;
+
+    for (auto &l : lines) {
+        cout << left << setw(10) << l.productId
+             << setw(35) << l.name
+             << setw(10) << l.quantity
+             << setw(10) << l.price
+             << setw(10) << l.subtotal()
+             << endl;
+    }
+
+    cout << string(75, '-') << endl;
+    cout << "TOTAL: " << total() << endl << endl;
+}
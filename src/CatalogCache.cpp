@@ -0,0 +1,341 @@
+// CatalogCache.cpp
+// Parallel catalog warm-up over pooled connections + atomic publish
+
+#include "CatalogCache.h"
+#include "ConnectionPool.h"
+#include "DBFunctions.h"
+#include "DBRouter.h"
+#include "Statements.h"
+
+#include <future>
+#include <mutex>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+mutex cacheMutex;
+shared_ptr<const CatalogData> currentCatalog;
+
+struct GroupResult {
+    bool ok = false;
+    vector<pair<InternedString, InternedString>> groups;    // (category, subcategory), sorted
+};
+
+struct SupplierResult {
+    bool ok = false;
+    vector<Supplier> suppliers;
+};
+
+struct ProductResult {
+    bool ok = false;
+    vector<Product> products;
+    vector<pair<int, int>> productSupplier;
+};
+
+GroupResult fetchGroups(ConnectionPool &pool) {
+    GroupResult r;
+    ConnectionPool::Lease con;
+    try {
+        con = pool.acquire();
+        sql::Statement* stmt = con->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT DISTINCT Category, Subcategory FROM PRODUCT "
+            "ORDER BY Category ASC, Subcategory ASC"
+        );
+        while (res->next())
+            r.groups.emplace_back(InternedString(res->getString(1)), InternedString(res->getString(2)));
+        delete res;
+        delete stmt;
+        r.ok = true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in catalog warm-up (categories): " << e.what() << endl;
+        con.release(true);
+    }
+    return r;
+}
+
+SupplierResult fetchSuppliers(ConnectionPool &pool) {
+    SupplierResult r;
+    ConnectionPool::Lease con;
+    try {
+        con = pool.acquire();
+        sql::Statement* stmt = con->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT SID, Sname, Contact_Num, Email, Address FROM Supplier"
+        );
+        while (res->next()) {
+            string contact = res->getString(3);
+            r.suppliers.emplace_back(res->getInt(1), res->getString(2),
+                                     strtol(contact.c_str(), nullptr, 10),
+                                     res->getString(4), res->getString(5));
+        }
+        delete res;
+        delete stmt;
+        r.ok = true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in catalog warm-up (suppliers): " << e.what() << endl;
+        con.release(true);
+    }
+    return r;
+}
+
+// Products with lo <= Product_ID <= hi
+ProductResult fetchProductRange(ConnectionPool &pool, long lo, long hi) {
+    ProductResult r;
+    ConnectionPool::Lease con;
+    try {
+        con = pool.acquire();
+        sql::PreparedStatement* pstmt =
+            sqlreg::prepare(con.get(), stmts::PRODUCT_RANGE, (int64_t)lo, (int64_t)hi);
+        sql::ResultSet* res = pstmt->executeQuery();
+
+        r.products.reserve(res->rowsCount());
+        while (res->next()) {
+            auto [id, name, category, subcategory, price, stock, company, expiry, sid] =
+                sqlreg::readRow(res, stmts::PRODUCT_RANGE);
+            r.products.emplace_back(id, std::move(name), std::move(category),
+                                    std::move(subcategory), price, stock,
+                                    std::move(company), expiry);
+            r.productSupplier.emplace_back(id, sid);
+        }
+        delete res;
+        delete pstmt;
+        r.ok = true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in catalog warm-up (products): " << e.what() << endl;
+        con.release(true);
+    }
+    return r;
+}
+
+bool productIdRange(ConnectionPool &pool, long &lo, long &hi) {
+    ConnectionPool::Lease con;
+    try {
+        con = pool.acquire();
+        sql::Statement* stmt = con->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT COALESCE(MIN(Product_ID), 0), COALESCE(MAX(Product_ID), -1) FROM PRODUCT"
+        );
+        bool ok = res->next();
+        if (ok) {
+            lo = (long)res->getInt64(1);
+            hi = (long)res->getInt64(2);
+        }
+        delete res;
+        delete stmt;
+        return ok;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in catalog warm-up (id range): " << e.what() << endl;
+        con.release(true);
+        return false;
+    }
+}
+
+void appendMetric(const WarmupStats &s) {
+    const char* env = getenv("PROJECT1_METRICS_LOG");
+    string path = (env && *env) ? env : "project1_metrics.log";
+
+    ofstream out(path, ios::app);
+    if (!out) return;
+
+    time_t now = time(nullptr);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    out << stamp << " catalog_warmup"
+        << " ms=" << (long)s.millis
+        << " products=" << s.products
+        << " suppliers=" << s.suppliers
+        << " categories=" << s.categories
+        << " connections=" << s.connections
+        << " ok=" << (s.ok ? 1 : 0) << "\n";
+}
+
+} // namespace
+
+// ---------------------------------------------
+// CatalogData lookups
+// ---------------------------------------------
+const Product* CatalogData::findProduct(int productId) const {
+    auto it = productIndex.find(productId);
+    return it == productIndex.end() ? nullptr : &products[it->second];
+}
+
+const Supplier* CatalogData::supplierFor(int productId) const {
+    auto p = productSupplier.find(productId);
+    if (p == productSupplier.end()) return nullptr;
+    auto s = suppliers.find(p->second);
+    return s == suppliers.end() ? nullptr : &s->second;
+}
+
+bool updateCatalog(const function<void(CatalogData &)> &patch) {
+    while (true) {
+        shared_ptr<const CatalogData> base = catalogCache();
+        if (!base) return false;
+
+        auto copy = make_shared<CatalogData>(*base);
+        patch(*copy);
+
+        // a warm-up or another patch published meanwhile: redo it on theirs
+        lock_guard<mutex> lock(cacheMutex);
+        if (currentCatalog != base) continue;
+        currentCatalog = std::move(copy);
+        return true;
+    }
+}
+
+int CatalogData::stockOf(const Product &p) const {
+    size_t i = (size_t)(&p - products.data());
+    if (!stock || i >= stock->size) return p.getStock();
+    return stock->qty[i].load(memory_order_relaxed);
+}
+
+void CatalogData::initStock() {
+    auto live = make_shared<LiveStock>();
+    live->size = products.size();
+    live->qty.reset(new atomic<int>[live->size]);
+    for (size_t i = 0; i < live->size; ++i)
+        live->qty[i].store(products[i].getStock(), memory_order_relaxed);
+    stock = std::move(live);
+}
+
+shared_ptr<const CatalogData> catalogCache() {
+    lock_guard<mutex> lock(cacheMutex);
+    return currentCatalog;
+}
+
+void publishCatalog(shared_ptr<const CatalogData> data) {
+    lock_guard<mutex> lock(cacheMutex);
+    currentCatalog = std::move(data);
+}
+
+void adjustCatalogStock(const vector<pair<int, int>> &sold) {
+    shared_ptr<const CatalogData> cache = catalogCache();
+    if (!cache || !cache->stock) return;
+
+    for (const auto &s : sold) {
+        auto it = cache->productIndex.find(s.first);
+        if (it == cache->productIndex.end()) continue;
+        atomic<int> &qty = cache->stock->qty[it->second];
+        int cur = qty.load(memory_order_relaxed);
+        while (!qty.compare_exchange_weak(cur, max(0, cur - s.second), memory_order_relaxed)) {}
+    }
+}
+
+void setCatalogStock(const vector<pair<int, int>> &levels) {
+    shared_ptr<const CatalogData> cache = catalogCache();
+    if (!cache || !cache->stock) return;
+
+    for (const auto &l : levels) {
+        auto it = cache->productIndex.find(l.first);
+        if (it == cache->productIndex.end()) continue;
+        cache->stock->qty[it->second].store(l.second, memory_order_relaxed);
+    }
+}
+
+// ---------------------------------------------
+// Warm-up
+// ---------------------------------------------
+WarmupStats warmCatalogCache(int connections) {
+    auto t0 = chrono::steady_clock::now();
+
+    WarmupStats stats;
+    stats.connections = max(2, connections);
+    ConnectionPool pool((size_t)stats.connections, createReadConnection);
+
+    // categories and suppliers start right away; products are split into
+    // id ranges once MIN/MAX is known
+    auto groupsTask = async(launch::async, fetchGroups, ref(pool));
+    auto suppliersTask = async(launch::async, fetchSuppliers, ref(pool));
+
+    long lo = 0, hi = -1;
+    bool rangeOk = productIdRange(pool, lo, hi);
+
+    vector<future<ProductResult>> productTasks;
+    if (rangeOk && hi >= lo) {
+        long parts = max(1, stats.connections - 2);
+        long span = (hi - lo) / parts + 1;
+        for (long a = lo; a <= hi; a += span) {
+            long b = min(hi, a + span - 1);
+            productTasks.push_back(async(launch::async, fetchProductRange, ref(pool), a, b));
+        }
+    }
+
+    GroupResult groups = groupsTask.get();
+    SupplierResult suppliers = suppliersTask.get();
+
+    auto data = make_shared<CatalogData>();
+    bool ok = rangeOk && groups.ok && suppliers.ok;
+
+    // ranges are disjoint and ascending, so products stay sorted by id
+    for (auto &t : productTasks) {
+        ProductResult r = t.get();
+        ok = ok && r.ok;
+        for (auto &p : r.products) data->products.push_back(std::move(p));
+        for (auto &ps : r.productSupplier) data->productSupplier.insert(ps);
+    }
+
+    if (!ok) {
+        stats.millis = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        appendMetric(stats);
+        return stats;
+    }
+
+    for (auto &g : groups.groups) {
+        if (g.first.empty()) continue;
+        if (data->categories.empty() || data->categories.back() != g.first)
+            data->categories.push_back(g.first);
+        auto &subs = data->subcategories[g.first];
+        if (!g.second.empty()) subs.push_back(g.second);
+    }
+
+    for (auto &s : suppliers.suppliers) data->suppliers.emplace(s.id, std::move(s));
+
+    data->productIndex.reserve(data->products.size());
+    data->expiry.reserve(data->products.size());
+    for (size_t i = 0; i < data->products.size(); ++i) {
+        const Product &p = data->products[i];
+        data->productIndex.emplace(p.getId(), i);
+        data->byGroup[{p.getCategoryKey(), p.getSubcategoryKey()}].push_back(i);
+        data->expiry.add(p.getId(), p.getExpiry());
+    }
+    data->expiry.finish();
+    data->initStock();
+
+    stats.products = data->products.size();
+    stats.suppliers = data->suppliers.size();
+    stats.categories = data->categories.size();
+    stats.ok = true;
+
+    publishCatalog(data);
+
+    stats.millis = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    appendMetric(stats);
+    return stats;
+}
+
+CatalogWarmup::CatalogWarmup(int c) : connections(c) {}
+
+CatalogWarmup::~CatalogWarmup() {
+    if (worker.joinable()) worker.join();
+}
+
+void CatalogWarmup::start() {
+    if (worker.joinable()) return;
+    worker = thread([this] { stats = warmCatalogCache(connections); });
+}
+
+const WarmupStats& CatalogWarmup::wait() {
+    if (worker.joinable()) worker.join();
+    return stats;
+}
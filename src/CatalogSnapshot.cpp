@@ -0,0 +1,571 @@
+// CatalogSnapshot.cpp
+// Build / mmap / validate the binary catalog snapshot
+
+#include "CatalogSnapshot.h"
+#include "DBFunctions.h"
+#include "DBRouter.h"
+
+#include <fstream>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <ctime>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cppconn/statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'P', '1', 'C', 'A', 'T', 'S', 'N', 'P'};
+
+struct IdIndexEntry { int32_t id; uint32_t row; };
+struct GroupEntry { uint32_t category, subcategory, start, count; };
+
+// 64-bit FNV-1a over 8-byte words (tail bytes folded in one at a time)
+uint64_t checksum64(const char* p, size_t n) {
+    uint64_t h = 1469598103934665603ULL;
+    const uint64_t prime = 1099511628211ULL;
+    size_t words = n / 8;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t w;
+        memcpy(&w, p + i * 8, 8);
+        h = (h ^ w) * prime;
+    }
+    for (size_t i = words * 8; i < n; ++i)
+        h = (h ^ (unsigned char)p[i]) * prime;
+    return h;
+}
+
+size_t align8(size_t n) { return (n + 7) & ~(size_t)7; }
+
+// A temp name no other writer uses: same directory (so rename is atomic),
+// this process's pid and a per-process counter
+string tempPathFor(const string &path) {
+    static atomic<unsigned> counter{0};
+#ifdef _WIN32
+    long pid = (long)_getpid();
+#else
+    long pid = (long)getpid();
+#endif
+    return path + ".tmp." + to_string(pid) + "." + to_string(counter++);
+}
+
+// Sorted distinct strings -> code
+class DictBuilder {
+public:
+    map<string, uint32_t> codes;
+
+    void add(const string &s) { codes.emplace(s, 0); }
+    void finish() {
+        uint32_t c = 0;
+        for (auto &kv : codes) kv.second = c++;
+    }
+    uint32_t code(const string &s) const { return codes.at(s); }
+
+    // count, offsets[count + 1], chars
+    string serialize() const {
+        string out;
+        uint32_t count = (uint32_t)codes.size();
+        vector<uint32_t> offsets{0};
+        string heap;
+        for (auto &kv : codes) {
+            heap += kv.first;
+            offsets.push_back((uint32_t)heap.size());
+        }
+        out.append((const char*)&count, sizeof(count));
+        out.append((const char*)offsets.data(), offsets.size() * sizeof(uint32_t));
+        out += heap;
+        return out;
+    }
+};
+
+struct SourceRow {
+    int id;
+    string name, category, subcategory, company, expiry, supplier;
+    Money price;
+    int stock;
+};
+
+template <typename T>
+string rawBytes(const vector<T> &v) {
+    return string((const char*)v.data(), v.size() * sizeof(T));
+}
+
+mutex activeMutex;
+shared_ptr<const CatalogSnapshot> activeSnapshot;
+
+// background writer state
+mutex writerMutex;
+condition_variable writerWake;
+thread writerThread;
+bool writerStop = false;
+
+} // namespace
+
+// ---------------------------------------------
+// CatalogSnapshot: open / close
+// ---------------------------------------------
+CatalogSnapshot::CatalogSnapshot() : base(nullptr), length(0), header(nullptr) {}
+
+CatalogSnapshot::~CatalogSnapshot() {
+    close();
+}
+
+void CatalogSnapshot::close() {
+#ifndef _WIN32
+    if (base) munmap((void*)base, length);
+#endif
+    base = nullptr;
+    length = 0;
+    header = nullptr;
+}
+
+bool CatalogSnapshot::open(const string &path) {
+    close();
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* m = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED) return false;
+
+    base = (const char*)m;
+    length = (size_t)st.st_size;
+    const SnapshotHeader* h = (const SnapshotHeader*)base;
+
+    bool ok = memcmp(h->magic, SNAPSHOT_MAGIC, 8) == 0
+           && h->version == SNAPSHOT_VERSION
+           && sizeof(SnapshotHeader) + h->payloadSize == length;
+
+    for (int s = 0; ok && s < SECTION_COUNT; ++s)
+        ok = h->sectionOffset[s] >= sizeof(SnapshotHeader)
+          && h->sectionOffset[s] + h->sectionSize[s] <= length;
+
+    if (ok)
+        ok = checksum64(base + sizeof(SnapshotHeader), h->payloadSize) == h->checksum;
+
+    if (!ok) {
+        cerr << "Catalog snapshot " << path << " is invalid or corrupt; ignoring it.\n";
+        close();
+        return false;
+    }
+
+    header = h;
+    madvise((void*)base, length, MADV_WILLNEED);
+    return true;
+#endif
+}
+
+bool CatalogSnapshot::isStale(sql::Connection* con, long maxAgeSeconds) const {
+    if (!header) return true;
+
+    long age = (long)time(nullptr) - (long)header->createdAt;
+    if (age < 0 || age > maxAgeSeconds) return true;
+
+    if (con) {
+        uint64_t fp = catalogFingerprint(con);
+        if (fp == 0 || fp != header->fingerprint) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------
+// CatalogSnapshot: lookups
+// ---------------------------------------------
+uint32_t CatalogSnapshot::dictCount(SnapshotSection dict) const {
+    return *section<uint32_t>(dict);
+}
+
+string_view CatalogSnapshot::dictString(SnapshotSection dict, uint32_t code) const {
+    const uint32_t* p = section<uint32_t>(dict);
+    uint32_t count = p[0];
+    const uint32_t* offsets = p + 1;
+    const char* heap = (const char*)(offsets + count + 1);
+    return string_view(heap + offsets[code], offsets[code + 1] - offsets[code]);
+}
+
+int CatalogSnapshot::dictFind(SnapshotSection dict, const string &value) const {
+    int lo = 0, hi = (int)dictCount(dict) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int c = dictString(dict, (uint32_t)mid).compare(value);
+        if (c == 0) return mid;
+        if (c < 0) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+SnapshotProduct CatalogSnapshot::rowAt(uint32_t row) const {
+    const uint32_t* nameOffsets = section<uint32_t>(SEC_NAME_OFFSETS);
+    const char* names = section<char>(SEC_NAME_HEAP);
+
+    SnapshotProduct p;
+    p.id = section<int32_t>(SEC_IDS)[row];
+    p.name = string_view(names + nameOffsets[row], nameOffsets[row + 1] - nameOffsets[row]);
+    p.category = dictString(SEC_DICT_CATEGORY, section<uint32_t>(SEC_CATEGORY)[row]);
+    p.subcategory = dictString(SEC_DICT_SUBCATEGORY, section<uint32_t>(SEC_SUBCATEGORY)[row]);
+    p.company = dictString(SEC_DICT_COMPANY, section<uint32_t>(SEC_COMPANY)[row]);
+    p.expiry = Date::fromDays(section<int32_t>(SEC_EXPIRY)[row]);
+    p.supplier = dictString(SEC_DICT_SUPPLIER, section<uint32_t>(SEC_SUPPLIER)[row]);
+    p.price = Money::fromPaise(section<int64_t>(SEC_PRICE)[row]);
+    p.stock = section<int32_t>(SEC_STOCK)[row];
+    return p;
+}
+
+vector<string> CatalogSnapshot::categories() const {
+    vector<string> out;
+    if (!header) return out;
+    uint32_t n = dictCount(SEC_DICT_CATEGORY);
+    for (uint32_t c = 0; c < n; ++c) {
+        string_view s = dictString(SEC_DICT_CATEGORY, c);
+        if (!s.empty()) out.emplace_back(s);
+    }
+    return out;
+}
+
+vector<string> CatalogSnapshot::subcategories(const string &category) const {
+    vector<string> out;
+    if (!header) return out;
+
+    int cat = dictFind(SEC_DICT_CATEGORY, category);
+    if (cat < 0) return out;
+
+    // groups are sorted by (category, subcategory) and subcategory codes follow
+    // the sorted dictionary, so this comes out in alphabetical order
+    const GroupEntry* g = section<GroupEntry>(SEC_GROUPS);
+    size_t n = header->sectionSize[SEC_GROUPS] / sizeof(GroupEntry);
+    const GroupEntry* it = lower_bound(g, g + n, (uint32_t)cat,
+        [](const GroupEntry &e, uint32_t c) { return e.category < c; });
+
+    for (; it != g + n && it->category == (uint32_t)cat; ++it) {
+        string_view s = dictString(SEC_DICT_SUBCATEGORY, it->subcategory);
+        if (!s.empty()) out.emplace_back(s);
+    }
+    return out;
+}
+
+vector<SnapshotProduct> CatalogSnapshot::productsIn(const string &category,
+                                                    const string &subcategory) const {
+    vector<SnapshotProduct> out;
+    if (!header) return out;
+
+    int cat = dictFind(SEC_DICT_CATEGORY, category);
+    int sub = dictFind(SEC_DICT_SUBCATEGORY, subcategory);
+    if (cat < 0 || sub < 0) return out;
+
+    const GroupEntry* g = section<GroupEntry>(SEC_GROUPS);
+    size_t n = header->sectionSize[SEC_GROUPS] / sizeof(GroupEntry);
+    GroupEntry key{(uint32_t)cat, (uint32_t)sub, 0, 0};
+    const GroupEntry* it = lower_bound(g, g + n, key,
+        [](const GroupEntry &a, const GroupEntry &b) {
+            return a.category != b.category ? a.category < b.category
+                                            : a.subcategory < b.subcategory;
+        });
+    if (it == g + n || it->category != key.category || it->subcategory != key.subcategory)
+        return out;
+
+    out.reserve(it->count);
+    for (uint32_t r = it->start; r < it->start + it->count; ++r)
+        out.push_back(rowAt(r));
+    return out;
+}
+
+bool CatalogSnapshot::findProduct(int productId, SnapshotProduct &out) const {
+    if (!header) return false;
+
+    const IdIndexEntry* idx = section<IdIndexEntry>(SEC_ID_INDEX);
+    size_t n = header->productCount;
+    const IdIndexEntry* it = lower_bound(idx, idx + n, productId,
+        [](const IdIndexEntry &e, int id) { return e.id < id; });
+    if (it == idx + n || it->id != productId) return false;
+
+    out = rowAt(it->row);
+    return true;
+}
+
+// ---------------------------------------------
+// Fingerprint + writer
+// ---------------------------------------------
+uint64_t catalogFingerprint(sql::Connection* con) {
+    if (!con) return 0;
+    sql::Statement* stmt = nullptr;
+    sql::ResultSet* res = nullptr;
+    uint64_t fp = 0;
+
+    try {
+        stmt = con->createStatement();
+        res = stmt->executeQuery(
+            "SELECT COUNT(*), COALESCE(MAX(Product_ID), 0), COALESCE(SUM(Stock_Qtn), 0), "
+            "       COALESCE(SUM(Price), 0), "
+            "       COALESCE(SUM(CRC32(CONCAT_WS('|', Product_ID, Product_Name, Category, "
+            "                Subcategory, Company_name, ExpiryDate, SID))), 0) "
+            "FROM PRODUCT"
+        );
+        if (res->next()) {
+            string key;
+            for (int c = 1; c <= 5; ++c) {
+                key += res->getString(c);
+                key += '|';
+            }
+            fp = checksum64(key.data(), key.size());
+            if (fp == 0) fp = 1;
+        }
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in catalogFingerprint: " << e.what() << endl;
+    }
+
+    if (res) delete res;
+    if (stmt) delete stmt;
+    return fp;
+}
+
+bool writeCatalogSnapshot(sql::Connection* con, const string &path) {
+    if (!con) return false;
+
+    uint64_t fingerprint = catalogFingerprint(con);
+    if (fingerprint == 0) return false;
+
+    // 1) read the catalog
+    vector<SourceRow> rows;
+    sql::Statement* stmt = nullptr;
+    sql::ResultSet* res = nullptr;
+    try {
+        stmt = con->createStatement();
+        res = stmt->executeQuery(
+            "SELECT p.Product_ID, p.Product_Name, p.Category, p.Subcategory, p.Price, "
+            "       p.Stock_Qtn, p.Company_name, p.ExpiryDate, s.Sname "
+            "FROM PRODUCT p LEFT JOIN Supplier s ON p.SID = s.SID"
+        );
+        rows.reserve(res->rowsCount());
+        while (res->next()) {
+            SourceRow r;
+            r.id = res->getInt(1);
+            r.name = res->getString(2);
+            r.category = res->getString(3);
+            r.subcategory = res->getString(4);
+            r.price = Money::fromSQL(res->getString(5));
+            r.stock = res->getInt(6);
+            r.company = res->getString(7);
+            r.expiry = res->getString(8);
+            r.supplier = res->getString(9);
+            rows.push_back(std::move(r));
+        }
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in writeCatalogSnapshot: " << e.what() << endl;
+        if (res) delete res;
+        if (stmt) delete stmt;
+        return false;
+    }
+    delete res;
+    delete stmt;
+
+    // 2) dictionaries
+    DictBuilder dCat, dSub, dComp, dSup;
+    for (auto &r : rows) {
+        dCat.add(r.category); dSub.add(r.subcategory); dComp.add(r.company);
+        dSup.add(r.supplier);
+    }
+    dCat.finish(); dSub.finish(); dComp.finish(); dSup.finish();
+
+    // 3) order rows by (category, subcategory, id) so each browse list is a range
+    size_t n = rows.size();
+    vector<uint32_t> cat(n), sub(n);
+    for (size_t i = 0; i < n; ++i) {
+        cat[i] = dCat.code(rows[i].category);
+        sub[i] = dSub.code(rows[i].subcategory);
+    }
+    vector<uint32_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = (uint32_t)i;
+    sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (cat[a] != cat[b]) return cat[a] < cat[b];
+        if (sub[a] != sub[b]) return sub[a] < sub[b];
+        return rows[a].id < rows[b].id;
+    });
+
+    // 4) columns
+    vector<int32_t> ids(n), stock(n), expiry(n);
+    vector<int64_t> price(n);
+    vector<uint32_t> cCat(n), cSub(n), cComp(n), cSup(n), nameOffsets{0};
+    string nameHeap;
+    vector<GroupEntry> groups;
+    vector<IdIndexEntry> idIndex(n);
+
+    for (size_t r = 0; r < n; ++r) {
+        const SourceRow &src = rows[order[r]];
+        ids[r] = src.id;
+        stock[r] = src.stock;
+        price[r] = src.price.toPaise();
+        cCat[r] = cat[order[r]];
+        cSub[r] = sub[order[r]];
+        cComp[r] = dComp.code(src.company);
+        expiry[r] = Date::fromSQL(src.expiry).toDays();
+        cSup[r] = dSup.code(src.supplier);
+        nameHeap += src.name;
+        nameOffsets.push_back((uint32_t)nameHeap.size());
+        idIndex[r] = {src.id, (uint32_t)r};
+
+        if (groups.empty() || groups.back().category != cCat[r] || groups.back().subcategory != cSub[r])
+            groups.push_back({cCat[r], cSub[r], (uint32_t)r, 0});
+        groups.back().count++;
+    }
+    sort(idIndex.begin(), idIndex.end(),
+         [](const IdIndexEntry &a, const IdIndexEntry &b) { return a.id < b.id; });
+
+    // 5) lay out sections
+    string sections[SECTION_COUNT];
+    sections[SEC_IDS] = rawBytes(ids);
+    sections[SEC_PRICE] = rawBytes(price);
+    sections[SEC_STOCK] = rawBytes(stock);
+    sections[SEC_NAME_OFFSETS] = rawBytes(nameOffsets);
+    sections[SEC_NAME_HEAP] = nameHeap;
+    sections[SEC_CATEGORY] = rawBytes(cCat);
+    sections[SEC_SUBCATEGORY] = rawBytes(cSub);
+    sections[SEC_COMPANY] = rawBytes(cComp);
+    sections[SEC_EXPIRY] = rawBytes(expiry);
+    sections[SEC_SUPPLIER] = rawBytes(cSup);
+    sections[SEC_DICT_CATEGORY] = dCat.serialize();
+    sections[SEC_DICT_SUBCATEGORY] = dSub.serialize();
+    sections[SEC_DICT_COMPANY] = dComp.serialize();
+    sections[SEC_DICT_SUPPLIER] = dSup.serialize();
+    sections[SEC_ID_INDEX] = rawBytes(idIndex);
+    sections[SEC_GROUPS] = rawBytes(groups);
+
+    SnapshotHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SNAPSHOT_MAGIC, 8);
+    h.version = SNAPSHOT_VERSION;
+    h.productCount = (uint32_t)n;
+    h.createdAt = (uint64_t)time(nullptr);
+    h.fingerprint = fingerprint;
+
+    string payload;
+    size_t offset = sizeof(SnapshotHeader);
+    for (int s = 0; s < SECTION_COUNT; ++s) {
+        h.sectionOffset[s] = offset;
+        h.sectionSize[s] = sections[s].size();
+        payload += sections[s];
+        size_t padded = align8(sections[s].size());
+        payload.append(padded - sections[s].size(), '\0');
+        offset += padded;
+    }
+    h.payloadSize = payload.size();
+    h.checksum = checksum64(payload.data(), payload.size());
+
+    // 6) write to a temp file of our own and rename over the old snapshot;
+    //    processes that still have the old file mapped keep reading it safely
+    string tmp = tempPathFor(path);
+    {
+        ofstream out(tmp, ios::binary | ios::trunc);
+        if (!out) {
+            cerr << "Cannot write catalog snapshot: " << tmp << endl;
+            return false;
+        }
+        out.write((const char*)&h, sizeof(h));
+        out.write(payload.data(), (streamsize)payload.size());
+        out.close();
+        if (!out) {
+            cerr << "Failed writing catalog snapshot: " << tmp << endl;
+            remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        cerr << "Cannot replace catalog snapshot: " << path << endl;
+        remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------
+// Background writer
+// ---------------------------------------------
+void startSnapshotWriter(const string &path, int intervalSeconds) {
+    lock_guard<mutex> lock(writerMutex);
+    if (writerThread.joinable()) return;
+    writerStop = false;
+
+    writerThread = thread([path, intervalSeconds] {
+        sql::Connection* con = nullptr;
+
+        while (true) {
+            try {
+                if (!con) con = createReadConnection();
+
+                uint64_t current = catalogFingerprint(con);
+                shared_ptr<const CatalogSnapshot> active = activeCatalogSnapshot();
+
+                if (current != 0 && (!active || active->fingerprint() != current)) {
+                    if (writeCatalogSnapshot(con, path)) {
+                        auto fresh = make_shared<CatalogSnapshot>();
+                        if (fresh->open(path)) setActiveCatalogSnapshot(fresh);
+                    }
+                }
+            } catch (sql::SQLException &e) {
+                cerr << "Snapshot writer: " << e.what() << endl;
+                if (con) { delete con; con = nullptr; }
+            }
+
+            unique_lock<mutex> lock(writerMutex);
+            if (writerWake.wait_for(lock, chrono::seconds(intervalSeconds),
+                                    [] { return writerStop; }))
+                break;
+        }
+
+        if (con) { con->close(); delete con; }
+    });
+}
+
+void stopSnapshotWriter() {
+    {
+        lock_guard<mutex> lock(writerMutex);
+        if (!writerThread.joinable()) return;
+        writerStop = true;
+    }
+    writerWake.notify_all();
+    writerThread.join();
+}
+
+string defaultSnapshotPath() {
+    const char* env = getenv("PROJECT1_CATALOG_SNAPSHOT");
+    return (env && *env) ? string(env) : string("catalog.snap");
+}
+
+shared_ptr<const CatalogSnapshot> activeCatalogSnapshot() {
+    lock_guard<mutex> lock(activeMutex);
+    return activeSnapshot;
+}
+
+void setActiveCatalogSnapshot(shared_ptr<const CatalogSnapshot> snap) {
+    lock_guard<mutex> lock(activeMutex);
+    activeSnapshot = std::move(snap);
+}
@@ -0,0 +1,408 @@
+// ChangeFeed.cpp
+// Trigger-fed change log and the consumer that keeps the caches current
+
+#include "ChangeFeed.h"
+#include "CatalogCache.h"
+#include "QueryCache.h"
+#include "ProductPrefetch.h"
+#include "DBRouter.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <map>
+#include <set>
+#include <iostream>
+
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+const size_t POLL_LIMIT = 5000;         // events per query
+const int GAP_WAIT_SECONDS = 10;        // how long a skipped Seq may still commit
+const size_t MAX_GAPS = 1000;
+const size_t PATCH_MAX = 2000;          // larger stock/price batches re-warm instead
+const int ER_NO_SUCH_TABLE = 1146;
+
+const char* CHANGE_LOG_DDL =
+    "CREATE TABLE IF NOT EXISTS CHANGE_LOG ("
+    "  Seq BIGINT AUTO_INCREMENT PRIMARY KEY,"
+    "  TableName VARCHAR(16) NOT NULL,"
+    "  Op CHAR(1) NOT NULL,"
+    "  RowKey INT NOT NULL,"
+    "  ChangedAt TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,"
+    "  INDEX idx_change_log_time (ChangedAt)"
+    ")";
+
+// PRODUCT updates that touch nothing but Stock_Qtn / Price are logged as
+// 'Q': the catalog can patch those in place instead of re-warming.
+const char* PRODUCT_UPDATE_OP =
+    "IF(NEW.Product_ID = OLD.Product_ID"
+    " AND NEW.Product_Name <=> OLD.Product_Name"
+    " AND NEW.Category <=> OLD.Category"
+    " AND NEW.Subcategory <=> OLD.Subcategory"
+    " AND NEW.Company_name <=> OLD.Company_name"
+    " AND NEW.ExpiryDate <=> OLD.ExpiryDate"
+    " AND NEW.SID <=> OLD.SID, 'Q', 'U')";
+
+struct TriggerSpec {
+    const char* name;
+    const char* event;
+    const char* table;
+    string op;              // SQL expression
+    const char* key;        // NEW./OLD. column
+};
+
+vector<TriggerSpec> triggerSpecs() {
+    return {
+        {"trg_cl_product_ins", "INSERT", "PRODUCT", "'I'", "NEW.Product_ID"},
+        {"trg_cl_product_upd", "UPDATE", "PRODUCT", PRODUCT_UPDATE_OP, "NEW.Product_ID"},
+        {"trg_cl_product_del", "DELETE", "PRODUCT", "'D'", "OLD.Product_ID"},
+        {"trg_cl_supplier_ins", "INSERT", "Supplier", "'I'", "NEW.SID"},
+        {"trg_cl_supplier_upd", "UPDATE", "Supplier", "'U'", "NEW.SID"},
+        {"trg_cl_supplier_del", "DELETE", "Supplier", "'D'", "OLD.SID"},
+    };
+}
+
+// Triggers earlier versions installed; install and uninstall drop them
+const char* RETIRED_TRIGGERS[] = {"trg_cl_cart_ins", "trg_cl_cart_upd", "trg_cl_cart_del"};
+
+// ---- consumer state ----
+mutex feedMutex;
+condition_variable feedWake;
+bool feedStop = false;
+thread feedThread;
+int rewarmConnections = 4;
+
+// catalog work found while the cache was not published yet (or that needs
+// a connection); done on the consumer's next pass
+mutex catalogWorkMutex;
+set<int> pendingPatch;
+bool pendingRewarm = false;
+
+// Re-read stock and price of `ids`. Stock is set in place; a catalog copy
+// is published only when a price changed.
+void patchCatalog(sql::Connection* con, const set<int> &ids) {
+    string sql = "SELECT Product_ID, Price, Stock_Qtn FROM PRODUCT WHERE Product_ID IN (";
+    for (size_t i = 0; i < ids.size(); ++i) sql += i ? ", ?" : "?";
+    sql += ")";
+
+    vector<pair<int, int>> levels;
+    vector<pair<int, Money>> prices;
+
+    sql::PreparedStatement* pstmt = con->prepareStatement(sql);
+    sql::ResultSet* res = nullptr;
+    try {
+        unsigned int idx = 1;
+        for (int id : ids) pstmt->setInt(idx++, id);
+        res = pstmt->executeQuery();
+        while (res->next()) {
+            int id = res->getInt(1);
+            Money price;
+            if (Money::parseSQL(res->getString(2), price)) prices.push_back({id, price});
+            levels.push_back({id, res->getInt(3)});
+        }
+    } catch (...) {
+        delete res;
+        delete pstmt;
+        throw;
+    }
+    delete res;
+    delete pstmt;
+
+    setCatalogStock(levels);
+
+    shared_ptr<const CatalogData> cache = catalogCache();
+    if (!cache) return;
+    bool repriced = false;
+    for (const auto &pr : prices) {
+        const Product* p = cache->findProduct(pr.first);
+        if (p && p->getPrice() != pr.second) repriced = true;
+    }
+    if (!repriced) return;
+
+    updateCatalog([&](CatalogData &copy) {
+        for (const auto &pr : prices) {
+            auto it = copy.productIndex.find(pr.first);
+            if (it != copy.productIndex.end()) copy.products[it->second].setPrice(pr.second);
+        }
+    });
+}
+
+void flushCatalogWork(sql::Connection* con) {
+    shared_ptr<const CatalogData> cache = catalogCache();
+    if (!cache) return;     // still warming: keep the work for later
+
+    set<int> patch;
+    bool rewarm;
+    {
+        lock_guard<mutex> lock(catalogWorkMutex);
+        patch.swap(pendingPatch);
+        rewarm = pendingRewarm || patch.size() > PATCH_MAX;
+        pendingRewarm = false;
+    }
+
+    if (rewarm) {
+        WarmupStats s = warmCatalogCache(rewarmConnections);
+        if (!s.ok) {
+            lock_guard<mutex> lock(catalogWorkMutex);
+            pendingRewarm = true;
+        }
+        return;
+    }
+    if (patch.empty()) return;
+
+    try {
+        patchCatalog(con, patch);
+    } catch (sql::SQLException &) {
+        lock_guard<mutex> lock(catalogWorkMutex);
+        pendingPatch.insert(patch.begin(), patch.end());
+        throw;
+    }
+}
+
+int64_t currentEnd(sql::Connection* con) {
+    sql::Statement* stmt = con->createStatement();
+    sql::ResultSet* res = nullptr;
+    int64_t seq = 0;
+    try {
+        res = stmt->executeQuery("SELECT COALESCE(MAX(Seq), 0) FROM CHANGE_LOG");
+        if (res->next()) seq = res->getInt64(1);
+    } catch (...) {
+        delete res;
+        delete stmt;
+        throw;
+    }
+    delete res;
+    delete stmt;
+    return seq;
+}
+
+void feedLoop(int64_t fromSeq, int intervalMs) {
+    sql::Connection* con = nullptr;
+    int64_t lastSeq = fromSeq;                              // -1: not positioned yet
+    map<int64_t, chrono::steady_clock::time_point> gaps;    // skipped Seq -> first noticed
+
+    while (true) {
+        bool more = false;
+        try {
+            if (!con) con = createReadConnection();
+            if (lastSeq < 0) lastSeq = currentEnd(con);
+
+            // Seqs are handed out at insert but rows appear at commit, so a
+            // lower Seq can show up after a higher one: keep asking for the
+            // skipped ones for a while (rolled-back inserts never appear).
+            auto now = chrono::steady_clock::now();
+            for (auto it = gaps.begin(); it != gaps.end();) {
+                if (now - it->second > chrono::seconds(GAP_WAIT_SECONDS)) it = gaps.erase(it);
+                else ++it;
+            }
+            vector<int64_t> gapSeqs;
+            for (auto &g : gaps) gapSeqs.push_back(g.first);
+
+            vector<ChangeEvent> events;
+            readChanges(con, lastSeq, gapSeqs, POLL_LIMIT, events);
+
+            for (const ChangeEvent &e : events) {
+                if (e.seq <= lastSeq) {
+                    gaps.erase(e.seq);
+                    continue;
+                }
+                for (int64_t s = lastSeq + 1; s < e.seq && gaps.size() < MAX_GAPS; ++s)
+                    gaps.emplace(s, now);
+                lastSeq = e.seq;
+            }
+            applyChanges(events);
+            more = events.size() == POLL_LIMIT;
+
+            flushCatalogWork(con);
+        } catch (sql::SQLException &e) {
+            if (e.getErrorCode() == ER_NO_SUCH_TABLE) {
+                cerr << "Change feed off: CHANGE_LOG not found (change_feed --install creates it)." << endl;
+                break;
+            }
+            cerr << "Change feed: " << e.what() << endl;
+            if (con) { delete con; con = nullptr; }
+        }
+
+        unique_lock<mutex> lock(feedMutex);
+        if (more && !feedStop) continue;
+        if (feedWake.wait_for(lock, chrono::milliseconds(intervalMs), [] { return feedStop; }))
+            break;
+    }
+
+    if (con) { con->close(); delete con; }
+}
+
+bool runStatements(sql::Connection* con, const vector<string> &statements, const char* what) {
+    sql::Statement* stmt = nullptr;
+    try {
+        stmt = con->createStatement();
+        for (const string &s : statements) stmt->execute(s);
+        delete stmt;
+        return true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in " << what << ": " << e.what() << endl;
+        delete stmt;
+        return false;
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------
+// Setup
+// ---------------------------------------------
+bool installChangeFeed(sql::Connection* con) {
+    vector<string> statements = { CHANGE_LOG_DDL };
+    for (const char* name : RETIRED_TRIGGERS)
+        statements.push_back(string("DROP TRIGGER IF EXISTS ") + name);
+    for (const TriggerSpec &t : triggerSpecs()) {
+        statements.push_back(string("DROP TRIGGER IF EXISTS ") + t.name);
+        statements.push_back(string("CREATE TRIGGER ") + t.name + " AFTER " + t.event + " ON " + t.table +
+                             " FOR EACH ROW INSERT INTO CHANGE_LOG (TableName, Op, RowKey) VALUES ('" +
+                             t.table + "', " + t.op + ", " + t.key + ")");
+    }
+    return runStatements(con, statements, "installChangeFeed");
+}
+
+bool uninstallChangeFeed(sql::Connection* con) {
+    vector<string> statements;
+    for (const char* name : RETIRED_TRIGGERS)
+        statements.push_back(string("DROP TRIGGER IF EXISTS ") + name);
+    for (const TriggerSpec &t : triggerSpecs())
+        statements.push_back(string("DROP TRIGGER IF EXISTS ") + t.name);
+    return runStatements(con, statements, "uninstallChangeFeed");
+}
+
+long pruneChangeLog(sql::Connection* con, int hours) {
+    try {
+        sql::PreparedStatement* pstmt = con->prepareStatement(
+            "DELETE FROM CHANGE_LOG WHERE ChangedAt < NOW() - INTERVAL ? HOUR"
+        );
+        pstmt->setInt(1, hours);
+        long rows = pstmt->executeUpdate();
+        delete pstmt;
+        return rows;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in pruneChangeLog: " << e.what() << endl;
+        return -1;
+    }
+}
+
+// ---------------------------------------------
+// Reading and applying
+// ---------------------------------------------
+void readChanges(sql::Connection* con, int64_t afterSeq, const vector<int64_t> &gapSeqs,
+                 size_t limit, vector<ChangeEvent> &out) {
+    out.clear();
+
+    string sql = "SELECT Seq, TableName, Op, RowKey FROM CHANGE_LOG WHERE Seq > ?";
+    if (!gapSeqs.empty()) {
+        sql += " OR Seq IN (";
+        for (size_t i = 0; i < gapSeqs.size(); ++i) sql += i ? ", ?" : "?";
+        sql += ")";
+    }
+    sql += " ORDER BY Seq LIMIT ?";
+
+    sql::PreparedStatement* pstmt = nullptr;
+    sql::ResultSet* res = nullptr;
+    try {
+        pstmt = con->prepareStatement(sql);
+        unsigned int idx = 1;
+        pstmt->setInt64(idx++, afterSeq);
+        for (int64_t s : gapSeqs) pstmt->setInt64(idx++, s);
+        pstmt->setInt(idx, (int)limit);
+
+        res = pstmt->executeQuery();
+        out.reserve(res->rowsCount());
+        while (res->next()) {
+            string op = res->getString(3);
+            out.push_back({res->getInt64(1), res->getString(2), op.empty() ? 'U' : op[0], res->getInt(4)});
+        }
+    } catch (...) {
+        delete res;
+        delete pstmt;
+        throw;
+    }
+
+    delete res;
+    delete pstmt;
+}
+
+void applyChanges(const vector<ChangeEvent> &events) {
+    bool productRows = false;       // insert/delete or descriptive update
+    bool productQuick = false;      // stock/price only
+    bool suppliers = false;
+    set<int> quickIds;
+
+    for (const ChangeEvent &e : events) {
+        if (e.table == "PRODUCT") {
+            forgetPrefetchedDetails(e.rowKey);
+            if (e.op == 'Q') {
+                productQuick = true;
+                quickIds.insert(e.rowKey);
+            } else {
+                productRows = true;
+            }
+        } else if (e.table == "Supplier") {
+            suppliers = true;
+        }
+    }
+
+    if (productRows) {
+        invalidateProductResults();
+    } else if (productQuick) {
+        // 'Q' is a stock or price change; the log does not say which
+        invalidateStockResults();
+        invalidatePriceResults();
+    }
+    if (suppliers) clearPrefetchedDetails();
+
+    lock_guard<mutex> lock(catalogWorkMutex);
+    if (productRows || suppliers) {
+        pendingRewarm = true;
+        pendingPatch.clear();
+    } else if (!pendingRewarm) {
+        pendingPatch.insert(quickIds.begin(), quickIds.end());
+        if (pendingPatch.size() > PATCH_MAX) {
+            pendingRewarm = true;
+            pendingPatch.clear();
+        }
+    }
+}
+
+// ---------------------------------------------
+// Background consumer
+// ---------------------------------------------
+int64_t changeLogPosition(sql::Connection* con) {
+    try {
+        return currentEnd(con);
+    } catch (sql::SQLException &) {
+        return -1;
+    }
+}
+
+void startChangeFeed(int64_t fromSeq, int intervalMs, int warmConnections) {
+    lock_guard<mutex> lock(feedMutex);
+    if (feedThread.joinable()) return;
+    feedStop = false;
+    rewarmConnections = warmConnections;
+    feedThread = thread(feedLoop, fromSeq, intervalMs);
+}
+
+void stopChangeFeed() {
+    {
+        lock_guard<mutex> lock(feedMutex);
+        if (!feedThread.joinable()) return;
+        feedStop = true;
+    }
+    feedWake.notify_one();
+    feedThread.join();
+}
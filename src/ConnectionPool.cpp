@@ -0,0 +1,74 @@
+// ConnectionPool.cpp
+#include "ConnectionPool.h"
+#include <cppconn/exception.h>
+
+using namespace std;
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease &&o) noexcept {
+    if (this != &o) {
+        release();
+        pool = o.pool;
+        con = o.con;
+        o.pool = nullptr;
+        o.con = nullptr;
+    }
+    return *this;
+}
+
+void ConnectionPool::Lease::release(bool broken) {
+    if (pool && con) pool->giveBack(con, broken);
+    pool = nullptr;
+    con = nullptr;
+}
+
+ConnectionPool::ConnectionPool(size_t size, Factory f)
+    : maxSize(size == 0 ? 1 : size), factory(std::move(f)), opened(0) {}
+
+ConnectionPool::~ConnectionPool() {
+    lock_guard<mutex> lock(mtx);
+    for (auto* con : idle) {
+        try { con->close(); } catch (sql::SQLException &) {}
+        delete con;
+    }
+    idle.clear();
+}
+
+ConnectionPool::Lease ConnectionPool::acquire() {
+    unique_lock<mutex> lock(mtx);
+    available.wait(lock, [this] { return !idle.empty() || opened < maxSize; });
+
+    if (!idle.empty()) {
+        sql::Connection* con = idle.back();
+        idle.pop_back();
+        return Lease(this, con);
+    }
+
+    // open a new one outside the lock; reserve the slot first
+    opened++;
+    lock.unlock();
+    try {
+        return Lease(this, factory());
+    } catch (...) {
+        lock.lock();
+        opened--;
+        available.notify_one();
+        throw;
+    }
+}
+
+void ConnectionPool::giveBack(sql::Connection* con, bool broken) {
+    {
+        lock_guard<mutex> lock(mtx);
+        if (broken) {
+            opened--;
+        } else {
+            idle.push_back(con);
+            con = nullptr;
+        }
+    }
+    if (con) {
+        try { con->close(); } catch (sql::SQLException &) {}
+        delete con;
+    }
+    available.notify_one();
+}
@@ -0,0 +1,249 @@
+// Crypto.cpp
+// SHA-256 (FIPS 180-4), HMAC-SHA256 (RFC 2104), PBKDF2 and scrypt (RFC 7914)
+
+#include "Crypto.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+void compress(uint32_t h[8], const unsigned char block[64]) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i)
+        w[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16
+             | (uint32_t)block[i * 4 + 2] << 8 | (uint32_t)block[i * 4 + 3];
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t S1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = hh + S1 + ch + K[i] + w[i];
+        uint32_t S0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = S0 + maj;
+        hh = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+
+// ---- scrypt building blocks ----
+inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+void salsa20_8(uint32_t B[16]) {
+    uint32_t x[16];
+    memcpy(x, B, sizeof(x));
+    for (int i = 0; i < 8; i += 2) {
+        x[ 4] ^= rotl(x[ 0] + x[12],  7);  x[ 8] ^= rotl(x[ 4] + x[ 0],  9);
+        x[12] ^= rotl(x[ 8] + x[ 4], 13);  x[ 0] ^= rotl(x[12] + x[ 8], 18);
+        x[ 9] ^= rotl(x[ 5] + x[ 1],  7);  x[13] ^= rotl(x[ 9] + x[ 5],  9);
+        x[ 1] ^= rotl(x[13] + x[ 9], 13);  x[ 5] ^= rotl(x[ 1] + x[13], 18);
+        x[14] ^= rotl(x[10] + x[ 6],  7);  x[ 2] ^= rotl(x[14] + x[10],  9);
+        x[ 6] ^= rotl(x[ 2] + x[14], 13);  x[10] ^= rotl(x[ 6] + x[ 2], 18);
+        x[ 3] ^= rotl(x[15] + x[11],  7);  x[ 7] ^= rotl(x[ 3] + x[15],  9);
+        x[11] ^= rotl(x[ 7] + x[ 3], 13);  x[15] ^= rotl(x[11] + x[ 7], 18);
+        x[ 1] ^= rotl(x[ 0] + x[ 3],  7);  x[ 2] ^= rotl(x[ 1] + x[ 0],  9);
+        x[ 3] ^= rotl(x[ 2] + x[ 1], 13);  x[ 0] ^= rotl(x[ 3] + x[ 2], 18);
+        x[ 6] ^= rotl(x[ 5] + x[ 4],  7);  x[ 7] ^= rotl(x[ 6] + x[ 5],  9);
+        x[ 4] ^= rotl(x[ 7] + x[ 6], 13);  x[ 5] ^= rotl(x[ 4] + x[ 7], 18);
+        x[11] ^= rotl(x[10] + x[ 9],  7);  x[ 8] ^= rotl(x[11] + x[10],  9);
+        x[ 9] ^= rotl(x[ 8] + x[11], 13);  x[10] ^= rotl(x[ 9] + x[ 8], 18);
+        x[12] ^= rotl(x[15] + x[14],  7);  x[13] ^= rotl(x[12] + x[15],  9);
+        x[14] ^= rotl(x[13] + x[12], 13);  x[15] ^= rotl(x[14] + x[13], 18);
+    }
+    for (int i = 0; i < 16; ++i) B[i] += x[i];
+}
+
+// B and Y are 32 * r words
+void blockMix(uint32_t* B, uint32_t* Y, unsigned r) {
+    uint32_t X[16];
+    memcpy(X, &B[(2 * r - 1) * 16], 64);
+    for (unsigned i = 0; i < 2 * r; ++i) {
+        for (int k = 0; k < 16; ++k) X[k] ^= B[i * 16 + k];
+        salsa20_8(X);
+        // even blocks to the first half, odd blocks to the second
+        memcpy(&Y[((i & 1) * r + i / 2) * 16], X, 64);
+    }
+    memcpy(B, Y, 128 * r);
+}
+
+void roMix(uint32_t* B, unsigned r, uint64_t N, uint32_t* V, uint32_t* Y) {
+    size_t words = 32 * r;
+    for (uint64_t i = 0; i < N; ++i) {
+        memcpy(&V[i * words], B, words * 4);
+        blockMix(B, Y, r);
+    }
+    for (uint64_t i = 0; i < N; ++i) {
+        uint64_t j = B[(2 * r - 1) * 16] & (N - 1);    // Integerify (low 32 bits suffice, N < 2^32)
+        for (size_t k = 0; k < words; ++k) B[k] ^= V[j * words + k];
+        blockMix(B, Y, r);
+    }
+}
+
+} // namespace
+
+string sha256(const string &data) {
+    uint32_t h[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    const unsigned char* p = (const unsigned char*)data.data();
+    size_t n = data.size();
+    size_t full = n / 64;
+    for (size_t i = 0; i < full; ++i) compress(h, p + i * 64);
+
+    // padding: 0x80, zeros, 64-bit big-endian bit length
+    unsigned char tail[128];
+    size_t rem = n - full * 64;
+    memcpy(tail, p + full * 64, rem);
+    tail[rem] = 0x80;
+    size_t tailLen = (rem < 56) ? 64 : 128;
+    memset(tail + rem + 1, 0, tailLen - rem - 1);
+    uint64_t bits = (uint64_t)n * 8;
+    for (int i = 0; i < 8; ++i)
+        tail[tailLen - 1 - i] = (unsigned char)(bits >> (8 * i));
+    compress(h, tail);
+    if (tailLen == 128) compress(h, tail + 64);
+
+    string out(32, '\0');
+    for (int i = 0; i < 8; ++i) {
+        out[i * 4] = (char)(h[i] >> 24);
+        out[i * 4 + 1] = (char)(h[i] >> 16);
+        out[i * 4 + 2] = (char)(h[i] >> 8);
+        out[i * 4 + 3] = (char)h[i];
+    }
+    return out;
+}
+
+string hmacSha256(const string &key, const string &msg) {
+    string k = key.size() > 64 ? sha256(key) : key;
+    k.resize(64, '\0');
+
+    string ipad(64, '\0'), opad(64, '\0');
+    for (int i = 0; i < 64; ++i) {
+        ipad[i] = (char)(k[i] ^ 0x36);
+        opad[i] = (char)(k[i] ^ 0x5c);
+    }
+    return sha256(opad + sha256(ipad + msg));
+}
+
+string pbkdf2Sha256(const string &password, const string &salt,
+                    unsigned iterations, size_t dkLen) {
+    string out;
+    out.reserve(dkLen + 32);
+    for (uint32_t block = 1; out.size() < dkLen; ++block) {
+        string idx(4, '\0');
+        idx[0] = (char)(block >> 24); idx[1] = (char)(block >> 16);
+        idx[2] = (char)(block >> 8);  idx[3] = (char)block;
+
+        string u = hmacSha256(password, salt + idx);
+        string t = u;
+        for (unsigned i = 1; i < iterations; ++i) {
+            u = hmacSha256(password, u);
+            for (size_t k = 0; k < t.size(); ++k) t[k] ^= u[k];
+        }
+        out += t;
+    }
+    out.resize(dkLen);
+    return out;
+}
+
+string scrypt(const string &password, const string &salt,
+              uint64_t N, unsigned r, unsigned p, size_t dkLen) {
+    size_t blockBytes = 128 * (size_t)r;
+    string B = pbkdf2Sha256(password, salt, 1, blockBytes * p);
+
+    size_t words = 32 * r;
+    vector<uint32_t> X(words), Y(words), V(words * N);
+
+    for (unsigned i = 0; i < p; ++i) {
+        const unsigned char* src = (const unsigned char*)&B[i * blockBytes];
+        for (size_t k = 0; k < words; ++k)
+            X[k] = (uint32_t)src[k * 4] | (uint32_t)src[k * 4 + 1] << 8
+                 | (uint32_t)src[k * 4 + 2] << 16 | (uint32_t)src[k * 4 + 3] << 24;
+
+        roMix(X.data(), r, N, V.data(), Y.data());
+
+        for (size_t k = 0; k < words; ++k) {
+            B[i * blockBytes + k * 4]     = (char)X[k];
+            B[i * blockBytes + k * 4 + 1] = (char)(X[k] >> 8);
+            B[i * blockBytes + k * 4 + 2] = (char)(X[k] >> 16);
+            B[i * blockBytes + k * 4 + 3] = (char)(X[k] >> 24);
+        }
+    }
+    return pbkdf2Sha256(password, B, 1, dkLen);
+}
+
+string toHex(const string &bytes) {
+    static const char digits[] = "0123456789abcdef";
+    string out;
+    out.reserve(bytes.size() * 2);
+    for (unsigned char c : bytes) {
+        out += digits[c >> 4];
+        out += digits[c & 15];
+    }
+    return out;
+}
+
+bool fromHex(const string &hex, string &bytes) {
+    if (hex.size() % 2) return false;
+    bytes.clear();
+    bytes.reserve(hex.size() / 2);
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        int v = 0;
+        for (int j = 0; j < 2; ++j) {
+            char c = hex[i + j];
+            v <<= 4;
+            if (c >= '0' && c <= '9') v |= c - '0';
+            else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+            else return false;
+        }
+        bytes += (char)v;
+    }
+    return true;
+}
+
+bool constantTimeEquals(const string &a, const string &b) {
+    if (a.size() != b.size()) return false;
+    unsigned char diff = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        diff |= (unsigned char)(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+string randomBytes(size_t n) {
+    random_device rd;
+    string out(n, '\0');
+    for (size_t i = 0; i < n; i += 4) {
+        unsigned int v = rd();
+        for (size_t j = 0; j < 4 && i + j < n; ++j)
+            out[i + j] = (char)(v >> (8 * j));
+    }
+    return out;
+}
@@ -1,23 +1,12 @@
 #include "Customer.h"
 
 // Default Constructor
-Customer::Customer() {
-    id = 0;
-    name = "";
-    cont_num = "";
-    email = "";
-    address = "";
-}
+Customer::Customer() : id(0) {}
 
-// Constructor used when loading product data from the database
-Customer::Customer(int i, const std::string& n,
-                   const std::string& num,
-                   const std::string& e,
-                   const std::string& add)
-{
-    id = i;
-    name = n;
-    cont_num = num;
-    email = e;
-    address = add;
-}
+// Constructor used when loading customer data from the database
+Customer::Customer(int i, std::string n,
+                   std::string num,
+                   std::string e,
+                   std::string add)
+    : id(i), name(std::move(n)), cont_num(std::move(num)),
+      email(std::move(e)), address(std::move(add)) {}
@@ -4,8 +4,20 @@
 #include "DBFunctions.h"
 #include "Customer.h"
 #include "Address.h"
+#include "CatalogSnapshot.h"
+#include "CatalogCache.h"
+#include "PasswordHasher.h"
+#include "DBRouter.h"
+#include "ShardRouter.h"
+#include "Recommendations.h"
+#include "WishlistFunctions.h"
+#include "ProductPrefetch.h"
+#include "QueryCache.h"
+#include "Statements.h"
 #include <iomanip>
 #include <limits>
+#include <unordered_map>
+#include <tuple>
 
 // -----------------------------
 // 1) ESTABLISHING THE DATABASE CONNECTION
@@ -14,11 +26,14 @@ sql::Connection* createConnection() {
     sql::mysql::MySQL_Driver *driver;
     sql::Connection *con;
 
+    // endpoint and credentials: see DBRouter.h (PROJECT1_DB_* variables)
+    DBEndpoint ep;
+    dbEndpoint(DB_PRIMARY, ep);
+
     try {
         driver = sql::mysql::get_mysql_driver_instance();
-        // update username/password as necessary
-        con = driver->connect("tcp://127.0.0.1:3306", "root", "Password"); //give the mysql password 
-        con->setSchema("DB Name"); //make sure all the required tables are in this database
+        con = driver->connect(ep.url, ep.user, ep.password);
+        con->setSchema(ep.schema);
     } catch (sql::SQLException &e) {
         cout << "Unable to connect to DB: " << e.what() << endl;
         throw;
@@ -31,6 +46,7 @@ sql::Connection* createConnection() {
 // 2) DISPLAY BY CATEGORY OF THE PRODUCTS
 // ---------------------------------------
 void displayByCategory(sql::Connection* con, string cat) {
+    con = routeRead(con);
     sql::PreparedStatement* pstmt = nullptr;
     sql::ResultSet* res = nullptr;
 
@@ -62,7 +78,7 @@ void displayByCategory(sql::Connection* con, string cat) {
                  << setw(28) << res->getString("Product_name")
                  << setw(18) << res->getString("Category")
                  << setw(18) << res->getString("Subcategory")
-                 << setw(10) << res->getDouble("Price")
+                 << setw(10) << Money::fromSQL(res->getString("Price"))
                  << setw(10) << res->getInt("Stock_Qtn")
                  << setw(20) << res->getString("Company_name")
                  << setw(12) << res->getString("ExpiryDate")
@@ -80,6 +96,7 @@ void displayByCategory(sql::Connection* con, string cat) {
 // 3) DISPLAY BY CATEGORY + SUBCATEGORY
 // ------------------------------------
 void displayBySubcategory(sql::Connection* con, string cat, string subcat) {
+    con = routeRead(con);
     sql::PreparedStatement* pstmt = nullptr;
     sql::ResultSet* res = nullptr;
 
@@ -110,7 +127,7 @@ void displayBySubcategory(sql::Connection* con, string cat, string subcat) {
         cout << left
             << setw(6)  << res->getInt("Product_ID")
             << setw(35) << res->getString("Product_Name")
-            << setw(10) << res->getDouble("Price")
+            << setw(10) << Money::fromSQL(res->getString("Price"))
             << '\n';
 }
 
@@ -126,6 +143,7 @@ void displayBySubcategory(sql::Connection* con, string cat, string subcat) {
 // 4) DISPLAY ALL PRODUCTS
 // -----------------------------
 void displayAllProducts(sql::Connection *con) {
+    con = routeRead(con);
     sql::Statement *stmt = nullptr;
     sql::ResultSet *res = nullptr;
 
@@ -152,7 +170,7 @@ void displayAllProducts(sql::Connection *con) {
                  << setw(28) << res->getString("Product_name")
                  << setw(18) << res->getString("Category")
                  << setw(18) << res->getString("Subcategory")
-                 << setw(10) << res->getDouble("Price")
+                 << setw(10) << Money::fromSQL(res->getString("Price"))
                  << setw(10) << res->getInt("Stock_Qtn")
                  << setw(20) << res->getString("Company_name")
                  << setw(12) << res->getString("ExpiryDate")
@@ -170,6 +188,12 @@ void displayAllProducts(sql::Connection *con) {
 // 5) LOAD DISTINCT CATEGORIES (vector-based)
 // -------------------------------------------
 vector<string> loadCategories(sql::Connection* con) {
+    if (auto cache = catalogCache())
+        return vector<string>(cache->categories.begin(), cache->categories.end());
+    if (auto snap = activeCatalogSnapshot())
+        return snap->categories();
+
+    con = routeRead(con);
     vector<string> categories;
     sql::Statement *stmt = nullptr;
     sql::ResultSet *res = nullptr;
@@ -194,6 +218,17 @@ vector<string> loadCategories(sql::Connection* con) {
 // 6) LOAD DISTINCT SUBCATEGORIES (vector-based)
 // ---------------------------------------------
 vector<string> loadSubcategories(sql::Connection* con, const string &category) {
+    if (auto cache = catalogCache()) {
+        InternedString key;
+        if (!InternedString::find(category, key)) return vector<string>();
+        auto it = cache->subcategories.find(key);
+        if (it == cache->subcategories.end()) return vector<string>();
+        return vector<string>(it->second.begin(), it->second.end());
+    }
+    if (auto snap = activeCatalogSnapshot())
+        return snap->subcategories(category);
+
+    con = routeRead(con);
     vector<string> subcats;
     sql::PreparedStatement *pstmt = nullptr;
     sql::ResultSet *res = nullptr;
@@ -224,8 +259,15 @@ void inputCustomerDetails(sql::Connection* con, const std::string& emailFromLogi
         cout << "❌ No active DB connection.\n";
         return;
     }
+    Customer c = promptCustomerDetails(emailFromLogin);
+
+    // Now insert this customer details into the DB
+    insertCustomerDetails(con, c);
+}
+
+// Prompts for name / contact / address; the email comes from the login step
+Customer promptCustomerDetails(const std::string& emailFromLogin) {
     Customer c;
-    int id;
     std::string name, contact, address;
 
     cout << "\n=====================================\n";
@@ -249,9 +291,7 @@ void inputCustomerDetails(sql::Connection* con, const std::string& emailFromLogi
     c.setContactnumber(contact);
     c.setEmail(emailFromLogin);
     c.setAddress(address);
-
-    // Now insert this customer details into the DB
-    insertCustomerDetails(con, c);
+    return c;
 }
 
 void insertCustomerDetails(sql::Connection* con, const Customer &c) {
@@ -267,6 +307,7 @@ void insertCustomerDetails(sql::Connection* con, const Customer &c) {
             pstmt->executeUpdate();
 
         delete pstmt;
+        noteWrite();
     }
     catch (sql::SQLException &e) {
         cerr << "SQL Error in insertCustomerDetails: " << e.what() << endl;
@@ -277,6 +318,20 @@ void insertCustomerDetails(sql::Connection* con, const Customer &c) {
 
 // (we will NOT print Product_ID or SID to the user)
 void displayProductDetailsById(int productId) {
+    // loaded in the background while the list was on screen
+    ProductDetails d;
+    if (findPrefetchedDetails(productId, d)) {
+        cout << "\n========== PRODUCT DETAILS ==========\n";
+        cout << "Product Name   : " << d.name << '\n';
+        cout << "Category       : " << d.category << '\n';
+        cout << "Subcategory    : " << d.subcategory << '\n';
+        cout << "Price          : " << d.price << '\n';
+        cout << "Stock Quantity : " << d.stock << '\n';
+        cout << "Brand/Company  : " << d.company << '\n';
+        cout << "Expiry Date    : " << d.expiry.toSQL() << '\n';
+        return;
+    }
+
     sql::Connection* con = nullptr;
     sql::PreparedStatement* pstmt = nullptr;
     sql::ResultSet* res = nullptr;
@@ -300,7 +355,7 @@ void displayProductDetailsById(int productId) {
             cout << "Product Name   : " << res->getString("Product_Name") << '\n';
             cout << "Category       : " << res->getString("Category") << '\n';
             cout << "Subcategory    : " << res->getString("Subcategory") << '\n';
-            cout << "Price          : " << res->getDouble("Price") << '\n';
+            cout << "Price          : " << Money::fromSQL(res->getString("Price")) << '\n';
             cout << "Stock Quantity : " << res->getInt("Stock_Qtn") << '\n';
             cout << "Brand/Company  : " << res->getString("Company_name") << '\n';
             cout << "Expiry Date    : " << res->getString("ExpiryDate") << '\n';
@@ -324,6 +379,28 @@ void displayProductDetailsById(int productId) {
 // Show supplier details for a given product
 // (we join PRODUCT -> Supplier using SID, but we only display Sname, Contact_Num, Email, Address)
 void displaySupplierForProduct(int productId) {
+    // Supplier details rarely change: serve from the warmed catalog if we can
+    if (auto cache = catalogCache()) {
+        if (const Supplier* s = cache->supplierFor(productId)) {
+            cout << "\n====== SUPPLIER DETAILS ======\n";
+            cout << "Supplier Name   : " << s->name << '\n';
+            cout << "Contact Number  : " << s->cont_num << '\n';
+            cout << "Email           : " << s->email << '\n';
+            cout << "Address         : " << s->address << '\n';
+            return;
+        }
+    }
+
+    ProductDetails d;
+    if (findPrefetchedDetails(productId, d) && d.hasSupplier) {
+        cout << "\n====== SUPPLIER DETAILS ======\n";
+        cout << "Supplier Name   : " << d.supplierName << '\n';
+        cout << "Contact Number  : " << d.supplierContact << '\n';
+        cout << "Email           : " << d.supplierEmail << '\n';
+        cout << "Address         : " << d.supplierAddress << '\n';
+        return;
+    }
+
     sql::Connection* con = nullptr;
     sql::PreparedStatement* pstmt = nullptr;
     sql::ResultSet* res = nullptr;
@@ -413,117 +490,282 @@ int getCustomerIdByEmail(sql::Connection* con, const std::string& email) {
 // ---------------- createOrderFromCart ----------------
 bool createOrderFromCart(sql::Connection* con, int customerId,int addressId, int &createdOrderId){
     if (!con) return false;
+    CartSnapshot cart;
+    if (!cart.load(con, customerId)) return false;
+    return createOrderFromSnapshot(con, cart, addressId, createdOrderId) == ORDER_OK;
+}
+
+// Conditional set-based decrement: one UPDATE takes every line's quantity off
+// its product, but only where the stock still covers it. Returns true when
+// all lines were applied (a partial update must be rolled back by the caller).
+static bool decrementStock(sql::Connection* con, const std::vector<CartLine> &lines) {
+    std::string byProduct = "CASE Product_ID";
+    std::string ids;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        byProduct += " WHEN ? THEN ?";
+        ids += i ? ", ?" : "?";
+    }
+    byProduct += " END";
+
+    sql::PreparedStatement* pstmt = con->prepareStatement(
+        "UPDATE PRODUCT SET Stock_Qtn = Stock_Qtn - " + byProduct +
+        " WHERE Product_ID IN (" + ids + ") AND Stock_Qtn >= " + byProduct
+    );
+    int idx = 1;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1)
+            for (const CartLine &l : lines) pstmt->setInt(idx++, l.productId);
+        for (const CartLine &l : lines) {
+            pstmt->setInt(idx++, l.productId);
+            pstmt->setInt(idx++, l.quantity);
+        }
+    }
+    int rows = pstmt->executeUpdate();
+    delete pstmt;
+    return rows == (int)lines.size();
+}
+
+// Puts sold quantities back, when an order could not be saved after its
+// stock was already taken (sharded checkout, see below)
+static void returnStock(sql::Connection* con, const std::vector<CartLine> &lines) {
+    std::string byProduct = "CASE Product_ID";
+    std::string ids;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        byProduct += " WHEN ? THEN ?";
+        ids += i ? ", ?" : "?";
+    }
+    byProduct += " END";
+
+    sql::PreparedStatement* pstmt = con->prepareStatement(
+        "UPDATE PRODUCT SET Stock_Qtn = Stock_Qtn + " + byProduct +
+        " WHERE Product_ID IN (" + ids + ")"
+    );
+    int idx = 1;
+    for (const CartLine &l : lines) {
+        pstmt->setInt(idx++, l.productId);
+        pstmt->setInt(idx++, l.quantity);
+    }
+    for (const CartLine &l : lines) pstmt->setInt(idx++, l.productId);
+    pstmt->executeUpdate();
+    delete pstmt;
+}
+
+enum CommitOutcome { COMMIT_DONE, COMMIT_LOST, COMMIT_UNKNOWN };
+
+// After a failed shard commit: is the Orders row there? Asked on a new
+// connection with a locking read, so it waits for a commit still in flight.
+static CommitOutcome shardOrderOutcome(int customerId, int orderId) {
+    sql::Connection* check = nullptr;
     try {
-        // 1) load cart items
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT c.Product_ID, c.Quantity, p.Product_Name, p.Price "
-            "FROM Cart c JOIN PRODUCT p ON c.Product_ID = p.Product_ID "
-            "WHERE c.Customer_ID = ?"
+        check = openShardConnection(shardOf(customerId));
+        sql::PreparedStatement* pstmt = check->prepareStatement(
+            "SELECT OrderID FROM Orders WHERE OrderID = ? LOCK IN SHARE MODE"
         );
-        pstmt->setInt(1, customerId);
+        pstmt->setInt(1, orderId);
         sql::ResultSet* res = pstmt->executeQuery();
+        bool found = res->next();
+        delete res;
+        delete pstmt;
+        check->close();
+        delete check;
+        return found ? COMMIT_DONE : COMMIT_LOST;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in shardOrderOutcome: " << e.what() << endl;
+        delete check;
+        return COMMIT_UNKNOWN;
+    }
+}
 
-        std::vector<int> productIds;
-        std::vector<int> qtys;
-        std::vector<double> prices;
-        std::vector<std::string> names;
-        double total = 0.0;
+// Stock this process took: drop what showed the old levels
+static void stockTaken(const std::vector<CartLine> &lines) {
+    std::vector<std::pair<int, int>> sold;
+    for (const CartLine &l : lines) {
+        sold.push_back({l.productId, l.quantity});
+        forgetPrefetchedDetails(l.productId);
+    }
+    adjustCatalogStock(sold);
+    invalidateStockResults();
+}
 
-        while (res->next()) {
-            int pid = res->getInt("Product_ID");
-            int qty = res->getInt("Quantity");
-            std::string pname = res->getString("Product_Name");
-            double price = res->getDouble("Price");
-            double subtotal = price * qty;
-
-            productIds.push_back(pid);
-            qtys.push_back(qty);
-            prices.push_back(price);
-            names.push_back(pname);
-            total += subtotal;
+// ---------------- createOrderFromSnapshot ----------------
+// The cart, Orders and OrderItems live on the customer's shard, stock in the
+// global PRODUCT. When those are two connections, both transactions are
+// prepared and the stock is committed first. If the shard commit then fails,
+// the stock goes back only once a fresh read shows the order is not there;
+// when that cannot be told the stock stays taken, so a failure can only
+// under-sell.
+OrderResult createOrderFromSnapshot(sql::Connection* con, const CartSnapshot &cart,
+                                    int addressId, int &createdOrderId,
+                                    std::vector<StockShortfall>* shortfalls) {
+    if (!con) return ORDER_ERROR;
+    if (cart.empty()) return ORDER_EMPTY_CART;
+
+    int customerId = cart.getCustomerId();
+    const std::vector<CartLine> &lines = cart.getLines();
+    sql::Connection* shard = con;
+    bool autoCommit = true;
+    bool shardAutoCommit = true;
+    bool stockCommitted = false;
+
+    auto rollbackAll = [&]() {
+        if (!stockCommitted) {
+            con->rollback();
+            con->setAutoCommit(autoCommit);
         }
+        if (shard != con) {
+            shard->rollback();
+            shard->setAutoCommit(shardAutoCommit);
+        }
+    };
+
+    try {
+        shard = shardWrite(con, customerId);
+        autoCommit = con->getAutoCommit();
+        con->setAutoCommit(false);
+        if (shard != con) {
+            shardAutoCommit = shard->getAutoCommit();
+            shard->setAutoCommit(false);
+        }
+
+        // 1) lock the cart rows and make sure they are still what was shown
+        sql::PreparedStatement* pstmt = shard->prepareStatement(
+            "SELECT Product_ID, Quantity FROM Cart WHERE Customer_ID = ? "
+            "ORDER BY Product_ID FOR UPDATE"
+        );
+        pstmt->setInt(1, customerId);
+        sql::ResultSet* res = pstmt->executeQuery();
+        std::vector<std::pair<int, int>> current;
+        while (res->next()) current.push_back({res->getInt(1), res->getInt(2)});
         delete res;
         delete pstmt;
 
-        if (productIds.empty()) return false;
+        if (cartVersion(current) != cart.version()) {
+            rollbackAll();
+            return ORDER_CART_CHANGED;
+        }
 
         // 2) insert Orders row (OrderDate = CURDATE(), DeliveryDate = CURDATE() + 4 days)
-        pstmt = con->prepareStatement(
+        pstmt = shard->prepareStatement(
             "INSERT INTO Orders (CustomerID, OrderDate, DeliveryDate, TotalAmount) "
             "VALUES (?, CURDATE(), DATE_ADD(CURDATE(), INTERVAL 4 DAY), ?)"
         );
         pstmt->setInt(1, customerId);
-        pstmt->setDouble(2, total);
+        pstmt->setString(2, cart.total().toString());     // exact DECIMAL text
         pstmt->executeUpdate();
         delete pstmt;
 
         // 3) grab LAST_INSERT_ID()
-        pstmt = con->prepareStatement("SELECT LAST_INSERT_ID() AS id");
+        pstmt = shard->prepareStatement("SELECT LAST_INSERT_ID() AS id");
         res = pstmt->executeQuery();
         int orderId = -1;
         if (res->next()) orderId = res->getInt("id");
         delete res;
         delete pstmt;
 
-        if (orderId == -1) return false;
-        createdOrderId = orderId;
+        if (orderId == -1) {
+            rollbackAll();
+            return ORDER_ERROR;
+        }
 
         // 4) insert OrderItems
-        for (size_t i = 0; i < productIds.size(); ++i) {
-            sql::PreparedStatement* p2 = con->prepareStatement(
-                "INSERT INTO OrderItems (OrderID, ProductID, Quantity, PriceAtPurchase, Subtotal) "
-                "VALUES (?, ?, ?, ?, ?)"
-            );
-            p2->setInt(1, orderId);
-            p2->setInt(2, productIds[i]);
-            p2->setInt(3, qtys[i]);
-            p2->setDouble(4, prices[i]);
-            p2->setDouble(5, prices[i] * qtys[i]);
-            p2->executeUpdate();
-            delete p2;
+        pstmt = shard->prepareStatement(
+            "INSERT INTO OrderItems (OrderID, ProductID, Quantity, PriceAtPurchase, Subtotal) "
+            "VALUES (?, ?, ?, ?, ?)"
+        );
+        for (const CartLine &l : lines) {
+            pstmt->setInt(1, orderId);
+            pstmt->setInt(2, l.productId);
+            pstmt->setInt(3, l.quantity);
+            pstmt->setString(4, l.price.toString());
+            pstmt->setString(5, l.subtotal().toString());
+            pstmt->executeUpdate();
         }
+        delete pstmt;
 
-        // 5) reduce stock
-        sql::Statement* stmt = con->createStatement();
-        stmt->execute(
-            "UPDATE PRODUCT p "
-            "JOIN Cart c ON p.Product_ID = c.Product_ID "
-            "SET p.Stock_Qtn = p.Stock_Qtn - c.Quantity "
-            "WHERE c.Customer_ID = " + std::to_string(customerId)
-        );
+        // 5) clear cart
+        pstmt = shard->prepareStatement("DELETE FROM Cart WHERE Customer_ID = ?");
+        pstmt->setInt(1, customerId);
+        pstmt->executeUpdate();
+        delete pstmt;
 
-        // 6) clear cart
-        stmt->execute("DELETE FROM Cart WHERE Customer_ID = " + std::to_string(customerId));
-        delete stmt;
+        // 6) reduce stock last, so the PRODUCT row locks are held only until
+        //    the commit just below; all lines or none
+        if (!decrementStock(con, lines)) {
+            rollbackAll();
+            if (shortfalls) {
+                CartSnapshot check(cart);
+                check.checkStock(con, *shortfalls);
+            }
+            return ORDER_OUT_OF_STOCK;
+        }
 
-        return true;
+        con->commit();
+        stockCommitted = true;
+        con->setAutoCommit(autoCommit);
+        if (shard != con) {
+            try {
+                shard->commit();
+                shard->setAutoCommit(shardAutoCommit);
+            } catch (sql::SQLException &e) {
+                cerr << "SQL Error in createOrderFromSnapshot (shard commit): " << e.what() << endl;
+                try {
+                    shard->rollback();
+                    shard->setAutoCommit(shardAutoCommit);
+                } catch (sql::SQLException &) {}
+
+                CommitOutcome outcome = shardOrderOutcome(customerId, orderId);
+                if (outcome == COMMIT_UNKNOWN) {
+                    cerr << "Order " << orderId << " of customer " << customerId
+                         << " is unconfirmed; its stock stays taken." << endl;
+                    stockTaken(lines);
+                    createdOrderId = orderId;
+                    return ORDER_UNCONFIRMED;
+                }
+                if (outcome == COMMIT_LOST) {
+                    try {
+                        returnStock(con, lines);
+                    } catch (sql::SQLException &e2) {
+                        cerr << "SQL Error in createOrderFromSnapshot: stock of lost order " << orderId
+                             << " was not returned: " << e2.what() << endl;
+                        for (const CartLine &l : lines)
+                            cerr << "  product " << l.productId << " quantity " << l.quantity << endl;
+                        stockTaken(lines);
+                    }
+                    return ORDER_ERROR;
+                }
+                // COMMIT_DONE: the commit went through after all
+            }
+        }
+        createdOrderId = orderId;
+
+        noteWrite(customerId);
+        std::vector<int> productIds;
+        for (const CartLine &l : lines) productIds.push_back(l.productId);
+        stockTaken(lines);
+        coPurchaseIndex().recordOrder(orderId, productIds);
+        return ORDER_OK;
     } catch (sql::SQLException &e) {
-        cerr << "SQL Error in createOrderFromCart: " << e.what() << endl;
-        return false;
+        cerr << "SQL Error in createOrderFromSnapshot: " << e.what() << endl;
+        try {
+            rollbackAll();
+        } catch (sql::SQLException &) {}
+        return ORDER_ERROR;
     }
 }
 
 // ---------------- loadOrdersForCustomer ----------------
-std::vector<Order> loadOrdersForCustomer(sql::Connection* con, int customerId) {
-    std::vector<Order> orders;
+std::pmr::vector<Order> loadOrdersForCustomer(sql::Connection* con, int customerId,
+                                              std::pmr::memory_resource* mr) {
+    std::pmr::vector<Order> orders(mr);
     if (!con) return orders;
     try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT OrderID, OrderDate, DeliveryDate, TotalAmount "
-            "FROM Orders WHERE CustomerID = ? ORDER BY OrderDate DESC, OrderID DESC"
-        );
-        pstmt->setInt(1, customerId);
+        con = shardRead(con, customerId);
+        sql::PreparedStatement* pstmt = sqlreg::prepare(con, stmts::ORDERS_FOR_CUSTOMER, customerId);
         sql::ResultSet* res = pstmt->executeQuery();
+        orders.reserve(res->rowsCount());
         while (res->next()) {
-            orders.push_back(
-                Order(
-                    res->getInt("OrderID"),
-                    customerId,
-                    res->getString("OrderDate"),
-                    res->getString("DeliveryDate"),
-                    res->getDouble("TotalAmount")
-                )
-            );
+            auto [orderId, ordered, delivery, total] = sqlreg::readRow(res, stmts::ORDERS_FOR_CUSTOMER);
+            orders.emplace_back(orderId, customerId, ordered, delivery, total);
         }
         delete res;
         delete pstmt;
@@ -534,27 +776,41 @@ std::vector<Order> loadOrdersForCustomer(sql::Connection* con, int customerId) {
 }
 
 // ---------------- loadOrderItems ----------------
-std::vector<OrderItem> loadOrderItems(sql::Connection* con, int orderId) {
-    std::vector<OrderItem> items;
+std::pmr::vector<OrderItem> loadOrderItems(sql::Connection* con, int customerId, int orderId,
+                                           std::pmr::memory_resource* mr) {
+    std::pmr::vector<OrderItem> items(mr);
     if (!con) return items;
     try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT oi.ProductID, p.Product_Name, oi.Quantity, oi.PriceAtPurchase, oi.Subtotal "
-            "FROM OrderItems oi JOIN PRODUCT p ON oi.ProductID = p.Product_ID "
-            "WHERE oi.OrderID = ?"
-        );
-        pstmt->setInt(1, orderId);
+        if (!inGlobalSchema(customerId)) {
+            // OrderItems rows from the shard, names from PRODUCT
+            sql::PreparedStatement* pstmt =
+                sqlreg::prepare(shardRead(con, customerId), stmts::ORDER_ITEM_ROWS, orderId);
+            sql::ResultSet* res = pstmt->executeQuery();
+            std::vector<std::tuple<int, int, Money, Money>> rows;
+            while (res->next()) rows.push_back(sqlreg::readRow(res, stmts::ORDER_ITEM_ROWS));
+            delete res;
+            delete pstmt;
+
+            std::vector<int> ids;
+            for (auto &r : rows) ids.push_back(std::get<0>(r));
+            std::unordered_map<int, ProductFacts> facts;
+            loadProductFacts(con, customerId, ids, facts);
+            items.reserve(rows.size());
+            for (auto &[productId, qty, price, subtotal] : rows) {
+                auto it = facts.find(productId);
+                if (it != facts.end()) items.emplace_back(productId, it->second.name, qty, price, subtotal);
+            }
+            return items;
+        }
+
+        con = routeRead(con, customerId);
+        sql::PreparedStatement* pstmt = sqlreg::prepare(con, stmts::ORDER_ITEMS, orderId);
         sql::ResultSet* res = pstmt->executeQuery();
+        // names are copied into items' memory resource
+        items.reserve(res->rowsCount());
         while (res->next()) {
-            items.push_back(
-                OrderItem(
-                    res->getInt("ProductID"),
-                    res->getString("Product_Name"),
-                    res->getInt("Quantity"),
-                    res->getDouble("PriceAtPurchase"),
-                    res->getDouble("Subtotal")
-                )
-            );
+            auto [productId, name, qty, price, subtotal] = sqlreg::readRow(res, stmts::ORDER_ITEMS);
+            items.emplace_back(productId, name, qty, price, subtotal);
         }
         delete res;
         delete pstmt;
@@ -567,18 +823,17 @@ std::vector<OrderItem> loadOrderItems(sql::Connection* con, int orderId) {
 // ---------------- getCustomerById ----------------
 bool getCustomerById(sql::Connection* con, int customerId, Customer &outCustomer) {
     if (!con) return false;
+    con = routeRead(con, customerId);
     try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT ID, Name, Contact_Num, Email, Address FROM CUSTOMER_DETAILS WHERE ID = ?"
-        );
-        pstmt->setInt(1, customerId);
+        sql::PreparedStatement* pstmt = sqlreg::prepare(con, stmts::CUSTOMER_BY_ID, customerId);
         sql::ResultSet* res = pstmt->executeQuery();
         if (res->next()) {
-            outCustomer.setId(res->getInt("ID"));
-            outCustomer.setName(res->getString("Name"));
-            outCustomer.setContactnumber(res->getString("Contact_Num"));
-            outCustomer.setEmail(res->getString("Email"));
-            outCustomer.setAddress(res->getString("Address"));
+            auto [id, name, contact, email, address] = sqlreg::readRow(res, stmts::CUSTOMER_BY_ID);
+            outCustomer.setId(id);
+            outCustomer.setName(std::move(name));
+            outCustomer.setContactnumber(std::move(contact));
+            outCustomer.setEmail(std::move(email));
+            outCustomer.setAddress(std::move(address));
             delete res;
             delete pstmt;
             return true;
@@ -604,6 +859,7 @@ bool updateCustomerDetails(sql::Connection* con, const Customer &c) {
         pstmt->setInt(4, c.getId());
         int rows = pstmt->executeUpdate();
         delete pstmt;
+        noteWrite(c.getId());
         return rows > 0;
     } catch (sql::SQLException &e) {
         cerr << "SQL Error in updateCustomerDetails: " << e.what() << endl;
@@ -614,14 +870,22 @@ bool updateCustomerDetails(sql::Connection* con, const Customer &c) {
 // ---------------- updateLoginPassword ----------------
 bool updateLoginPassword(sql::Connection* con, const std::string &email, const std::string &newPassword) {
     if (!con) return false;
+
+    string hashed = PasswordHasher::instance().hash(newPassword);
+    if (hashed.empty()) {
+        cerr << "Password hashing is busy, try again shortly.\n";
+        return false;
+    }
+
     try {
         sql::PreparedStatement* pstmt = con->prepareStatement(
             "UPDATE `LOGIN` SET Password = ? WHERE Email = ?"
         );
-        pstmt->setString(1, newPassword);
+        pstmt->setString(1, hashed);
         pstmt->setString(2, email);
         int rows = pstmt->executeUpdate();
         delete pstmt;
+        noteWrite();
         return rows > 0;
     } catch (sql::SQLException &e) {
         cerr << "SQL Error in updateLoginPassword: " << e.what() << endl;
@@ -629,53 +893,62 @@ bool updateLoginPassword(sql::Connection* con, const std::string &email, const s
     }
 }
 
-vector<int> searchProductsByName(sql::Connection* con, const string &name) {
+// Product ids for `key`: the cached result, or `sql` (parameters set by
+// `bind`) run on a read connection and cached unless an invalidation ran
+// meanwhile. An SQL error is reported as `where` and gives no ids, which
+// are not cached.
+template <typename Bind>
+static vector<int> cachedProductIds(sql::Connection* con, const ResultKey &key, const char* where,
+                                    const char* sql, Bind bind) {
+    uint64_t readAt;
+    if (auto hit = productResultCache().find(key, &readAt)) return *hit;
+
+    con = routeRead(con);
     vector<int> ids;
     try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Product_Name LIKE ?"
-        );
-        pstmt->setString(1, "%" + name + "%");
+        sql::PreparedStatement* pstmt = con->prepareStatement(sql);
+        bind(pstmt);
         sql::ResultSet* res = pstmt->executeQuery();
 
-        while (res->next()) {
-            ids.push_back(res->getInt("Product_ID"));
-        }
+        while (res->next())
+            ids.push_back(res->getInt(1));
 
-        delete res; delete pstmt;
+        delete res;
+        delete pstmt;
+        cacheProductResult(key, ids, readAt);
     } catch (sql::SQLException &e) {
-        cerr << "SQL Error in searchProductsByName: " << e.what() << endl;
+        cerr << "SQL Error in " << where << ": " << e.what() << endl;
+        ids.clear();
     }
     return ids;
 }
 
-vector<int> searchProductsByCompany(sql::Connection* con, const string &company) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Company_name LIKE ?"
-        );
-        pstmt->setString(1, "%" + company + "%");
-        sql::ResultSet* res = pstmt->executeQuery();
-
-        while (res->next()) {
-            ids.push_back(res->getInt("Product_ID"));
-        }
+static std::pmr::vector<int> toPmr(const vector<int> &ids, std::pmr::memory_resource* mr) {
+    return std::pmr::vector<int>(ids.begin(), ids.end(), mr);
+}
 
-        delete res; delete pstmt;
-    } catch (sql::SQLException &e) {
-        cerr << "SQL Error in searchProductsByCompany: " << e.what() << endl;
-    }
-    return ids;
+std::pmr::vector<int> searchProductsByName(sql::Connection* con, const string &name,
+                                           std::pmr::memory_resource* mr) {
+    return toPmr(cachedProductIds(con, ResultKey(RQ_SEARCH_NAME, name), "searchProductsByName",
+        "SELECT Product_ID FROM PRODUCT WHERE Product_Name LIKE ?",
+        [&](sql::PreparedStatement* ps) { ps->setString(1, "%" + name + "%"); }), mr);
 }
 
-vector<int> searchProductsByCategory(sql::Connection* con, const string &category) {
+vector<int> productsExpiringWithin(sql::Connection* con, int days) {
+    Date today = Date::today();
+    if (auto cache = catalogCache())
+        return cache->expiry.expiringWithin(days, today);
+
+    con = routeRead(con);
     vector<int> ids;
     try {
+        // range on ExpiryDate (index idx_product_expiry), not a full scan
         sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Category LIKE ?"
+            "SELECT Product_ID FROM PRODUCT WHERE ExpiryDate BETWEEN ? AND ? "
+            "ORDER BY ExpiryDate, Product_ID"
         );
-        pstmt->setString(1, "%" + category + "%");
+        pstmt->setString(1, today.toSQL());
+        pstmt->setString(2, (today + days).toSQL());
         sql::ResultSet* res = pstmt->executeQuery();
 
         while (res->next()) {
@@ -684,150 +957,105 @@ vector<int> searchProductsByCategory(sql::Connection* con, const string &categor
 
         delete res; delete pstmt;
     } catch (sql::SQLException &e) {
-        cerr << "SQL Error in searchProductsByCategory: " << e.what() << endl;
+        cerr << "SQL Error in productsExpiringWithin: " << e.what() << endl;
     }
     return ids;
 }
 
-vector<int> searchProductsByPriceRange(sql::Connection* con, double minPrice, double maxPrice) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Price BETWEEN ? AND ?"
-        );
-        pstmt->setDouble(1, minPrice);
-        pstmt->setDouble(2, maxPrice);
-        sql::ResultSet* res = pstmt->executeQuery();
-
-        while (res->next()) {
-            ids.push_back(res->getInt("Product_ID"));
-        }
+std::pmr::vector<int> searchProductsByCompany(sql::Connection* con, const string &company,
+                                              std::pmr::memory_resource* mr) {
+    return toPmr(cachedProductIds(con, ResultKey(RQ_SEARCH_COMPANY, company), "searchProductsByCompany",
+        "SELECT Product_ID FROM PRODUCT WHERE Company_name LIKE ?",
+        [&](sql::PreparedStatement* ps) { ps->setString(1, "%" + company + "%"); }), mr);
+}
 
-        delete res; delete pstmt;
-    } catch (sql::SQLException &e) {
-        cerr << "SQL Error in searchProductsByPriceRange: " << e.what() << endl;
-    }
-    return ids;
+std::pmr::vector<int> searchProductsByCategory(sql::Connection* con, const string &category,
+                                               std::pmr::memory_resource* mr) {
+    return toPmr(cachedProductIds(con, ResultKey(RQ_SEARCH_CATEGORY, category), "searchProductsByCategory",
+        "SELECT Product_ID FROM PRODUCT WHERE Category LIKE ?",
+        [&](sql::PreparedStatement* ps) { ps->setString(1, "%" + category + "%"); }), mr);
 }
 
-vector<int> sortProductsByPriceAsc(sql::Connection* con, const string &cat, const string &subcat) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Price ASC"
-        );
-        pstmt->setString(1, cat);
-        pstmt->setString(2, subcat);
-        sql::ResultSet* rs = pstmt->executeQuery();
+std::pmr::vector<int> searchProductsByPriceRange(sql::Connection* con, Money minPrice, Money maxPrice,
+                                                 std::pmr::memory_resource* mr) {
+    return toPmr(cachedProductIds(con, ResultKey(RQ_SEARCH_PRICE, "", "", minPrice, maxPrice),
+        "searchProductsByPriceRange",
+        "SELECT Product_ID FROM PRODUCT WHERE Price BETWEEN ? AND ?",
+        [&](sql::PreparedStatement* ps) {
+            ps->setString(1, minPrice.toString());
+            ps->setString(2, maxPrice.toString());
+        }), mr);
+}
 
-        while (rs->next())
-            ids.push_back(rs->getInt(1));
+// sort / filter within one (category, subcategory)
+static vector<int> groupProductIds(sql::Connection* con, const ResultKey &key, const char* where,
+                                   const char* sql) {
+    return cachedProductIds(con, key, where, sql, [&](sql::PreparedStatement* ps) {
+        ps->setString(1, key.text1);
+        ps->setString(2, key.text2);
+    });
+}
 
-        delete rs;
-        delete pstmt;
-    } catch (...) {}
-    return ids;
+vector<int> sortProductsByPriceAsc(sql::Connection* con, const string &cat, const string &subcat) {
+    return groupProductIds(con, ResultKey(RQ_SORT_PRICE_ASC, cat, subcat), "sortProductsByPriceAsc",
+        "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Price ASC");
 }
 
 vector<int> sortProductsByPriceDesc(sql::Connection* con, const string &cat, const string &subcat) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Price DESC"
-        );
-        pstmt->setString(1, cat);
-        pstmt->setString(2, subcat);
-        sql::ResultSet* rs = pstmt->executeQuery();
-
-        while (rs->next())
-            ids.push_back(rs->getInt(1));
-
-        delete rs;
-        delete pstmt;
-    } catch (...) {}
-    return ids;
+    return groupProductIds(con, ResultKey(RQ_SORT_PRICE_DESC, cat, subcat), "sortProductsByPriceDesc",
+        "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Price DESC");
 }
 
 vector<int> sortProductsByName(sql::Connection* con, const string &cat, const string &subcat) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Product_Name ASC"
-        );
-        pstmt->setString(1, cat);
-        pstmt->setString(2, subcat);
-        sql::ResultSet* rs = pstmt->executeQuery();
-
-        while (rs->next())
-            ids.push_back(rs->getInt(1));
-
-        delete rs;
-        delete pstmt;
-    } catch (...) {}
-    return ids;
+    return groupProductIds(con, ResultKey(RQ_SORT_NAME, cat, subcat), "sortProductsByName",
+        "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Product_Name ASC");
 }
 
 vector<int> sortProductsByStock(sql::Connection* con, const string &cat, const string &subcat) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Stock_Qtn DESC"
-        );
-        pstmt->setString(1, cat);
-        pstmt->setString(2, subcat);
-        sql::ResultSet* rs = pstmt->executeQuery();
-
-        while (rs->next())
-            ids.push_back(rs->getInt(1));
-
-        delete rs;
-        delete pstmt;
-    } catch (...) {}
-    return ids;
+    return groupProductIds(con, ResultKey(RQ_SORT_STOCK, cat, subcat), "sortProductsByStock",
+        "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? ORDER BY Stock_Qtn DESC");
 }
 
 vector<int> filterProductsByCompany(sql::Connection* con, const string &cat, const string &subcat, const string &company) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? AND Company_name=?"
-        );
-        pstmt->setString(1, cat);
-        pstmt->setString(2, subcat);
-        pstmt->setString(3, company);
-        sql::ResultSet* rs = pstmt->executeQuery();
-
-        while (rs->next())
-            ids.push_back(rs->getInt(1));
-
-        delete rs;
-        delete pstmt;
-    } catch (...) {}
-    return ids;
+    return cachedProductIds(con, ResultKey(RQ_FILTER_COMPANY, cat, subcat, company), "filterProductsByCompany",
+        "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? AND Company_name=?",
+        [&](sql::PreparedStatement* ps) {
+            ps->setString(1, cat);
+            ps->setString(2, subcat);
+            ps->setString(3, company);
+        });
 }
 
-vector<int> filterProductsByPriceRange(sql::Connection* con, const string &cat, const string &subcat, float low, float high) {
-    vector<int> ids;
-    try {
-        sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? AND Price BETWEEN ? AND ?"
-        );
-        pstmt->setString(1, cat);
-        pstmt->setString(2, subcat);
-        pstmt->setDouble(3, low);
-        pstmt->setDouble(4, high);
-        sql::ResultSet* rs = pstmt->executeQuery();
-
-        while (rs->next())
-            ids.push_back(rs->getInt(1));
-
-        delete rs;
-        delete pstmt;
-    } catch (...) {}
-    return ids;
+vector<int> filterProductsByPriceRange(sql::Connection* con, const string &cat, const string &subcat, Money low, Money high) {
+    return cachedProductIds(con, ResultKey(RQ_FILTER_PRICE, cat, subcat, low, high), "filterProductsByPriceRange",
+        "SELECT Product_ID FROM PRODUCT WHERE Category=? AND Subcategory=? AND Price BETWEEN ? AND ?",
+        [&](sql::PreparedStatement* ps) {
+            ps->setString(1, cat);
+            ps->setString(2, subcat);
+            ps->setString(3, low.toString());
+            ps->setString(4, high.toString());
+        });
 }
 
 void displayCompactProductRow(sql::Connection* con, int productId, int index) {
+    if (auto cache = catalogCache()) {
+        if (const Product* p = cache->findProduct(productId)) {
+            const Supplier* s = cache->supplierFor(productId);
+            cout << left
+                 << setw(6)  << index
+                 << setw(10) << p->getId()
+                 << setw(30) << p->getName()
+                 << setw(10) << cache->stockOf(*p)
+                 << setw(10) << p->getPrice()
+                 << setw(15) << p->getExpiry().toSQL()
+                 << setw(20) << (s ? s->name : "")
+                 << (inSessionWishlist(productId) ? "♥" : "")
+                 << "\n";
+            return;
+        }
+    }
+
+    con = routeRead(con);
     sql::PreparedStatement* pstmt = nullptr;
     sql::ResultSet* res = nullptr;
 
@@ -845,9 +1073,10 @@ void displayCompactProductRow(sql::Connection* con, int productId, int index) {
              << setw(10) << res->getInt("Product_ID")
              << setw(30) << res->getString("Product_Name")
              << setw(10) << res->getInt("Stock_Qtn")
-             << setw(10) << res->getDouble("Price")
+             << setw(10) << Money::fromSQL(res->getString("Price"))
              << setw(15) << res->getString("ExpiryDate")
              << setw(20) << res->getString("Sname")
+             << (inSessionWishlist(productId) ? "♥" : "")
              << "\n";
     }
 
@@ -860,6 +1089,7 @@ bool addAddress(sql::Connection* con, int customerId,
                 const string &state, const string &pincode) {
 
     try {
+        con = shardWrite(con, customerId);
         sql::PreparedStatement* pstmt =
             con->prepareStatement(
                 "INSERT INTO ADDRESS (CustomerID, AddressLine, City, State, PostalCode) "
@@ -874,6 +1104,7 @@ bool addAddress(sql::Connection* con, int customerId,
 
         pstmt->executeUpdate();
         delete pstmt;
+        noteWrite(customerId);
         return true;
     }
     catch (sql::SQLException &e) {
@@ -886,18 +1117,13 @@ vector<pair<int,string>> loadAddresses(sql::Connection* con, int customerId) {
     vector<pair<int,string>> list;
 
     try {
-        sql::PreparedStatement* pstmt =
-            con->prepareStatement(
-                "SELECT AddressID, AddressLine FROM ADDRESS WHERE CustomerID=?"
-            );
-        pstmt->setInt(1, customerId);
-
+        con = shardRead(con, customerId);
+        sql::PreparedStatement* pstmt = sqlreg::prepare(con, stmts::ADDRESS_LINES, customerId);
         sql::ResultSet* res = pstmt->executeQuery();
 
+        list.reserve(res->rowsCount());
         while (res->next()) {
-            int id = res->getInt("AddressID");
-            string line = res->getString("AddressLine");
-            list.push_back({id, line});
+            list.push_back(sqlreg::readAs<pair<int, string>>(res, stmts::ADDRESS_LINES));
         }
 
         delete res;
@@ -907,13 +1133,16 @@ vector<pair<int,string>> loadAddresses(sql::Connection* con, int customerId) {
     return list;
 }
 
-bool deleteAddress(sql::Connection* con, int addressId) {
+bool deleteAddress(sql::Connection* con, int customerId, int addressId) {
     try {
+        con = shardWrite(con, customerId);
         sql::PreparedStatement* pstmt =
-            con->prepareStatement("DELETE FROM ADDRESS WHERE AddressID=?");
+            con->prepareStatement("DELETE FROM ADDRESS WHERE AddressID=? AND CustomerID=?");
         pstmt->setInt(1, addressId);
+        pstmt->setInt(2, customerId);
         pstmt->executeUpdate();
         delete pstmt;
+        noteWrite(customerId);
         return true;
     }
     catch (...) { return false; }
@@ -922,6 +1151,7 @@ bool deleteAddress(sql::Connection* con, int addressId) {
 vector<Address> loadFullAddresses(sql::Connection* con, int customerId) {
     vector<Address> list;
     try {
+        con = shardRead(con, customerId);
         sql::PreparedStatement* pstmt =
             con->prepareStatement(
                 "SELECT AddressID, AddressLine, City, State, PostalCode, Country, IsDefault "
@@ -931,8 +1161,9 @@ vector<Address> loadFullAddresses(sql::Connection* con, int customerId) {
 
         sql::ResultSet* res = pstmt->executeQuery();
 
+        list.reserve(res->rowsCount());
         while (res->next()) {
-            Address a(
+            list.emplace_back(
                 res->getInt("AddressID"),
                 res->getString("AddressLine"),
                 res->getString("City"),
@@ -941,7 +1172,6 @@ vector<Address> loadFullAddresses(sql::Connection* con, int customerId) {
                 res->getString("Country"),
                 res->getInt("IsDefault")
             );
-            list.push_back(a);
         }
 
         delete res;
@@ -0,0 +1,175 @@
+// DBRouter.cpp
+// Primary / replica endpoints, per-thread replica connections, sticky reads
+
+#include "DBRouter.h"
+
+#include <mysql_driver.h>
+#include <mysql_connection.h>
+#include <cppconn/exception.h>
+
+#include <iostream>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+const int DEFAULT_STICKY_SECONDS = 5;
+const int REPLICA_RETRY_SECONDS = 30;     // after a failed connect, use the primary meanwhile
+const int REPLICA_PROBE_SECONDS = 10;     // ping a reused replica connection at most this often
+
+typedef chrono::steady_clock Clock;
+
+string envOr(const char* name, const char* fallback) {
+    const char* v = getenv(name);
+    return (v && *v) ? v : fallback;
+}
+
+Clock::duration stickyWindow() {
+    static const int seconds = atoi(envOr("PROJECT1_DB_STICKY_SECONDS", "5").c_str());
+    return chrono::seconds(seconds >= 0 ? seconds : DEFAULT_STICKY_SECONDS);
+}
+
+// replica health, shared by all threads (ticks of Clock, 0 = healthy)
+atomic<long long> replicaDownUntil{0};
+
+bool replicaDown() {
+    long long until = replicaDownUntil.load();
+    return until != 0 && Clock::now().time_since_epoch().count() < until;
+}
+
+void markReplicaDown() {
+    replicaDownUntil = (Clock::now() + chrono::seconds(REPLICA_RETRY_SECONDS)).time_since_epoch().count();
+}
+
+// last write per customer, for stickiness across threads / connections
+mutex writesMutex;
+unordered_map<int, Clock::time_point> lastWriteByCustomer;
+
+// this thread's replica connection, closed when the thread exits
+struct ReplicaHolder {
+    sql::Connection* con = nullptr;
+    Clock::time_point probedAt;
+    ~ReplicaHolder() {
+        if (!con) return;
+        try {
+            con->close();
+        } catch (sql::SQLException &) {}
+        delete con;
+    }
+};
+
+thread_local Clock::time_point threadLastWrite;
+thread_local bool threadHasWritten = false;
+thread_local ReplicaHolder threadReplica;
+
+sql::Connection* openReplica() {
+    DBEndpoint ep;
+    if (!dbEndpoint(DB_REPLICA, ep) || replicaDown()) return nullptr;
+    try {
+        return openConnection(ep);
+    } catch (sql::SQLException &e) {
+        cerr << "Replica unavailable, reading from primary: " << e.what() << endl;
+        markReplicaDown();
+        return nullptr;
+    }
+}
+
+bool recentlyWrote(int customerId) {
+    Clock::time_point now = Clock::now();
+    if (threadHasWritten && now - threadLastWrite < stickyWindow()) return true;
+    if (customerId <= 0) return false;
+
+    lock_guard<mutex> lock(writesMutex);
+    auto it = lastWriteByCustomer.find(customerId);
+    return it != lastWriteByCustomer.end() && now - it->second < stickyWindow();
+}
+
+} // namespace
+
+sql::Connection* openConnection(const DBEndpoint &ep) {
+    sql::mysql::MySQL_Driver* driver = sql::mysql::get_mysql_driver_instance();
+    sql::Connection* con = driver->connect(ep.url, ep.user, ep.password);
+    try {
+        con->setSchema(ep.schema);
+    } catch (sql::SQLException &) {
+        delete con;
+        throw;
+    }
+    return con;
+}
+
+bool dbEndpoint(DBRole role, DBEndpoint &out) {
+    if (role == DB_REPLICA) {
+        out.url = envOr("PROJECT1_DB_REPLICA", "");
+        if (out.url.empty()) return false;
+    } else {
+        out.url = envOr("PROJECT1_DB_PRIMARY", "tcp://127.0.0.1:3306");
+    }
+    // update username/password as necessary
+    out.user = envOr("PROJECT1_DB_USER", "root");
+    out.password = envOr("PROJECT1_DB_PASSWORD", "Password");   //give the mysql password
+    out.schema = envOr("PROJECT1_DB_SCHEMA", "DB Name");        //make sure all the required tables are in this database
+    return true;
+}
+
+sql::Connection* createReadConnection() {
+    sql::Connection* con = openReplica();
+    if (con) return con;
+
+    DBEndpoint ep;
+    dbEndpoint(DB_PRIMARY, ep);
+    return openConnection(ep);
+}
+
+sql::Connection* routeRead(sql::Connection* primary, int customerId) {
+    if (recentlyWrote(customerId)) return primary;
+
+    sql::Connection* &replica = threadReplica.con;
+    if (replica) {
+        // reuse it as is; a server round trip only every REPLICA_PROBE_SECONDS
+        Clock::time_point now = Clock::now();
+        if (now - threadReplica.probedAt < chrono::seconds(REPLICA_PROBE_SECONDS)) return replica;
+
+        bool alive = false;
+        try {
+            alive = replica->isValid() || replica->reconnect();
+        } catch (sql::SQLException &) {}
+        if (alive) {
+            threadReplica.probedAt = now;
+            return replica;
+        }
+
+        delete replica;
+        replica = nullptr;
+        markReplicaDown();
+        return primary;
+    }
+
+    replica = openReplica();
+    if (!replica) return primary;
+    threadReplica.probedAt = Clock::now();
+    return replica;
+}
+
+void noteWrite(int customerId) {
+    Clock::time_point now = Clock::now();
+    threadLastWrite = now;
+    threadHasWritten = true;
+    if (customerId <= 0) return;
+
+    lock_guard<mutex> lock(writesMutex);
+    lastWriteByCustomer[customerId] = now;
+
+    // keep the map small: drop entries whose window has passed
+    if (lastWriteByCustomer.size() > 4096) {
+        for (auto it = lastWriteByCustomer.begin(); it != lastWriteByCustomer.end(); ) {
+            if (now - it->second >= stickyWindow()) it = lastWriteByCustomer.erase(it);
+            else ++it;
+        }
+    }
+}
@@ -0,0 +1,720 @@
+// DataGenerator.cpp
+// Deterministic, skewed synthetic data written with parallel multi-row inserts
+
+#include "DataGenerator.h"
+#include "BatchInsert.h"
+#include "DBFunctions.h"
+#include "PasswordHasher.h"
+#include "Date.h"
+
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+// -----------------------------
+// Counter-based randomness: each row gets its own stream
+// -----------------------------
+uint64_t splitmix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+enum Stream : uint64_t {
+    S_SUPPLIER = 1, S_PRODUCT, S_CUSTOMER, S_CART, S_WISHLIST, S_ORDER,
+    S_PERMUTE
+};
+
+class RowRng {
+    uint64_t state;
+public:
+    RowRng(uint64_t seed, Stream stream, uint64_t row)
+        : state(splitmix(splitmix(seed ^ (stream << 56)) ^ row)) {}
+
+    uint64_t next() { state = splitmix(state); return state; }
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }   // [0, 1)
+    uint64_t below(uint64_t n) { return n ? next() % n : 0; }
+    double normal() {
+        double u1 = uniform(), u2 = uniform();
+        return sqrt(-2.0 * log(1.0 - u1)) * cos(6.283185307179586 * u2);
+    }
+    template <typename T, size_t N>
+    const T& pick(const T (&arr)[N]) { return arr[below(N)]; }
+};
+
+// Zipf(n, s) over ranks 1..n by rejection-inversion (Hormann & Derflinger),
+// O(1) per sample with no tables, so it works for tens of millions of ranks.
+class Zipf {
+    double n, s, hX1, hN, sConst;
+
+    static double helper1(double x) {   // log1p(x) / x
+        return fabs(x) > 1e-8 ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+    static double helper2(double x) {   // expm1(x) / x
+        return fabs(x) > 1e-8 ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+    }
+    double h(double x) const { return exp(-s * log(x)); }
+    double hIntegral(double x) const {
+        double lx = log(x);
+        return helper2((1.0 - s) * lx) * lx;
+    }
+    double hIntegralInverse(double x) const {
+        double t = x * (1.0 - s);
+        if (t < -1.0) t = -1.0;
+        return exp(helper1(t) * x);
+    }
+
+public:
+    Zipf(uint64_t count, double exponent) : n((double)max<uint64_t>(count, 1)), s(exponent) {
+        hX1 = hIntegral(1.5) - 1.0;
+        hN = hIntegral(n + 0.5);
+        sConst = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    // 1..n
+    uint64_t sample(RowRng &rng) const {
+        if (s <= 0.0) return 1 + rng.below((uint64_t)n);
+        while (true) {
+            double u = hN + rng.uniform() * (hX1 - hN);
+            double x = hIntegralInverse(u);
+            double k = floor(x + 0.5);
+            if (k < 1.0) k = 1.0;
+            else if (k > n) k = n;
+            if (k - x <= sConst || u >= hIntegral(k + 0.5) - h(k))
+                return (uint64_t)k;
+        }
+    }
+};
+
+// rank -> row spread over [0, n), so popular items are not all the low ids
+class Scatter {
+    uint64_t n, a, b;
+public:
+    Scatter(uint64_t count, uint64_t seed) : n(max<uint64_t>(count, 1)) {
+        a = (splitmix(seed) % n) | 1;
+        while (gcd(a, n) != 1) a += 2;
+        a %= n;
+        if (a == 0) a = 1;
+        b = splitmix(seed + 1) % n;
+    }
+    uint64_t operator()(uint64_t rank) const {
+        return (uint64_t)(((unsigned __int128)(rank - 1) * a + b) % n);
+    }
+};
+
+// -----------------------------
+// Reference data
+// -----------------------------
+struct Group {
+    const char* category;
+    const char* subcategory;
+    double basePrice;
+    int shelfDays;      // 0 = no expiry
+    const char* unit;
+};
+
+const Group GROUPS[] = {
+    {"Dairy", "Milk", 30, 7, "ml"},           {"Dairy", "Curd", 40, 10, "g"},
+    {"Dairy", "Cheese", 120, 90, "g"},        {"Dairy", "Butter", 55, 120, "g"},
+    {"Bakery", "Bread", 45, 5, "g"},          {"Bakery", "Cakes", 150, 10, "g"},
+    {"Bakery", "Cookies", 35, 180, "g"},      {"Beverages", "Tea", 180, 365, "g"},
+    {"Beverages", "Coffee", 250, 365, "g"},   {"Beverages", "Juice", 110, 120, "ml"},
+    {"Beverages", "Soft Drinks", 40, 180, "ml"},
+    {"Snacks", "Chips", 20, 120, "g"},        {"Snacks", "Namkeen", 45, 150, "g"},
+    {"Snacks", "Chocolates", 60, 270, "g"},   {"Staples", "Rice", 90, 540, "kg"},
+    {"Staples", "Atta", 60, 180, "kg"},       {"Staples", "Dal", 120, 365, "kg"},
+    {"Staples", "Oil", 160, 365, "L"},        {"Personal Care", "Soap", 35, 0, "g"},
+    {"Personal Care", "Shampoo", 140, 0, "ml"},
+    {"Personal Care", "Toothpaste", 90, 0, "g"},
+    {"Household", "Detergent", 120, 0, "kg"}, {"Household", "Cleaners", 95, 0, "ml"},
+    {"Baby Care", "Diapers", 450, 0, "pcs"},  {"Baby Care", "Baby Food", 280, 365, "g"},
+};
+const size_t GROUP_COUNT = sizeof(GROUPS) / sizeof(GROUPS[0]);
+
+const char* VARIANTS[] = {
+    "Classic", "Fresh", "Premium", "Organic", "Lite", "Gold", "Family Pack",
+    "Natural", "Select", "Daily", "Rich", "Pure", "Extra", "Value", "Royal",
+};
+const int SIZES[] = { 1, 2, 5, 100, 150, 200, 250, 400, 500, 750 };
+
+const char* SYLLABLES[] = {
+    "ka", "ve", "lo", "ra", "mi", "su", "ta", "no", "ri", "da", "po", "li",
+    "sha", "ne", "ko", "ma", "vi", "tu", "ba", "ze", "an", "or", "el", "ya",
+};
+const size_t SYLLABLE_COUNT = sizeof(SYLLABLES) / sizeof(SYLLABLES[0]);
+
+const char* FIRST_NAMES[] = {
+    "Aarav", "Vivaan", "Aditya", "Arjun", "Sai", "Reyansh", "Krishna", "Ishaan",
+    "Rohan", "Kabir", "Ananya", "Diya", "Saanvi", "Aadhya", "Pari", "Myra",
+    "Priya", "Neha", "Kavya", "Riya", "Meera", "Sneha", "Rahul", "Vikram",
+};
+const char* LAST_NAMES[] = {
+    "Sharma", "Verma", "Gupta", "Singh", "Kumar", "Patel", "Reddy", "Iyer",
+    "Nair", "Das", "Mehta", "Joshi", "Rao", "Khan", "Bose", "Kapoor",
+};
+struct City { const char* city; const char* state; int pinPrefix; };
+const City CITIES[] = {
+    {"Delhi", "Delhi", 110}, {"Mumbai", "Maharashtra", 400}, {"Pune", "Maharashtra", 411},
+    {"Bengaluru", "Karnataka", 560}, {"Chennai", "Tamil Nadu", 600},
+    {"Hyderabad", "Telangana", 500}, {"Kolkata", "West Bengal", 700},
+    {"Jaipur", "Rajasthan", 302}, {"Lucknow", "Uttar Pradesh", 226},
+    {"Ahmedabad", "Gujarat", 380}, {"Kochi", "Kerala", 682}, {"Indore", "Madhya Pradesh", 452},
+};
+const char* STREETS[] = {
+    "MG Road", "Station Road", "Park Street", "Ring Road", "Lake View", "Gandhi Nagar",
+    "Civil Lines", "Sector 12", "Main Bazaar", "Temple Street", "Hill Road",
+};
+
+// Brand names are built from syllables so their count can scale freely
+string brandName(uint64_t brand) {
+    string s;
+    uint64_t b = brand;
+    int parts = 2 + (int)(splitmix(brand) % 2);
+    for (int i = 0; i < parts; ++i) {
+        s += SYLLABLES[b % SYLLABLE_COUNT];
+        b = b / SYLLABLE_COUNT + splitmix(brand + i) % 7;
+    }
+    s[0] = (char)toupper((unsigned char)s[0]);
+    if (brand >= SYLLABLE_COUNT * SYLLABLE_COUNT) s += " " + to_string(brand % 97);
+    return s;
+}
+
+// -----------------------------
+// Dates (days since 1970-01-01, see Date.h)
+// -----------------------------
+string dayText(long day) {
+    return Date::fromDays((int32_t)day).toSQL();
+}
+
+bool parseDay(const string &s, long &days) {
+    Date d = Date::fromSQL(s);
+    if (!d.isSet()) return false;
+    days = d.toDays();
+    return true;
+}
+
+// -----------------------------
+// Generation context (read-only once built, shared by all threads)
+// -----------------------------
+struct Context {
+    GenOptions opt;
+    long asOfDay = 0;
+    string passwordHash;
+
+    // first new id per table (MAX(id) + 1)
+    uint64_t supplierBase = 1, productBase = 1, customerBase = 1, orderBase = 1;
+
+    unique_ptr<Zipf> productPop, brandPop, supplierPop, buyerPop;
+    unique_ptr<Scatter> productScatter, buyerScatter;
+
+    uint64_t popularProduct(RowRng &rng) const {
+        return productBase + (*productScatter)(productPop->sample(rng));
+    }
+    uint64_t activeCustomer(RowRng &rng) const {
+        return customerBase + (*buyerScatter)(buyerPop->sample(rng));
+    }
+};
+
+double roundPrice(double p) {
+    return max(1.0, floor(p * 2.0 + 0.5) / 2.0);    // nearest 0.50
+}
+
+struct ProductInfo {
+    string name, category, subcategory, company, expiry;
+    double price;
+    int stock;
+    uint64_t sid;
+};
+
+// Pure function of (seed, product row); order lines reuse it for prices
+ProductInfo productInfo(const Context &ctx, uint64_t row) {
+    RowRng rng(ctx.opt.seed, S_PRODUCT, row);
+    const Group &g = GROUPS[rng.below(GROUP_COUNT)];
+
+    ProductInfo p;
+    p.company = brandName(ctx.brandPop->sample(rng));
+    int size = rng.pick(SIZES);
+    p.name = p.company + " " + rng.pick(VARIANTS) + " " + g.subcategory + " "
+           + to_string(size) + " " + g.unit;
+    p.category = g.category;
+    p.subcategory = g.subcategory;
+    p.price = roundPrice(g.basePrice * exp(0.45 * rng.normal()));
+    p.stock = rng.uniform() < 0.05 ? 0 : (int)rng.below(500) + 1;
+    p.sid = ctx.supplierBase + ctx.supplierPop->sample(rng) - 1;
+    if (g.shelfDays > 0)
+        p.expiry = dayText(ctx.asOfDay + 1 + (long)rng.below((uint64_t)g.shelfDays * 2));
+    return p;
+}
+
+// -----------------------------
+// Buffered multi-row writer; a null connection only digests (dry run)
+// -----------------------------
+class TableWriter {
+    struct Value {
+        enum Kind { INT, DOUBLE, STRING, NUL } kind;
+        int64_t i;
+        double d;
+        string s;
+    };
+
+    sql::Connection* con;
+    unique_ptr<MultiRowStatement> stmt;
+    int columns;
+    size_t batchRows;
+    vector<Value> pending;
+    uint64_t rowDigest = 0xCBF29CE484222325ULL;
+
+    void digest(const void* p, size_t n) {
+        const unsigned char* b = (const unsigned char*)p;
+        for (size_t k = 0; k < n; ++k) rowDigest = (rowDigest ^ b[k]) * 0x100000001B3ULL;
+    }
+
+public:
+    size_t rows = 0;
+    uint64_t checksum = 0;
+
+    TableWriter(sql::Connection* c, const string &prefix, int cols, size_t batch,
+                const string &suffix = "")
+        : con(c), columns(cols), batchRows(batch) {
+        if (con) stmt.reset(new MultiRowStatement(con, prefix, cols, batch, suffix));
+        pending.reserve(batch * cols);
+    }
+
+    void add(int64_t v) { pending.push_back({Value::INT, v, 0.0, string()}); digest(&v, sizeof(v)); }
+    void add(double v) { pending.push_back({Value::DOUBLE, 0, v, string()}); digest(&v, sizeof(v)); }
+    void add(const string &v) {
+        pending.push_back({Value::STRING, 0, 0.0, v});
+        digest(v.data(), v.size());
+        digest("", 1);
+    }
+    void addNull() { pending.push_back({Value::NUL, 0, 0.0, string()}); digest("\xff", 1); }
+    // bound but not digested (e.g. salted hashes, which differ run to run)
+    void addOpaque(const string &v) { pending.push_back({Value::STRING, 0, 0.0, v}); }
+
+    size_t pendingRows() const { return pending.size() / columns; }
+
+    void endRow() {
+        checksum += splitmix(rowDigest);
+        rowDigest = 0xCBF29CE484222325ULL;
+        ++rows;
+        if (pending.size() >= batchRows * columns) flush();
+    }
+
+    void flush() {
+        size_t n = pending.size() / columns;
+        if (n == 0) return;
+        if (con) {
+            sql::PreparedStatement* ps = stmt->begin(n);
+            for (size_t k = 0; k < pending.size(); ++k) {
+                const Value &v = pending[k];
+                unsigned int idx = (unsigned int)(k + 1);
+                switch (v.kind) {
+                case Value::INT: ps->setInt64(idx, v.i); break;
+                case Value::DOUBLE: ps->setDouble(idx, v.d); break;
+                case Value::STRING: ps->setString(idx, v.s); break;
+                case Value::NUL: ps->setNull(idx, sql::DataType::VARCHAR); break;
+                }
+            }
+            ps->executeUpdate();
+        }
+        pending.clear();
+    }
+};
+
+// -----------------------------
+// Per-table slice writers. Each handles rows [from, to) on its own
+// connection and commits once per batch.
+// -----------------------------
+using SliceFn = function<void(const Context&, sql::Connection*, uint64_t, uint64_t,
+                              vector<GenTableStats>&)>;
+
+void commit(sql::Connection* con) {
+    if (con) con->commit();
+}
+
+void supplierSlice(const Context &ctx, sql::Connection* con, uint64_t from, uint64_t to,
+                   vector<GenTableStats> &out) {
+    TableWriter w(con, "INSERT INTO Supplier (SID, Sname, Contact_Num, Email, Address)",
+                  5, ctx.opt.batchRows);
+    for (uint64_t i = from; i < to; ++i) {
+        RowRng rng(ctx.opt.seed, S_SUPPLIER, i);
+        uint64_t sid = ctx.supplierBase + i;
+        const City &city = rng.pick(CITIES);
+        string name = brandName(1000003 + i) + " " + (rng.below(2) ? "Distributors" : "Traders");
+
+        w.add((int64_t)sid);
+        w.add(name);
+        w.add(to_string(7000000000ULL + rng.below(2999999999ULL)));
+        w.add("orders@supplier" + to_string(sid) + ".example.test");
+        w.add(to_string(1 + rng.below(300)) + ", " + rng.pick(STREETS) + ", " + city.city);
+        w.endRow();
+        if (w.rows % ctx.opt.batchRows == 0) commit(con);
+    }
+    w.flush();
+    commit(con);
+    out.push_back({"Supplier", w.rows, 0.0, w.checksum});
+}
+
+void productSlice(const Context &ctx, sql::Connection* con, uint64_t from, uint64_t to,
+                  vector<GenTableStats> &out) {
+    TableWriter w(con,
+        "INSERT INTO PRODUCT (Product_ID, Product_Name, Category, Subcategory, "
+        "Price, Stock_Qtn, Company_name, ExpiryDate, SID)", 9, ctx.opt.batchRows);
+
+    for (uint64_t j = from; j < to; ++j) {
+        ProductInfo p = productInfo(ctx, j);
+        w.add((int64_t)(ctx.productBase + j));
+        w.add(p.name);
+        w.add(p.category);
+        w.add(p.subcategory);
+        w.add(p.price);
+        w.add((int64_t)p.stock);
+        w.add(p.company);
+        if (p.expiry.empty()) w.addNull(); else w.add(p.expiry);
+        w.add((int64_t)p.sid);
+        w.endRow();
+        if (w.rows % ctx.opt.batchRows == 0) commit(con);
+    }
+    w.flush();
+    commit(con);
+    out.push_back({"PRODUCT", w.rows, 0.0, w.checksum});
+}
+
+// CUSTOMER_DETAILS + LOGIN + 1..3 ADDRESS rows per customer
+void customerSlice(const Context &ctx, sql::Connection* con, uint64_t from, uint64_t to,
+                   vector<GenTableStats> &out) {
+    size_t batch = ctx.opt.batchRows;
+    TableWriter cw(con, "INSERT INTO CUSTOMER_DETAILS (ID, Name, Contact_Num, Email, Address)",
+                   5, batch);
+    TableWriter lw(con, "INSERT INTO `LOGIN` (Email, Password)", 2, batch);
+    TableWriter aw(con,
+        "INSERT INTO ADDRESS (CustomerID, AddressLine, City, State, PostalCode, Country, IsDefault)",
+        7, batch);
+
+    struct Addr { string line; const City* city; int pin; };
+    vector<Addr> addrs;
+
+    for (uint64_t c = from; c < to; ++c) {
+        RowRng rng(ctx.opt.seed, S_CUSTOMER, c);
+        uint64_t id = ctx.customerBase + c;
+        string first = rng.pick(FIRST_NAMES), last = rng.pick(LAST_NAMES);
+        string email = first + "." + last + "." + to_string(id) + "@example.test";
+        for (auto &ch : email) ch = (char)tolower((unsigned char)ch);
+
+        addrs.clear();
+        int addresses = 1 + (int)rng.below(3);
+        for (int a = 0; a < addresses; ++a) {
+            const City &city = rng.pick(CITIES);
+            addrs.push_back({to_string(1 + rng.below(999)) + ", " + rng.pick(STREETS), &city,
+                             city.pinPrefix * 1000 + (int)rng.below(1000)});
+        }
+
+        cw.add((int64_t)id);
+        cw.add(first + " " + last);
+        cw.add(to_string(6000000000ULL + rng.below(3999999999ULL)));
+        cw.add(email);
+        cw.add(addrs[0].line + ", " + addrs[0].city->city);
+        cw.endRow();
+
+        lw.add(email);
+        lw.addOpaque(ctx.passwordHash);
+        lw.endRow();
+
+        // an ADDRESS flush must never run ahead of its CUSTOMER_DETAILS row
+        if (aw.pendingRows() + addrs.size() >= batch) cw.flush();
+
+        for (size_t a = 0; a < addrs.size(); ++a) {
+            aw.add((int64_t)id);
+            aw.add(addrs[a].line);
+            aw.add(string(addrs[a].city->city));
+            aw.add(string(addrs[a].city->state));
+            aw.add(to_string(addrs[a].pin));
+            aw.add(string("India"));
+            aw.add((int64_t)(a == 0 ? 1 : 0));
+            aw.endRow();
+        }
+
+        if (cw.rows % batch == 0) {
+            cw.flush();
+            lw.flush();
+            aw.flush();
+            commit(con);
+        }
+    }
+    cw.flush();
+    lw.flush();
+    aw.flush();
+    commit(con);
+    out.push_back({"CUSTOMER_DETAILS", cw.rows, 0.0, cw.checksum});
+    out.push_back({"LOGIN", lw.rows, 0.0, lw.checksum});
+    out.push_back({"ADDRESS", aw.rows, 0.0, aw.checksum});
+}
+
+// Cart and WISHLIST: customer i % customers, Zipfian product; duplicates of
+// (customer, product) are skipped by INSERT IGNORE
+void cartSlice(const Context &ctx, sql::Connection* con, uint64_t from, uint64_t to,
+               vector<GenTableStats> &out) {
+    TableWriter w(con, "INSERT IGNORE INTO Cart (Customer_ID, Product_ID, Quantity)",
+                  3, ctx.opt.batchRows);
+    for (uint64_t i = from; i < to; ++i) {
+        RowRng rng(ctx.opt.seed, S_CART, i);
+        w.add((int64_t)(ctx.customerBase + i % ctx.opt.customers));
+        w.add((int64_t)ctx.popularProduct(rng));
+        w.add((int64_t)(1 + (rng.uniform() < 0.8 ? 0 : rng.below(4))));
+        w.endRow();
+        if (w.rows % ctx.opt.batchRows == 0) commit(con);
+    }
+    w.flush();
+    commit(con);
+    out.push_back({"Cart", w.rows, 0.0, w.checksum});
+}
+
+void wishlistSlice(const Context &ctx, sql::Connection* con, uint64_t from, uint64_t to,
+                   vector<GenTableStats> &out) {
+    TableWriter w(con, "INSERT IGNORE INTO WISHLIST (CustomerID, ProductID)",
+                  2, ctx.opt.batchRows);
+    for (uint64_t i = from; i < to; ++i) {
+        RowRng rng(ctx.opt.seed, S_WISHLIST, i);
+        w.add((int64_t)(ctx.customerBase + i % ctx.opt.customers));
+        w.add((int64_t)ctx.popularProduct(rng));
+        w.endRow();
+        if (w.rows % ctx.opt.batchRows == 0) commit(con);
+    }
+    w.flush();
+    commit(con);
+    out.push_back({"WISHLIST", w.rows, 0.0, w.checksum});
+}
+
+// Orders + their OrderItems. Order k gets orderItems / orders lines (the
+// first orderItems % orders orders one more) and is dated by its position,
+// so OrderID order matches date order.
+void orderSlice(const Context &ctx, sql::Connection* con, uint64_t from, uint64_t to,
+                vector<GenTableStats> &out) {
+    const GenOptions &opt = ctx.opt;
+    TableWriter ow(con,
+        "INSERT INTO Orders (OrderID, CustomerID, OrderDate, DeliveryDate, TotalAmount)",
+        5, opt.batchRows);
+    TableWriter iw(con,
+        "INSERT INTO OrderItems (OrderID, ProductID, Quantity, PriceAtPurchase, Subtotal)",
+        5, opt.batchRows);
+
+    uint64_t perOrder = opt.orderItems / opt.orders;
+    uint64_t extra = opt.orderItems % opt.orders;
+    const long spanDays = 730;
+
+    struct Line { uint64_t product; int64_t qty; double price; };
+    vector<Line> lines;
+
+    for (uint64_t k = from; k < to; ++k) {
+        RowRng rng(ctx.opt.seed, S_ORDER, k);
+        uint64_t orderId = ctx.orderBase + k;
+        long day = ctx.asOfDay - spanDays + (long)(k * spanDays / opt.orders);
+
+        lines.clear();
+        uint64_t count = perOrder + (k < extra ? 1 : 0);
+        double total = 0.0;
+        for (uint64_t l = 0; l < count; ++l) {
+            uint64_t pid = ctx.popularProduct(rng);
+            for (int retry = 0; retry < 3; ++retry) {     // avoid repeats within an order
+                bool seen = false;
+                for (auto &x : lines) seen = seen || x.product == pid;
+                if (!seen) break;
+                pid = ctx.popularProduct(rng);
+            }
+            double price = productInfo(ctx, pid - ctx.productBase).price;
+            int64_t qty = 1 + (rng.uniform() < 0.7 ? 0 : (int64_t)rng.below(3));
+            lines.push_back({pid, qty, price});
+            total += price * qty;
+        }
+
+        ow.add((int64_t)orderId);
+        ow.add((int64_t)ctx.activeCustomer(rng));
+        ow.add(dayText(day));
+        ow.add(dayText(day + 4));
+        ow.add(total);
+        ow.endRow();
+
+        // an OrderItems flush must never run ahead of its Orders row
+        if (iw.pendingRows() + lines.size() >= opt.batchRows) ow.flush();
+
+        for (auto &x : lines) {
+            iw.add((int64_t)orderId);
+            iw.add((int64_t)x.product);
+            iw.add(x.qty);
+            iw.add(x.price);
+            iw.add(x.price * x.qty);
+            iw.endRow();
+        }
+
+        if (ow.rows % opt.batchRows == 0) {
+            ow.flush();
+            iw.flush();
+            commit(con);
+        }
+    }
+    ow.flush();
+    iw.flush();
+    commit(con);
+    out.push_back({"Orders", ow.rows, 0.0, ow.checksum});
+    out.push_back({"OrderItems", iw.rows, 0.0, iw.checksum});
+}
+
+// Splits [0, count) over the writer connections; stats from all slices are
+// summed per table. Items added to a table from parallel slices stay
+// reproducible because the checksum is an order-independent sum.
+bool runPhase(const Context &ctx, uint64_t count, SliceFn fn, GenStats &stats) {
+    if (count == 0) return true;
+    auto t0 = chrono::steady_clock::now();
+
+    int writers = max(1, ctx.opt.writerConnections);
+    if ((uint64_t)writers > count) writers = (int)count;
+
+    vector<vector<GenTableStats>> results(writers);
+    vector<char> ok(writers, 1);
+    vector<thread> threads;
+
+    for (int w = 0; w < writers; ++w) {
+        uint64_t from = count * w / writers;
+        uint64_t to = count * (w + 1) / writers;
+        threads.emplace_back([&, w, from, to] {
+            sql::Connection* con = nullptr;
+            try {
+                if (!ctx.opt.dryRun) {
+                    con = createConnection();
+                    con->setAutoCommit(false);
+                }
+                fn(ctx, con, from, to, results[w]);
+            } catch (sql::SQLException &e) {
+                cerr << "SQL Error in generateDataset: " << e.what() << endl;
+                ok[w] = 0;
+            }
+            if (con) {
+                con->close();
+                delete con;
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    bool allOk = true;
+    vector<GenTableStats> merged;
+    for (int w = 0; w < writers; ++w) {
+        allOk = allOk && ok[w];
+        for (auto &r : results[w]) {
+            auto it = find_if(merged.begin(), merged.end(),
+                              [&](const GenTableStats &m) { return m.table == r.table; });
+            if (it == merged.end()) {
+                merged.push_back(r);
+            } else {
+                it->rows += r.rows;
+                it->checksum += r.checksum;
+            }
+        }
+    }
+    for (auto &m : merged) {
+        m.seconds = seconds;
+        stats.tables.push_back(m);
+    }
+    return allOk;
+}
+
+uint64_t nextId(sql::Connection* con, const string &table, const string &column) {
+    sql::Statement* stmt = con->createStatement();
+    sql::ResultSet* res = stmt->executeQuery(
+        "SELECT COALESCE(MAX(" + column + "), 0) FROM " + table);
+    uint64_t next = res->next() ? (uint64_t)res->getInt64(1) + 1 : 1;
+    delete res;
+    delete stmt;
+    return next;
+}
+
+} // namespace
+
+// ---------------------------------------------
+// PUBLIC
+// ---------------------------------------------
+bool generateDataset(const GenOptions &opt, GenStats &stats) {
+    auto t0 = chrono::steady_clock::now();
+
+    Context ctx;
+    ctx.opt = opt;
+    ctx.opt.batchRows = min<size_t>(max<size_t>(opt.batchRows, 1), 7000);  // < 65535 placeholders
+    if (ctx.opt.brands == 0) ctx.opt.brands = max<size_t>(20, opt.products / 100);
+
+    if (!parseDay(opt.asOf, ctx.asOfDay)) {
+        cerr << "Invalid as-of date: " << opt.asOf << " (expected YYYY-MM-DD)\n";
+        return false;
+    }
+    if (opt.products == 0 && (opt.cartRows || opt.wishlistRows || opt.orderItems)) {
+        cerr << "Cart, wishlist and order rows need at least one product.\n";
+        return false;
+    }
+    if (opt.customers == 0 && (opt.cartRows || opt.wishlistRows || opt.orders)) {
+        cerr << "Cart, wishlist and orders need at least one customer.\n";
+        return false;
+    }
+    if (opt.products > 0 && opt.suppliers == 0) {
+        cerr << "Products need at least one supplier.\n";
+        return false;
+    }
+
+    if (!opt.dryRun) {
+        sql::Connection* con = nullptr;
+        try {
+            con = createConnection();
+            ctx.supplierBase = nextId(con, "Supplier", "SID");
+            ctx.productBase = nextId(con, "PRODUCT", "Product_ID");
+            ctx.customerBase = nextId(con, "CUSTOMER_DETAILS", "ID");
+            ctx.orderBase = nextId(con, "Orders", "OrderID");
+            con->close();
+            delete con;
+        } catch (sql::SQLException &e) {
+            cerr << "SQL Error in generateDataset: " << e.what() << endl;
+            if (con) delete con;
+            return false;
+        }
+    }
+
+    // one hash shared by every generated login (hashing millions would take hours)
+    ctx.passwordHash = PasswordHasher::instance().hash(opt.password);
+    if (ctx.passwordHash.empty()) {
+        cerr << "Password hashing is busy.\n";
+        return false;
+    }
+
+    uint64_t seed = opt.seed;
+    ctx.productPop.reset(new Zipf(max<size_t>(opt.products, 1), opt.zipfExponent));
+    ctx.brandPop.reset(new Zipf(ctx.opt.brands, opt.zipfExponent));
+    ctx.supplierPop.reset(new Zipf(max<size_t>(opt.suppliers, 1), opt.zipfExponent));
+    ctx.buyerPop.reset(new Zipf(max<size_t>(opt.customers, 1), opt.zipfExponent * 0.6));
+    ctx.productScatter.reset(new Scatter(max<size_t>(opt.products, 1), splitmix(seed ^ S_PERMUTE)));
+    ctx.buyerScatter.reset(new Scatter(max<size_t>(opt.customers, 1), splitmix(seed ^ (S_PERMUTE << 8))));
+
+    // parents before children
+    bool ok = runPhase(ctx, opt.suppliers, supplierSlice, stats)
+           && runPhase(ctx, opt.products, productSlice, stats)
+           && runPhase(ctx, opt.customers, customerSlice, stats)
+           && runPhase(ctx, opt.cartRows, cartSlice, stats)
+           && runPhase(ctx, opt.wishlistRows, wishlistSlice, stats)
+           && runPhase(ctx, opt.orders, orderSlice, stats);
+
+    stats.totalSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    return ok;
+}
@@ -1,19 +1,49 @@
 #include "Date.h"
+#include <ctime>
 
-Date::Date() {}
+namespace {
 
-Date::Date(int d, int m, int y) {
-    day = d;
-    month = m;
-    year = y;
+// n decimal digits at s, or -1
+int digits(const string &s, size_t pos, size_t n) {
+    int v = 0;
+    for (size_t i = pos; i < pos + n; ++i) {
+        if (s[i] < '0' || s[i] > '9') return -1;
+        v = v * 10 + (s[i] - '0');
+    }
+    return v;
 }
 
-void Date::setDate(int d, int m, int y) {
-    day = d;
-    month = m;
-    year = y;
+} // namespace
+
+Date Date::fromSQL(const string &s) {
+    if (s.size() < 10 || s[4] != '-' || s[7] != '-') return Date();
+    int y = digits(s, 0, 4), m = digits(s, 5, 2), d = digits(s, 8, 2);
+    if (y < 0 || m < 1 || m > 12 || d < 1 || d > 31) return Date();
+    return Date(d, m, y);
+}
+
+Date Date::today() {
+    time_t now = time(nullptr);
+    struct tm tmv;
+#ifdef _WIN32
+    localtime_s(&tmv, &now);
+#else
+    localtime_r(&now, &tmv);
+#endif
+    return Date(tmv.tm_mday, tmv.tm_mon + 1, tmv.tm_year + 1900);
 }
 
-string Date::toSQL() {
-    return to_string(year) + "-" + to_string(month) + "-" + to_string(day);
-}
\ No newline at end of file
+// "YYYY-MM-DD", or "" for an unset date (NULL in the DB)
+string Date::toSQL() const {
+    if (!isSet()) return "";
+    CivilDate c = civilFromDays(days);
+    if (c.year < 0 || c.year > 9999) return "";
+
+    char buf[10] = { 0, 0, 0, 0, '-', 0, 0, '-', 0, 0 };
+    for (int i = 3, y = c.year; i >= 0; --i, y /= 10) buf[i] = (char)('0' + y % 10);
+    buf[5] = (char)('0' + c.month / 10);
+    buf[6] = (char)('0' + c.month % 10);
+    buf[8] = (char)('0' + c.day / 10);
+    buf[9] = (char)('0' + c.day % 10);
+    return string(buf, sizeof(buf));
+}
@@ -0,0 +1,36 @@
+// ExpiryIndex.cpp
+#include "ExpiryIndex.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void ExpiryIndex::add(int productId, Date expiry) {
+    if (!expiry.isSet()) return;            // no expiry (non-perishables)
+    entries.push_back({ expiry.toDays(), productId });
+}
+
+void ExpiryIndex::finish() {
+    sort(entries.begin(), entries.end());
+}
+
+vector<int> ExpiryIndex::expiringBetween(Date from, Date to) const {
+    vector<int> out;
+    if (!from.isSet() || !to.isSet() || to < from) return out;
+
+    auto lo = lower_bound(entries.begin(), entries.end(), Entry{ from.toDays(), INT32_MIN });
+    auto hi = upper_bound(lo, entries.end(), Entry{ to.toDays(), INT32_MAX });
+
+    out.reserve((size_t)(hi - lo));
+    for (auto it = lo; it != hi; ++it) out.push_back(it->productId);
+    return out;
+}
+
+vector<int> ExpiryIndex::expiredBefore(Date today) const {
+    vector<int> out;
+    auto hi = lower_bound(entries.begin(), entries.end(), Entry{ today.toDays(), INT32_MIN });
+
+    out.reserve((size_t)(hi - entries.begin()));
+    for (auto it = entries.begin(); it != hi; ++it) out.push_back(it->productId);
+    return out;
+}
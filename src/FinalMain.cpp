@@ -3,12 +3,35 @@
 #include "DBFunctions.h"
 #include "Functions.h"
 #include "CartFunctions.h"
+#include "CatalogSnapshot.h"
+#include "CatalogCache.h"
+#include "Recommendations.h"
+#include "WishlistFunctions.h"
+#include "ProductPrefetch.h"
+#include "QueryCache.h"
+#include "ChangeFeed.h"
+#include "DBRouter.h"
 
 #include <iostream>
 #include <string>
 #include <limits>
 
 using namespace std;
+
+// Catalog snapshot: serve browsing from it if younger than a day; the
+// background writer re-checks it against the DB every few minutes.
+static const long SNAPSHOT_MAX_AGE_SECONDS = 24 * 60 * 60;
+static const int SNAPSHOT_REFRESH_SECONDS = 300;
+
+// Connections used to warm the catalog cache while the user logs in
+static const int WARMUP_CONNECTIONS = 4;
+
+// Co-purchase index: pick up other instances' orders and persist this often
+static const int RECOMMENDATIONS_SAVE_SECONDS = 600;
+
+// Change feed: how often CHANGE_LOG is polled for cache invalidations
+static const int CHANGE_FEED_POLL_MS = 1000;
+
 int main() {
     sql::Connection* con = nullptr;
     try {
@@ -18,9 +41,26 @@ int main() {
         return 1;
     }
 
+    string snapshotPath = defaultSnapshotPath();
+    auto snapshot = make_shared<CatalogSnapshot>();
+    if (snapshot->open(snapshotPath) && !snapshot->isStale(nullptr, SNAPSHOT_MAX_AGE_SECONDS))
+        setActiveCatalogSnapshot(snapshot);
+
+    // Changes after this point reach the caches warmed below
+    int64_t changeFeedStart = changeLogPosition(routeRead(con));
+
+    // Warm the catalog cache in the background while the welcome and login
+    // screens are up; the destructor waits for it on every exit path.
+    CatalogWarmup warmup(WARMUP_CONNECTIONS);
+    warmup.start();
+
     int userType;
     string email, password;
     int customerId = -1;
+    CustomerSession session;
+
+    // A valid signed token from an earlier login lets the user straight in
+    bool canResume = loadSavedSession(session);
 
     clearScreen();
     cout << "==============================\n";
@@ -28,6 +68,8 @@ int main() {
     cout << "==============================\n\n";
     cout << "1) New User\n";
     cout << "2) Existing User\n";
+    if (canResume)
+        cout << "3) Continue as " << session.email << "\n";
     cout << "0) Exit\n\n";
 
     userType = getIntInput("Enter your choice: ");
@@ -48,25 +90,19 @@ int main() {
         cout << "Create Password: ";
         cin >> password;
 
-        // Create login record for new user
-        if (!registerNewLogin(con, email, password)) {
-            cout << "❌ Failed to create login.\n";
-            return 1;
-        }
-
         cin.ignore(numeric_limits<std::streamsize>::max(), '\n');
         clearScreen();
 
-        // Enter customer details
-        inputCustomerDetails(con, email);
-
-        // Fetch the newly inserted customer ID
-        customerId = getLastInsertedCustomerID(con);
-        if (customerId == -1) {
-            cout << "❌ Could not get Customer ID.\n";
+        // Enter customer details, then create login + profile together
+        Customer c = promptCustomerDetails(email);
+        if (!registerCustomer(con, c, password, session)) {
+            cout << "❌ Failed to create account.\n";
             return 1;
         }
 
+        customerId = session.customerId;
+        saveSessionToken(issueSessionToken(session));
+
         cout << "✔ Profile created! Customer ID = " << customerId << "\n";
         pressEnterToContinue();
     }
@@ -77,27 +113,57 @@ int main() {
     else if (userType == 2) {
 
         cout << "\n=== LOGIN ===\n";
-        if (!loginWindow(con, email)) {
-            cout << "❌ Login failed.\n";
-            return 1;
-        }
+        LoginResult r = loginWindow(con, session);
 
-        // Fetch existing customer ID
-        customerId = getCustomerIdByEmail(con, email);
-        if (customerId == -1) {
+        if (r == LOGIN_NO_PROFILE) {
             cout << "❌ No customer details found.\n";
             cout << "Please create a new account.\n";
             return 1;
         }
+        if (r != LOGIN_OK) {
+            cout << "❌ Login failed.\n";
+            return 1;
+        }
+
+        customerId = session.customerId;
+        saveSessionToken(issueSessionToken(session));
 
         cout << "✔ Login successful! Customer ID = " << customerId << "\n";
+        if (session.cartItems > 0)
+            cout << "🛒 " << session.cartItems << " item(s) waiting in your cart.\n";
+        pressEnterToContinue();
+    }
+
+    // =================================================
+    // RETURNING USER (signed session token, no DB lookup)
+    // =================================================
+    else if (userType == 3 && canResume) {
+        customerId = session.customerId;
+        cout << "✔ Welcome back, " << (session.name.empty() ? session.email : session.name) << "!\n";
         pressEnterToContinue();
     }
 
+    else {
+        cout << "Invalid choice.\n";
+        return 1;
+    }
+
     // =================================================
     // INTO THE MAIN APPLICATION (PRODUCTS / CART)
     // =================================================
+    startSnapshotWriter(snapshotPath, SNAPSHOT_REFRESH_SECONDS);
+    if (changeFeedStart >= 0)
+        startChangeFeed(changeFeedStart, CHANGE_FEED_POLL_MS, WARMUP_CONNECTIONS);
+    else
+        cerr << "Change feed off: CHANGE_LOG not readable (change_feed --install creates it)." << endl;
+    startRecommendationService(defaultRecommendationsPath(), RECOMMENDATIONS_SAVE_SECONDS);
+    loadWishlistMembership(con, customerId);
     runCategoryMenu(con, customerId);
+    stopChangeFeed();
+    stopProductPrefetcher();
+    logResultCacheStats();
+    stopRecommendationService();
+    stopSnapshotWriter();
 
     // Close DB
     if (con) {
@@ -3,8 +3,16 @@
 #include "DBFunctions.h"
 #include "CartFunctions.h"
 #include "login.h"
+#include "Session.h"
 #include "WishlistFunctions.h"
 #include "Address.h"
+#include "CatalogSnapshot.h"
+#include "CatalogCache.h"
+#include "DBRouter.h"
+#include "ShardRouter.h"
+#include "Recommendations.h"
+#include "RequestArena.h"
+#include "ListView.h"
 
 #include <iostream>
 #include <vector>
@@ -19,14 +27,14 @@
 using namespace std;
 
 // -------------------- ANSI COLOR HELPERS --------------------
-static const string ANSI_RESET = "\033[0m";
-static const string ANSI_BOLD = "\033[1m";
-static const string ANSI_RED = "\033[31m";
-static const string ANSI_GREEN = "\033[32m";
-static const string ANSI_YELLOW = "\033[33m";
-static const string ANSI_BLUE = "\033[34m";
-static const string ANSI_MAGENTA = "\033[35m";
-static const string ANSI_CYAN = "\033[36m";
+const string ANSI_RESET = "\033[0m";
+const string ANSI_BOLD = "\033[1m";
+const string ANSI_RED = "\033[31m";
+const string ANSI_GREEN = "\033[32m";
+const string ANSI_YELLOW = "\033[33m";
+const string ANSI_BLUE = "\033[34m";
+const string ANSI_MAGENTA = "\033[35m";
+const string ANSI_CYAN = "\033[36m";
 
 std::string color(const std::string &code, const std::string &text) {
     return code + text + ANSI_RESET;
@@ -69,37 +77,42 @@ void printFancyHeader(const string &title) {
 }
 
 // -------------------- PRODUCT LIST UTILS --------------------
-vector<int> showNumberedProducts(sql::Connection* con, const string &category, const string &subcategory) {
+// Ids of a subcategory's products by id; the list view fetches the rows
+// it shows. Served from the warmed catalog, or the mapped snapshot, when available.
+static vector<int> productIdsInGroup(sql::Connection* con, const string &category, const string &subcategory) {
     vector<int> productIds;
+
+    if (auto cache = catalogCache()) {
+        InternedString cat, sub;
+        if (!InternedString::find(category, cat) || !InternedString::find(subcategory, sub))
+            return productIds;
+        auto it = cache->byGroup.find({cat, sub});
+        if (it == cache->byGroup.end()) return productIds;
+
+        productIds.reserve(it->second.size());
+        for (size_t i : it->second) productIds.push_back(cache->products[i].getId());
+        return productIds;
+    }
+
+    if (auto snap = activeCatalogSnapshot()) {
+        vector<SnapshotProduct> rows = snap->productsIn(category, subcategory);
+        productIds.reserve(rows.size());
+        for (auto &p : rows) productIds.push_back(p.id);
+        return productIds;
+    }
+
+    con = routeRead(con);
     try {
         sql::PreparedStatement* pstmt = con->prepareStatement(
-            "SELECT Product_ID, Product_Name, Price, Stock_Qtn "
-            "FROM PRODUCT WHERE Category = ? AND Subcategory = ? ORDER BY Product_ID"
+            "SELECT Product_ID FROM PRODUCT "
+            "WHERE Category = ? AND Subcategory = ? ORDER BY Product_ID"
         );
         pstmt->setString(1, category);
         pstmt->setString(2, subcategory);
 
         sql::ResultSet* res = pstmt->executeQuery();
-
-        cout << left << setw(6) << "No."
-             << setw(8) << "PID"
-             << setw(40) << "Product Name"
-             << setw(10) << "Price"
-             << setw(8) << "Stock" << "\n";
-        cout << string(70, '-') << "\n";
-
-        int idx = 1;
-        while (res->next()) {
-            cout << left << setw(6) << idx
-                 << setw(8) << res->getInt("Product_ID")
-                 << setw(40) << res->getString("Product_Name")
-                 << setw(10) << res->getDouble("Price")
-                 << setw(8) << res->getInt("Stock_Qtn")
-                 << "\n";
-
-            productIds.push_back(res->getInt("Product_ID"));
-            idx++;
-        }
+        productIds.reserve(res->rowsCount());
+        while (res->next()) productIds.push_back(res->getInt("Product_ID"));
 
         delete res;
         delete pstmt;
@@ -116,10 +129,20 @@ void productDetailsScreen(int productId, int customerId, sql::Connection* con) {
 
     displayProductDetailsById(productId);
 
+    // precomputed co-purchase list: no query beyond the compact rows
+    vector<int> related = coPurchaseIndex().recommend(productId);
+    if (!related.empty()) {
+        cout << "\n" << color(ANSI_CYAN, "Frequently bought together:") << "\n";
+        for (size_t i = 0; i < related.size(); ++i)
+            displayCompactProductRow(con, related[i], i + 1);
+    }
+
     cout << "\n" << color(ANSI_CYAN, "Actions:") << "\n";
     cout << color(ANSI_GREEN, "1. View Supplier Details") << "\n";
     cout << color(ANSI_GREEN, "2. Add this product to Cart") << "\n";
     cout << color(ANSI_GREEN, "3. Add to Wishlist") << "\n";    // <-- NEW option
+    if (!related.empty())
+        cout << color(ANSI_GREEN, "4. View a product bought together") << "\n";
     cout << color(ANSI_GREEN, "0. Back") << "\n";
 
     int choice = getIntInput("Enter choice: ");
@@ -143,6 +166,15 @@ void productDetailsScreen(int productId, int customerId, sql::Connection* con) {
         else cout << color(ANSI_YELLOW, "\n⚠ Item may already be in wishlist or failed.\n");
         pressEnterToContinue();
     }
+    else if (choice == 4 && !related.empty()) {
+        int num = getIntInput("Enter item number: ");
+        if (num >= 1 && num <= (int)related.size()) {
+            productDetailsScreen(related[num - 1], customerId, con);
+        } else {
+            cout << color(ANSI_RED, "Invalid item number.\n");
+            pressEnterToContinue();
+        }
+    }
     else {
         // back
     }
@@ -151,49 +183,42 @@ void productDetailsScreen(int productId, int customerId, sql::Connection* con) {
 
 // -------------------- SUBCATEGORY FLOW --------------------
 void handleProductsFlow(sql::Connection *con, const string &category, const string &subcategory, int customerId) {
-    bool back = false;
+    const string groupTitle = category + " → " + subcategory;
 
-    while (!back) {
-        clearScreen();
-        printFancyHeader("PRODUCTS — " + category + " → " + subcategory);
+    // Load default list
+    vector<int> productIds = productIdsInGroup(con, category, subcategory);
 
-        // Load default list
-        vector<int> productIds = showNumberedProducts(con, category, subcategory);
+    if (productIds.empty()) {
+        clearScreen();
+        printFancyHeader("PRODUCTS — " + groupTitle);
+        cout << color(ANSI_YELLOW, "No products in this subcategory.\n");
+        pressEnterToContinue();
+        return;
+    }
 
-        if (productIds.empty()) {
-            cout << color(ANSI_YELLOW, "No products in this subcategory.\n");
-            pressEnterToContinue();
-            return;
-        }
+    string listTitle = "PRODUCTS — " + groupTitle;
+    size_t top = 0;
 
-        cout << "\n" << color(ANSI_CYAN, "Options:") << "\n";
-        cout << "1) View Product Details\n";
-        cout << "2) Sort Products\n";
-        cout << "3) Filter Products\n";
-        cout << "0) Back\n";
+    while (true) {
+        IdListSource source(con, productIds.data(), productIds.size());
+        ListView view(source, listTitle, "sfr", "s sort  ·  f filter  ·  r reset");
+        view.scrollTo(top);
 
-        int ch = getIntInput("Enter choice: ");
+        ListAction act = view.run();
+        top = view.position();
 
         // -------------------- BACK --------------------
-        if (ch == 0) {
-            back = true;
+        if (act.kind == ListAction::BACK) {
+            return;
         }
 
         // -------------------- VIEW PRODUCT DETAILS --------------------
-        else if (ch == 1) {
-            int num = getIntInput("Enter item number: ");
-
-            if (num >= 1 && num <= (int)productIds.size()) {
-                int selectedId = productIds[num - 1];
-                productDetailsScreen(selectedId, customerId, con);
-            } else {
-                cout << color(ANSI_RED, "Invalid item number.\n");
-                pressEnterToContinue();
-            }
+        if (act.kind == ListAction::OPEN) {
+            productDetailsScreen(act.productId, customerId, con);
         }
 
         // -------------------- SORT PRODUCTS --------------------
-        else if (ch == 2) {
+        else if (act.command == 's') {
             clearScreen();
             printFancyHeader("SORT PRODUCTS");
 
@@ -220,30 +245,12 @@ void handleProductsFlow(sql::Connection *con, const string &category, const stri
                 continue;
             }
 
-            // ---------- SHOW SORTED RESULTS ----------
-            clearScreen();
-            printFancyHeader("SORTED PRODUCTS");
-
-            cout << left
-                 << setw(6)  << "No."
-                 << setw(10) << "PID"
-                 << setw(30) << "Name"
-                 << setw(10) << "Stock"
-                 << setw(10) << "Price"
-                 << setw(15) << "Expiry"
-                 << setw(20) << "Supplier" << "\n";
-
-            cout << string(110, '-') << "\n";
-
-            for (int i = 0; i < productIds.size(); i++)
-                displayCompactProductRow(con, productIds[i], i + 1);
-
-            pressEnterToContinue();
-            continue;
+            listTitle = "SORTED PRODUCTS — " + groupTitle;
+            top = 0;
         }
 
         // -------------------- FILTER PRODUCTS --------------------
-        else if (ch == 3) {
+        else if (act.command == 'f') {
             clearScreen();
             printFancyHeader("FILTER PRODUCTS");
 
@@ -254,18 +261,19 @@ void handleProductsFlow(sql::Connection *con, const string &category, const stri
             int f = getIntInput("Choose filter option: ");
             if (f == 0) continue;
 
+            vector<int> filtered;
             if (f == 1) {
                 cout << "Enter company name: ";
                 string comp;
                 getline(cin, comp);
                 if (comp.empty()) getline(cin, comp);
 
-                productIds = filterProductsByCompany(con, category, subcategory, comp);
+                filtered = filterProductsByCompany(con, category, subcategory, comp);
             }
             else if (f == 2) {
-                float low = getIntInput("Enter minimum price: ");
-                float high = getIntInput("Enter maximum price: ");
-                productIds = filterProductsByPriceRange(con, category, subcategory, low, high);
+                Money low = Money::fromPaise(100LL * getIntInput("Enter minimum price: "));
+                Money high = Money::fromPaise(100LL * getIntInput("Enter maximum price: "));
+                filtered = filterProductsByPriceRange(con, category, subcategory, low, high);
             }
             else {
                 cout << color(ANSI_RED, "Invalid choice.\n");
@@ -273,38 +281,23 @@ void handleProductsFlow(sql::Connection *con, const string &category, const stri
                 continue;
             }
 
-            // ---------- SHOW FILTERED RESULTS ----------
-            clearScreen();
-            printFancyHeader("FILTERED PRODUCTS");
-
-            if (productIds.empty()) {
+            if (filtered.empty()) {
                 cout << color(ANSI_YELLOW, "No products match this filter.\n");
                 pressEnterToContinue();
                 continue;
             }
 
-            cout << left
-                 << setw(6)  << "No."
-                 << setw(10) << "PID"
-                 << setw(30) << "Name"
-                 << setw(10) << "Stock"
-                 << setw(10) << "Price"
-                 << setw(15) << "Expiry"
-                 << setw(20) << "Supplier" << "\n";
-
-            cout << string(110, '-') << "\n";
-
-            for (int i = 0; i < productIds.size(); i++)
-                displayCompactProductRow(con, productIds[i], i + 1);
-
-            pressEnterToContinue();
-            continue;
+            productIds = std::move(filtered);
+            listTitle = "FILTERED PRODUCTS — " + groupTitle;
+            top = 0;
         }
 
-        // -------------------- INVALID --------------------
-        else {
-            cout << color(ANSI_RED, "Invalid choice.\n");
-            pressEnterToContinue();
+        // -------------------- RESET TO DEFAULT LIST --------------------
+        else if (act.command == 'r') {
+            productIds = productIdsInGroup(con, category, subcategory);
+            listTitle = "PRODUCTS — " + groupTitle;
+            top = 0;
+            if (productIds.empty()) return;
         }
     }
 }
@@ -368,9 +361,13 @@ void runCategoryMenu(sql::Connection *con, int customerId) {
 
         int viewAllIndex = (int)categories.size() + offset + 1;
         int viewCartIndex = viewAllIndex + 1;
+        int viewWishlistIndex = viewCartIndex + 1;
+        int expiringIndex = viewWishlistIndex + 1;
 
         cout << "\n  " << color(ANSI_YELLOW, to_string(viewAllIndex)) << ") View ALL Products\n";
         cout << "  " << color(ANSI_YELLOW, to_string(viewCartIndex)) << ") View Cart\n";
+        cout << "  " << color(ANSI_YELLOW, to_string(viewWishlistIndex)) << ") View Wishlist\n";
+        cout << "  " << color(ANSI_YELLOW, to_string(expiringIndex)) << ") Expiring Soon\n";
         cout << "  0) Exit\n\n";
         cout << "---------------------------------------\n";
 
@@ -389,14 +386,20 @@ void runCategoryMenu(sql::Connection *con, int customerId) {
             runSearchMenu(con, customerId);  // ← CALL SEARCH HERE
         }
         else if (choice == viewAllIndex) {
-            clearScreen();
-            printFancyHeader("ALL PRODUCTS");
-            displayAllProducts(con);
-            pressEnterToContinue();
+            AllProductsSource source(con);
+            ListView view(source, "ALL PRODUCTS");
+            for (ListAction act = view.run(); act.kind == ListAction::OPEN; act = view.run())
+                productDetailsScreen(act.productId, customerId, con);
         }
         else if (choice == viewCartIndex) {
             runCartMenu(con, customerId);
         }
+        else if (choice == viewWishlistIndex) {
+            runWishlistMenu(con, customerId);
+        }
+        else if (choice == expiringIndex) {
+            showExpiringSoon(con, customerId);
+        }
         else {
             int catIndex = choice - offset - 1;
             if (catIndex >= 0 && catIndex < (int)categories.size()) {
@@ -421,6 +424,7 @@ void showMyProfile(sql::Connection* con, int customerId, const std::string &logg
         cout << "2) My Orders\n";
         cout << "3) Edit Profile\n";
         cout << "4) Manage Addresses\n";
+        cout << "5) Forget Saved Login On This Device\n";
         cout << "0) Back\n";
 
         int ch = getIntInput("Enter: ");
@@ -455,6 +459,11 @@ void showMyProfile(sql::Connection* con, int customerId, const std::string &logg
         else if (ch == 4) {
             manageAddresses(con, customerId);
         }
+        else if (ch == 5) {
+            clearSavedSession();
+            cout << color(ANSI_GREEN, "✔ Saved login removed. You will be asked to log in next time.\n");
+            pressEnterToContinue();
+        }
 
     }
 }
@@ -540,8 +549,10 @@ void editProfileMenu(sql::Connection* con, int customerId, const std::string &lo
                 continue;
             }
 
-            updateLoginPassword(con, loggedInEmail, newPwd);
-            cout << "Password updated.\n";
+            if (updateLoginPassword(con, loggedInEmail, newPwd))
+                cout << "Password updated.\n";
+            else
+                cout << "Password not changed, please try again.\n";
             pressEnterToContinue();
         }
     }
@@ -552,7 +563,8 @@ void showMyOrders(sql::Connection* con, int customerId) {
     clearScreen();
     printFancyHeader("MY ORDERS");
 
-    vector<Order> orders = loadOrdersForCustomer(con, customerId);
+    RequestArena arena;     // everything below dies with this screen
+    pmr::vector<Order> orders = loadOrdersForCustomer(con, customerId, arena.resource());
 
     if (orders.empty()) {
         cout << "You have no orders yet.\n";
@@ -562,7 +574,7 @@ void showMyOrders(sql::Connection* con, int customerId) {
 
     for (int i = 0; i < orders.size(); i++)
         cout << (i+1) << ") Order " << (i+1) 
-             << " — " << orders[i].getOrderDate() << "\n";
+             << " — " << orders[i].getOrderDate().toSQL() << "\n";
 
     cout << "0) Back\n";
 
@@ -575,18 +587,24 @@ void showMyOrders(sql::Connection* con, int customerId) {
     }
 
     int orderId = orders[choice-1].getOrderId();
-    showOrderDetails(con, orderId, choice);
+    showOrderDetails(con, orderId, choice, customerId);
 }
 
 // -------------------- ORDER DETAILS --------------------
-void showOrderDetails(sql::Connection* con, int orderId, int orderNumber) {
+void showOrderDetails(sql::Connection* con, int orderId, int orderNumber, int customerId) {
     clearScreen();
     printFancyHeader("ORDER DETAILS");
 
+    RequestArena arena;
+    pmr::vector<OrderItem> items(arena.resource());
     try {
         sql::PreparedStatement* pstmt =
-            con->prepareStatement("SELECT OrderID, OrderDate, DeliveryDate, TotalAmount FROM Orders WHERE OrderID=?");
+            shardRead(con, customerId)->prepareStatement(
+                "SELECT OrderID, OrderDate, DeliveryDate, TotalAmount FROM Orders "
+                "WHERE OrderID=? AND CustomerID=?"
+            );
         pstmt->setInt(1, orderId);
+        pstmt->setInt(2, customerId);
 
         sql::ResultSet* res = pstmt->executeQuery();
 
@@ -601,13 +619,13 @@ void showOrderDetails(sql::Connection* con, int orderId, int orderNumber) {
         cout << "Order ID      : " << res->getInt("OrderID") << "\n";
         cout << "Order Date    : " << res->getString("OrderDate") << "\n";
         cout << "Delivery Date : " << res->getString("DeliveryDate") << "\n";
-        cout << "Total Amount  : " << res->getDouble("TotalAmount") << "\n\n";
+        cout << "Total Amount  : " << Money::fromSQL(res->getString("TotalAmount")) << "\n\n";
 
         int oid = res->getInt("OrderID");
         delete res;
         delete pstmt;
 
-        vector<OrderItem> items = loadOrderItems(con, oid);
+        items = loadOrderItems(con, customerId, oid, arena.resource());
 
         cout << left << setw(6) << "No."
              << setw(35) << "Product"
@@ -637,6 +655,38 @@ void showOrderDetails(sql::Connection* con, int orderId, int orderNumber) {
         cout << "Error: " << e.what() << "\n";
     }
 
+    if (items.empty()) {
+        pressEnterToContinue();
+        return;
+    }
+
+    cout << "\n" << color(ANSI_CYAN, "Options:") << "\n";
+    cout << "1) Buy Again (add all items to cart)\n";
+    cout << "0) Back\n";
+    if (getIntInput("Enter choice: ") != 1) return;
+
+    // whole order in one stock-checked batch
+    vector<pair<int, int>> lines;
+    for (auto &it : items) lines.push_back({it.getProductId(), it.getQuantity()});
+
+    vector<StockShortfall> shortfalls;
+    int added = 0;
+    if (!addManyToCart(con, customerId, lines, shortfalls, added)) {
+        cout << color(ANSI_RED, "\n❌ Could not add the items to your cart.\n");
+        pressEnterToContinue();
+        return;
+    }
+
+    if (added > 0)
+        cout << color(ANSI_GREEN, "\n✅ Added " + to_string(added) + " item(s) to your cart.\n");
+    for (auto &s : shortfalls) {
+        string name = s.name.empty() ? "PID " + to_string(s.productId) : s.name;
+        if (s.available > 0)
+            cout << color(ANSI_YELLOW, "⚠ " + name + ": only " + to_string(s.available) +
+                                       " of " + to_string(s.requested) + " added (stock)\n");
+        else
+            cout << color(ANSI_YELLOW, "⚠ " + name + ": not available\n");
+    }
     pressEnterToContinue();
 }
 
@@ -654,29 +704,31 @@ void runSearchMenu(sql::Connection* con, int customerId) {
         int ch = getIntInput("Enter choice: ");
         if (ch == 0) return;
 
-        vector<int> results;
+        RequestArena arena;     // one search's results
+        pmr::vector<int> results(arena.resource());
 
         if (ch == 1) {
             cout << "Enter product name: ";
             string name; getline(cin, name);
-            results = searchProductsByName(con, name);
+            results = searchProductsByName(con, name, arena.resource());
         }
         else if (ch == 2) {
             cout << "Enter company/brand: ";
             string brand; getline(cin, brand);
-            results = searchProductsByCompany(con, brand);
+            results = searchProductsByCompany(con, brand, arena.resource());
         }
         else if (ch == 3) {
             cout << "Enter category: ";
             string cat; getline(cin, cat);
-            results = searchProductsByCategory(con, cat);
+            results = searchProductsByCategory(con, cat, arena.resource());
         }
         else if (ch == 4) {
             cout << "Enter minimum price: ";
             double minP; cin >> minP; cin.ignore();
             cout << "Enter maximum price: ";
             double maxP; cin >> maxP; cin.ignore();
-            results = searchProductsByPriceRange(con, minP, maxP);
+            results = searchProductsByPriceRange(con, Money::fromRupees(minP), Money::fromRupees(maxP),
+                                                 arena.resource());
         }
         else {
             cout << "Invalid choice.\n";
@@ -684,44 +736,39 @@ void runSearchMenu(sql::Connection* con, int customerId) {
             continue;
         }
 
-        clearScreen();
-        printFancyHeader("SEARCH RESULTS");
-
         if (results.empty()) {
+            clearScreen();
+            printFancyHeader("SEARCH RESULTS");
             cout << "No products match your search.\n";
             pressEnterToContinue();
             continue;
         }
 
-        cout << left
-            << setw(6)  << "No."
-            << setw(10) << "PID"
-            << setw(30) << "Name"
-            << setw(10) << "Stock"
-            << setw(10) << "Price"
-            << setw(15) << "Expiry"
-            << setw(20) << "Supplier"
-            << "\n";
-
-        cout << string(105, '-') << "\n";
-
-        for (int i = 0; i < results.size(); ++i) {
-            displayCompactProductRow(con, results[i], i + 1);
-        }
-
+        IdListSource source(con, results.data(), results.size());
+        ListView view(source, "SEARCH RESULTS");
+        for (ListAction act = view.run(); act.kind == ListAction::OPEN; act = view.run())
+            productDetailsScreen(act.productId, customerId, con);
+    }
+}
 
-        cout << "\nEnter number to view product, or 0 to go back: ";
-        int pick = getIntInput("");
+// -------------------- EXPIRING SOON --------------------
+// Products whose expiry date falls within the next week, soonest first
+void showExpiringSoon(sql::Connection* con, int customerId) {
+    const int EXPIRING_DAYS = 7;
 
-        if (pick == 0) continue;
-        if (pick < 1 || pick > results.size()) {
-            cout << "Invalid selection.\n";
-            pressEnterToContinue();
-            continue;
-        }
-
-        productDetailsScreen(results[pick - 1], customerId, con);
+    vector<int> results = productsExpiringWithin(con, EXPIRING_DAYS);
+    if (results.empty()) {
+        clearScreen();
+        printFancyHeader("EXPIRING SOON");
+        cout << "Nothing expires in the next " << EXPIRING_DAYS << " days.\n";
+        pressEnterToContinue();
+        return;
     }
+
+    IdListSource source(con, results.data(), results.size());
+    ListView view(source, "EXPIRING SOON");
+    for (ListAction act = view.run(); act.kind == ListAction::OPEN; act = view.run())
+        productDetailsScreen(act.productId, customerId, con);
 }
 
 void manageAddresses(sql::Connection* con, int customerId) {
@@ -787,7 +834,7 @@ void manageAddresses(sql::Connection* con, int customerId) {
             int id = getIntInput("Enter Address ID to delete (0 to cancel): ");
             if (id == 0) continue;
 
-            bool ok = deleteAddress(con, id);
+            bool ok = deleteAddress(con, customerId, id);
 
             if (ok) cout << color(ANSI_GREEN, "✔ Address deleted.\n");
             else    cout << color(ANSI_RED, "❌ Failed. Check ID.\n");
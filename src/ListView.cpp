@@ -0,0 +1,339 @@
+// ListView.cpp
+// Windowed product list: fetch and print only the rows on screen
+
+#include "ListView.h"
+#include "Functions.h"
+#include "CatalogCache.h"
+#include "CatalogSnapshot.h"
+#include "DBRouter.h"
+#include "WishlistFunctions.h"
+#include "ProductPrefetch.h"
+#include "Statements.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include <cppconn/exception.h>
+
+#ifndef _WIN32
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// header, column titles, rule, blank line, footer and prompt
+static const int CHROME_LINES = 10;
+static const size_t MIN_PAGE = 5;
+
+int terminalRows() {
+#ifndef _WIN32
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_row > 0)
+        return ws.ws_row;
+#endif
+    if (const char* lines = getenv("LINES")) {
+        int n = atoi(lines);
+        if (n > 0) return n;
+    }
+    return 24;
+}
+
+static ListRow rowFrom(const CatalogData &cache, const Product &p) {
+    ListRow r;
+    const Supplier* s = cache.supplierFor(p.getId());
+    r.productId = p.getId();
+    r.name = p.getName();
+    r.stock = cache.stockOf(p);
+    r.price = p.getPrice();
+    r.expiry = p.getExpiry();
+    if (s) r.supplier = s->name;
+    return r;
+}
+
+static ListRow unavailableRow(int productId) {
+    ListRow r;
+    r.productId = productId;
+    r.name = "(unavailable)";
+    return r;
+}
+
+// -------------------- ROW LOADING --------------------
+bool loadListRows(sql::Connection* con, const int* ids, size_t count, vector<ListRow> &out) {
+    out.clear();
+    out.reserve(count);
+    if (count == 0) return true;
+
+    if (auto cache = catalogCache()) {
+        for (size_t i = 0; i < count; ++i) {
+            const Product* p = cache->findProduct(ids[i]);
+            out.push_back(p ? rowFrom(*cache, *p) : unavailableRow(ids[i]));
+        }
+        return true;
+    }
+
+    if (auto snap = activeCatalogSnapshot()) {
+        for (size_t i = 0; i < count; ++i) {
+            SnapshotProduct p;
+            if (!snap->findProduct(ids[i], p)) {
+                out.push_back(unavailableRow(ids[i]));
+                continue;
+            }
+            ListRow r;
+            r.productId = p.id;
+            r.name = string(p.name);
+            r.stock = p.stock;
+            r.price = p.price;
+            r.expiry = p.expiry;
+            r.supplier = string(p.supplier);
+            out.push_back(std::move(r));
+        }
+        return true;
+    }
+
+    // one round trip for the whole window
+    string sql = string(stmts::LIST_ROWS.sql) +
+                 " WHERE p.Product_ID IN (" + sqlreg::placeholders(count) + ")";
+
+    con = routeRead(con);
+    sql::PreparedStatement* pstmt = nullptr;
+    sql::ResultSet* res = nullptr;
+    bool ok = true;
+    unordered_map<int, ListRow> found;
+
+    try {
+        pstmt = con->prepareStatement(sql);
+        for (size_t i = 0; i < count; ++i) pstmt->setInt((unsigned int)i + 1, ids[i]);
+        res = pstmt->executeQuery();
+        found.reserve(res->rowsCount());
+        while (res->next()) {
+            ListRow r = sqlreg::readAs<ListRow>(res, stmts::LIST_ROWS);
+            int id = r.productId;
+            found.emplace(id, std::move(r));
+        }
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in loadListRows: " << e.what() << endl;
+        ok = false;
+    }
+
+    delete res;
+    delete pstmt;
+
+    // back in the caller's order
+    for (size_t i = 0; i < count; ++i) {
+        auto it = found.find(ids[i]);
+        out.push_back(it != found.end() ? it->second : unavailableRow(ids[i]));
+    }
+    return ok;
+}
+
+// -------------------- SOURCES --------------------
+bool IdListSource::fetch(size_t first, size_t n, vector<ListRow> &out) {
+    if (first >= count) { out.clear(); return true; }
+    n = min(n, count - first);
+    return loadListRows(con, ids + first, n, out);
+}
+
+size_t AllProductsSource::size() {
+    if (auto cache = catalogCache()) return cache->products.size();
+    if (total >= 0) return (size_t)total;
+
+    sql::Connection* rc = routeRead(con);
+    sql::Statement* stmt = nullptr;
+    sql::ResultSet* res = nullptr;
+    try {
+        stmt = rc->createStatement();
+        res = stmt->executeQuery("SELECT COUNT(*) AS N FROM PRODUCT");
+        if (res->next()) total = (long)res->getInt64("N");
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in AllProductsSource::size: " << e.what() << endl;
+    }
+    delete res;
+    delete stmt;
+    return total >= 0 ? (size_t)total : 0;
+}
+
+bool AllProductsSource::fetch(size_t first, size_t n, vector<ListRow> &out) {
+    out.clear();
+
+    if (auto cache = catalogCache()) {
+        const vector<Product> &products = cache->products;
+        for (size_t i = first; i < products.size() && i < first + n; ++i)
+            out.push_back(rowFrom(*cache, products[i]));
+        return true;
+    }
+
+    // Next page: continue after the last id shown, so the cost does not
+    // grow with the scroll position. Anything else: OFFSET on the key.
+    bool sequential = first > 0 && first == nextFirst;
+    string sql = string(stmts::LIST_ROWS.sql) + " ";
+    sql += sequential ? "WHERE p.Product_ID > ? ORDER BY p.Product_ID LIMIT ?"
+                      : "ORDER BY p.Product_ID LIMIT ? OFFSET ?";
+
+    sql::Connection* rc = routeRead(con);
+    sql::PreparedStatement* pstmt = nullptr;
+    sql::ResultSet* res = nullptr;
+    bool ok = true;
+
+    try {
+        pstmt = rc->prepareStatement(sql);
+        if (sequential) {
+            pstmt->setInt(1, lastId);
+            pstmt->setInt(2, (int)n);
+        } else {
+            pstmt->setInt(1, (int)n);
+            pstmt->setInt64(2, (int64_t)first);
+        }
+        res = pstmt->executeQuery();
+        out.reserve(res->rowsCount());
+        while (res->next()) out.push_back(sqlreg::readAs<ListRow>(res, stmts::LIST_ROWS));
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in AllProductsSource::fetch: " << e.what() << endl;
+        ok = false;
+    }
+
+    delete res;
+    delete pstmt;
+
+    if (ok && !out.empty()) {
+        nextFirst = first + out.size();
+        lastId = out.back().productId;
+    }
+    return ok;
+}
+
+// -------------------- LIST VIEW --------------------
+ListView::ListView(ListSource &src, string t, string keys, string help)
+    : source(src), title(std::move(t)), commandKeys(std::move(keys)), commandHelp(std::move(help)),
+      top(0), windowFirst(SIZE_MAX) {}
+
+size_t ListView::pageSize() const {
+    int rows = terminalRows() - CHROME_LINES;
+    return rows < (int)MIN_PAGE ? MIN_PAGE : (size_t)rows;
+}
+
+void ListView::render(size_t rows) {
+    size_t page = pageSize();
+
+    if (windowFirst != top || window.size() != min(page, rows - top)) {
+        if (!source.fetch(top, page, window)) window.clear();
+        windowFirst = top;
+
+        // details for these rows load while the user reads the page
+        vector<int> ids;
+        ids.reserve(window.size());
+        for (const ListRow &r : window) ids.push_back(r.productId);
+        prefetchProductDetails(ids.data(), ids.size());
+    }
+
+    clearScreen();
+    printFancyHeader(title);
+
+    cout << left
+         << setw(8)  << "No."
+         << setw(10) << "PID"
+         << setw(30) << "Name"
+         << setw(10) << "Stock"
+         << setw(10) << "Price"
+         << setw(15) << "Expiry"
+         << setw(20) << "Supplier" << "\n";
+    cout << string(105, '-') << "\n";
+
+    for (size_t i = 0; i < window.size(); ++i) {
+        const ListRow &r = window[i];
+        cout << left
+             << setw(8)  << top + i + 1
+             << setw(10) << r.productId
+             << setw(30) << r.name
+             << setw(10) << r.stock
+             << setw(10) << r.price
+             << setw(15) << r.expiry.toSQL()
+             << setw(20) << r.supplier
+             << (inSessionWishlist(r.productId) ? "♥" : "")
+             << "\n";
+    }
+
+    size_t last = top + window.size();
+    cout << "\n" << color(ANSI_CYAN, "Rows " + to_string(window.empty() ? 0 : top + 1) + "-" + to_string(last)
+                                   + " of " + to_string(rows))
+         << "  ·  n next  ·  p prev  ·  g <row> jump  ·  <number> open";
+    if (!commandHelp.empty()) cout << "  ·  " << commandHelp;
+    cout << "  ·  0 back\n";
+}
+
+ListAction ListView::run() {
+    while (true) {
+        size_t rows = source.size();
+        size_t page = pageSize();
+        ListAction action;
+
+        if (rows == 0) return action;
+        if (top >= rows) top = (rows - 1) / page * page;
+
+        render(rows);
+
+        cout << color(ANSI_YELLOW, "> ");
+        string line;
+        if (!getline(cin, line)) return action;
+
+        // trim; PgUp/PgDn arrive as escape sequences on a line
+        size_t b = line.find_first_not_of(" \t\r");
+        size_t e = line.find_last_not_of(" \t\r");
+        line = b == string::npos ? "" : line.substr(b, e - b + 1);
+
+        if (line.empty() || line == "n" || line == "\x1b[6~") {
+            if (top + page < rows) top += page;
+            continue;
+        }
+        if (line == "p" || line == "\x1b[5~") {
+            top = top >= page ? top - page : 0;
+            continue;
+        }
+        if (line[0] == 'g') {
+            istringstream in(line.substr(1));
+            long target;
+            if (in >> target && target >= 1 && (size_t)target <= rows) top = (size_t)target - 1;
+            continue;
+        }
+        if (line.size() == 1 && commandKeys.find(line[0]) != string::npos) {
+            action.kind = ListAction::COMMAND;
+            action.command = line[0];
+            return action;
+        }
+
+        istringstream in(line);
+        long pick;
+        string rest;
+        if (!(in >> pick) || (in >> rest)) {
+            cout << color(ANSI_RED, "Unknown command.\n");
+            pressEnterToContinue();
+            continue;
+        }
+        if (pick == 0) return action;
+        if (pick < 1 || (size_t)pick > rows) {
+            cout << color(ANSI_RED, "Invalid item number.\n");
+            pressEnterToContinue();
+            continue;
+        }
+
+        // usually on screen; otherwise fetch just that row
+        size_t idx = (size_t)pick - 1;
+        if (idx >= windowFirst && idx < windowFirst + window.size()) {
+            action.productId = window[idx - windowFirst].productId;
+        } else {
+            vector<ListRow> one;
+            if (!source.fetch(idx, 1, one) || one.empty()) continue;
+            action.productId = one[0].productId;
+        }
+        action.kind = ListAction::OPEN;
+        return action;
+    }
+}
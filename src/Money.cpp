@@ -0,0 +1,78 @@
+// Money.cpp
+#include "Money.h"
+
+#include <cmath>
+
+using namespace std;
+
+Money Money::fromRupees(double rupees) {
+    return Money((int64_t)llround(rupees * 100.0));
+}
+
+// DECIMAL text as MySQL returns it. Digits past the second decimal are
+// rounded half away from zero (only FLOAT columns produce them); exponent
+// notation and anything else is rejected.
+bool Money::parseSQL(const string &s, Money &out) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < s.size() && (s[i] == '-' || s[i] == '+')) negative = s[i++] == '-';
+
+    int64_t whole = 0;
+    size_t digits = 0;
+    for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i, ++digits)
+        whole = whole * 10 + (s[i] - '0');
+
+    int64_t frac = 0;
+    int fracDigits = 0;
+    bool roundUp = false;
+    if (i < s.size() && s[i] == '.') {
+        for (++i; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i, ++digits) {
+            if (fracDigits < 2) frac = frac * 10 + (s[i] - '0');
+            else if (fracDigits == 2) roundUp = s[i] >= '5';
+            ++fracDigits;
+        }
+    }
+    if (digits == 0 || i != s.size()) return false;
+    if (fracDigits == 1) frac *= 10;
+
+    int64_t p = whole * 100 + frac + (roundUp ? 1 : 0);
+    out = Money(negative ? -p : p);
+    return true;
+}
+
+Money Money::fromSQL(const string &s) {
+    Money m;
+    return parseSQL(s, m) ? m : Money();
+}
+
+string Money::toString() const {
+    uint64_t a = paise < 0 ? (uint64_t)0 - (uint64_t)paise : (uint64_t)paise;
+
+    char buf[24];
+    char* end = buf + sizeof(buf);
+    char* p = end;
+    *--p = (char)('0' + a % 10); a /= 10;
+    *--p = (char)('0' + a % 10); a /= 10;
+    *--p = '.';
+    do { *--p = (char)('0' + a % 10); a /= 10; } while (a);
+    if (paise < 0) *--p = '-';
+    return string(p, end);
+}
+
+ostream& operator<<(ostream &os, Money m) {
+    return os << m.toString();
+}
+
+// ---------------------------------------------
+// Batched arithmetic
+// ---------------------------------------------
+int64_t sumLineTotals(const int32_t* __restrict qty, const int64_t* __restrict pricePaise, size_t n) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += (int64_t)qty[i] * pricePaise[i];
+    return sum;
+}
+
+void lineTotals(const int32_t* __restrict qty, const int64_t* __restrict pricePaise,
+                int64_t* __restrict out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (int64_t)qty[i] * pricePaise[i];
+}
@@ -7,12 +7,12 @@ using namespace std;
 Order::Order() {
     orderId = 0;
     customerId = 0;
-    orderDate = "";
-    deliveryDate = "";
-    totalAmount = 0.0;
+    orderDate = Date();
+    deliveryDate = Date();
+    totalAmount = Money();
 }
 
-Order::Order(int oid, int cid, const std::string &od, const std::string &dd, double total) {
+Order::Order(int oid, int cid, Date od, Date dd, Money total) {
     orderId = oid;
     customerId = cid;
     orderDate = od;
@@ -24,6 +24,10 @@ void Order::addItem(const OrderItem &item) {
     items.push_back(item);
 }
 
+void Order::addItem(OrderItem &&item) {
+    items.push_back(std::move(item));
+}
+
 void Order::displayOrder() const {
     cout << "===========================\n";
     cout << "        ORDER DETAILS\n";
@@ -31,8 +35,8 @@ void Order::displayOrder() const {
 
     cout << "Order ID       : " << orderId << "\n";
     cout << "Customer ID    : " << customerId << "\n";
-    cout << "Order Date     : " << orderDate << "\n";
-    cout << "Delivery Date  : " << deliveryDate << "\n";
+    cout << "Order Date     : " << orderDate.toSQL() << "\n";
+    cout << "Delivery Date  : " << deliveryDate.toSQL() << "\n";
     cout << "Total Amount   : " << totalAmount << "\n\n";
 
     cout << left << setw(6) << "No."
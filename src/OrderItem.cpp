@@ -1,17 +1,19 @@
 #include "OrderItem.h"
 
-OrderItem::OrderItem() {
-    productId = 0;
-    productName = "";
-    quantity = 0;
-    price = 0.0;
-    subtotal = 0.0;
-}
+#include <utility>
 
-OrderItem::OrderItem(int pid, const std::string &name, int qty, double p, double sub) {
-    productId = pid;
-    productName = name;
-    quantity = qty;
-    price = p;
-    subtotal = sub;
-}
+OrderItem::OrderItem(const allocator_type &alloc)
+    : productId(0), productName(alloc), quantity(0) {}
+
+OrderItem::OrderItem(int pid, std::string_view name, int qty, Money p, Money sub,
+                     const allocator_type &alloc)
+    : productId(pid), productName(name, alloc), quantity(qty), price(p), subtotal(sub) {}
+
+OrderItem::OrderItem(const OrderItem &o, const allocator_type &alloc)
+    : productId(o.productId), productName(o.productName, alloc), quantity(o.quantity),
+      price(o.price), subtotal(o.subtotal) {}
+
+// steals the name if both use the same resource, copies it otherwise
+OrderItem::OrderItem(OrderItem &&o, const allocator_type &alloc)
+    : productId(o.productId), productName(std::move(o.productName), alloc), quantity(o.quantity),
+      price(o.price), subtotal(o.subtotal) {}
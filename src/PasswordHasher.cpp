@@ -0,0 +1,180 @@
+// PasswordHasher.cpp
+#include "PasswordHasher.h"
+#include "Crypto.h"
+
+#include <future>
+#include <memory>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace {
+
+const char* HASH_PREFIX = "$scrypt$";
+const size_t SALT_BYTES = 16;
+const size_t KEY_BYTES = 32;
+
+// Largest scrypt scratch space one hash may use (128 * r * 2^logN bytes);
+// every worker can hold this much at once. Stored hashes asking for more are
+// refused rather than allocated.
+const uint64_t MAX_HASH_MEMORY = 256ULL << 20;
+const int MAX_CONFIG_LOGN = 18;           // with r = 8: 256 MiB
+
+uint64_t hashMemory(const HashCost &c) {
+    return 128ULL * (uint64_t)c.r * (1ULL << c.logN);
+}
+
+int envInt(const char* name, int fallback, int lo, int hi) {
+    const char* v = getenv(name);
+    if (!v || !*v) return fallback;
+    int n = atoi(v);
+    return (n < lo || n > hi) ? fallback : n;
+}
+
+string computeHash(const string &password, const HashCost &c) {
+    string salt = randomBytes(SALT_BYTES);
+    string key = scrypt(password, salt, 1ULL << c.logN, (unsigned)c.r, (unsigned)c.p, KEY_BYTES);
+
+    char params[64];
+    snprintf(params, sizeof(params), "ln=%d,r=%d,p=%d", c.logN, c.r, c.p);
+    return string(HASH_PREFIX) + params + "$" + toHex(salt) + "$" + toHex(key);
+}
+
+// "$scrypt$ln=..,r=..,p=..$salt$key"
+bool parseHash(const string &stored, HashCost &c, string &salt, string &key) {
+    if (stored.compare(0, 8, HASH_PREFIX) != 0) return false;
+    size_t a = stored.find('$', 8);
+    if (a == string::npos) return false;
+    size_t b = stored.find('$', a + 1);
+    if (b == string::npos) return false;
+
+    if (sscanf(stored.substr(8, a - 8).c_str(), "ln=%d,r=%d,p=%d", &c.logN, &c.r, &c.p) != 3)
+        return false;
+    if (c.logN < 1 || c.logN > 24 || c.r < 1 || c.r > 32 || c.p < 1 || c.p > 16)
+        return false;
+    if (hashMemory(c) > MAX_HASH_MEMORY)
+        return false;
+
+    return fromHex(stored.substr(a + 1, b - a - 1), salt)
+        && fromHex(stored.substr(b + 1), key);
+}
+
+VerifyResult computeVerify(const string &password, const string &stored, const HashCost &current) {
+    HashCost c;
+    string salt, key;
+
+    if (!parseHash(stored, c, salt, key)) {
+        // malformed, or a cost this pool will not run
+        if (isPasswordHash(stored)) return VERIFY_MISMATCH;
+        // legacy plain-text row: compare, and ask the caller to migrate it
+        return constantTimeEquals(stored, password) ? VERIFY_OK_NEEDS_REHASH : VERIFY_MISMATCH;
+    }
+
+    string got = scrypt(password, salt, 1ULL << c.logN, (unsigned)c.r, (unsigned)c.p, key.size());
+    if (!constantTimeEquals(got, key)) return VERIFY_MISMATCH;
+
+    bool weaker = c.logN < current.logN || c.r < current.r || c.p < current.p;
+    return weaker ? VERIFY_OK_NEEDS_REHASH : VERIFY_OK;
+}
+
+} // namespace
+
+bool isPasswordHash(const string &stored) {
+    return stored.compare(0, 8, HASH_PREFIX) == 0;
+}
+
+PasswordHasher& PasswordHasher::instance() {
+    static PasswordHasher hasher(
+        envInt("PROJECT1_HASH_WORKERS", 2, 1, 64),
+        (size_t)envInt("PROJECT1_HASH_QUEUE", 32, 1, 100000),
+        HashCost{envInt("PROJECT1_SCRYPT_LOGN", 14, 10, MAX_CONFIG_LOGN), 8, 1});
+    return hasher;
+}
+
+PasswordHasher::PasswordHasher(int workers, size_t cap, HashCost cost)
+    : current(cost), capacity(cap) {
+    for (int i = 0; i < workers; ++i)
+        threads.emplace_back(&PasswordHasher::workerLoop, this);
+}
+
+PasswordHasher::~PasswordHasher() {
+    {
+        lock_guard<mutex> lock(mtx);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &t : threads) t.join();
+}
+
+bool PasswordHasher::submit(function<void()> job) {
+    {
+        lock_guard<mutex> lock(mtx);
+        if (stopping || queue.size() >= capacity) return false;
+        queue.push_back(std::move(job));
+    }
+    wake.notify_one();
+    return true;
+}
+
+void PasswordHasher::workerLoop() {
+    while (true) {
+        function<void()> job;
+        {
+            unique_lock<mutex> lock(mtx);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping && queue.empty()) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        // jobs hand their own exceptions to the waiting caller; this only
+        // keeps a stray one from taking the worker (and the process) down
+        try {
+            job();
+        } catch (...) {}
+    }
+}
+
+string PasswordHasher::hash(const string &password) {
+    auto result = make_shared<promise<string>>();
+    future<string> f = result->get_future();
+    HashCost c = current;
+
+    if (!submit([result, password, c] {
+            try {
+                result->set_value(computeHash(password, c));
+            } catch (...) {
+                result->set_exception(current_exception());
+            }
+        }))
+        return "";
+    try {
+        return f.get();
+    } catch (exception &e) {
+        cerr << "Password hashing failed: " << e.what() << endl;
+        return "";
+    }
+}
+
+VerifyResult PasswordHasher::verify(const string &password, const string &stored) {
+    auto result = make_shared<promise<VerifyResult>>();
+    future<VerifyResult> f = result->get_future();
+    HashCost c = current;
+
+    if (!submit([result, password, stored, c] {
+            try {
+                result->set_value(computeVerify(password, stored, c));
+            } catch (...) {
+                result->set_exception(current_exception());
+            }
+        }))
+        return VERIFY_BUSY;
+    try {
+        return f.get();
+    } catch (exception &e) {
+        cerr << "Password check failed: " << e.what() << endl;
+        return VERIFY_MISMATCH;
+    }
+}
@@ -1,27 +1,11 @@
 #include "Product.h"
 
 // Default Constructor
-Product::Product() {
-    Product_id = 0;
-    Product_name = "";
-    Category = "";
-    Subcategory = "";
-    Price = 0.0f;
-    Stock_Qtn = 0;
-    Company_name = "";
-    ExpiryDate = Date();  // default Date constructor
-}
+Product::Product() : Product_id(0), Stock_Qtn(0) {}
 
-// Constructor used when loading product data from the database
-Product::Product(int id, string name, string cat, string subc,
-                 float price, int qty, string comp, Date exp)
-{
-    Product_id = id;
-    Product_name = name;
-    Category = cat;
-    Subcategory = subc;
-    Price = price;
-    Stock_Qtn = qty;
-    Company_name = comp;
-    ExpiryDate = exp;
-}
+// Constructor used when loading product data from the database.
+// The name is moved in; category, subcategory and company go to the pool.
+Product::Product(int id, string name, const string &cat, const string &subc,
+                 Money price, int qty, const string &comp, Date exp)
+    : Product_id(id), Product_name(std::move(name)), Category(cat), Subcategory(subc),
+      Price(price), Stock_Qtn(qty), Company_name(comp), ExpiryDate(exp) {}
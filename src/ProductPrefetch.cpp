@@ -0,0 +1,174 @@
+// ProductPrefetch.cpp
+// Worker thread that loads product details for the rows on screen
+
+#include "ProductPrefetch.h"
+#include "LruCache.h"
+#include "DBRouter.h"
+#include "Statements.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+struct CachedDetails {
+    ProductDetails details;
+    chrono::steady_clock::time_point loadedAt;
+};
+
+mutex prefetchMutex;
+condition_variable prefetchWake;
+vector<int> pending;
+bool prefetchStop = false;
+bool prefetchStopped = false;
+uint64_t generation = 0;        // bumped by forget/clear; older batches are dropped
+thread prefetchThread;
+LruCache<int, CachedDetails> prefetched(PREFETCH_CAPACITY);
+
+bool fresh(const CachedDetails &c) {
+    return chrono::steady_clock::now() - c.loadedAt < chrono::seconds(PREFETCH_TTL_SECONDS);
+}
+
+// One query for the whole batch: product columns plus its supplier
+vector<ProductDetails> loadDetails(sql::Connection* con, const vector<int> &ids) {
+    vector<ProductDetails> out;
+
+    string sql = string(stmts::PRODUCT_DETAILS.sql) +
+                 " WHERE p.Product_ID IN (" + sqlreg::placeholders(ids.size()) + ")";
+
+    sql::PreparedStatement* pstmt = con->prepareStatement(sql);
+    sql::ResultSet* res = nullptr;
+    try {
+        for (size_t i = 0; i < ids.size(); ++i) pstmt->setInt((unsigned int)i + 1, ids[i]);
+        res = pstmt->executeQuery();
+        out.reserve(res->rowsCount());
+
+        while (res->next()) {
+            auto [id, name, category, subcategory, price, stock, company, expiry,
+                  sid, sname, scontact, semail, saddress] =
+                sqlreg::readRow(res, stmts::PRODUCT_DETAILS);
+            ProductDetails d;
+            d.productId = id;
+            d.name = std::move(name);
+            d.category = std::move(category);
+            d.subcategory = std::move(subcategory);
+            d.price = price;
+            d.stock = stock;
+            d.company = std::move(company);
+            d.expiry = expiry;
+            d.hasSupplier = sid.has_value();
+            if (d.hasSupplier) {
+                d.supplierName = std::move(sname);
+                d.supplierContact = std::move(scontact);
+                d.supplierEmail = std::move(semail);
+                d.supplierAddress = std::move(saddress);
+            }
+            out.push_back(std::move(d));
+        }
+    } catch (...) {
+        delete res;
+        delete pstmt;
+        throw;
+    }
+
+    delete res;
+    delete pstmt;
+    return out;
+}
+
+void prefetchLoop() {
+    sql::Connection* con = nullptr;
+
+    while (true) {
+        vector<int> batch;
+        uint64_t batchGeneration;
+        {
+            unique_lock<mutex> lock(prefetchMutex);
+            prefetchWake.wait(lock, [] { return prefetchStop || !pending.empty(); });
+            if (prefetchStop) break;
+            batch.swap(pending);
+            batchGeneration = generation;
+        }
+
+        try {
+            if (!con) con = createReadConnection();
+            vector<ProductDetails> loaded = loadDetails(con, batch);
+
+            auto now = chrono::steady_clock::now();
+            lock_guard<mutex> lock(prefetchMutex);
+            if (batchGeneration != generation) continue;    // read before a stock change
+            for (auto &d : loaded) {
+                int id = d.productId;
+                prefetched.put(id, CachedDetails{std::move(d), now});
+            }
+        } catch (sql::SQLException &e) {
+            cerr << "Product prefetch: " << e.what() << endl;
+            if (con) { delete con; con = nullptr; }
+        }
+    }
+
+    if (con) { con->close(); delete con; }
+}
+
+} // namespace
+
+void prefetchProductDetails(const int* ids, size_t count) {
+    lock_guard<mutex> lock(prefetchMutex);
+    if (prefetchStopped) return;
+
+    pending.clear();
+    for (size_t i = 0; i < count; ++i) {
+        CachedDetails* c = prefetched.find(ids[i]);
+        if (!c || !fresh(*c)) pending.push_back(ids[i]);
+    }
+    if (pending.empty()) return;
+
+    if (!prefetchThread.joinable()) {
+        prefetchStop = false;
+        prefetchThread = thread(prefetchLoop);
+    }
+    prefetchWake.notify_one();
+}
+
+bool findPrefetchedDetails(int productId, ProductDetails &out) {
+    lock_guard<mutex> lock(prefetchMutex);
+    CachedDetails* c = prefetched.find(productId);
+    if (!c || !fresh(*c)) return false;
+    out = c->details;
+    return true;
+}
+
+void forgetPrefetchedDetails(int productId) {
+    lock_guard<mutex> lock(prefetchMutex);
+    prefetched.erase(productId);
+    ++generation;
+}
+
+void clearPrefetchedDetails() {
+    lock_guard<mutex> lock(prefetchMutex);
+    prefetched.clear();
+    ++generation;
+}
+
+void stopProductPrefetcher() {
+    {
+        lock_guard<mutex> lock(prefetchMutex);
+        prefetchStopped = true;
+        if (!prefetchThread.joinable()) return;
+        prefetchStop = true;
+        pending.clear();
+    }
+    prefetchWake.notify_one();
+    prefetchThread.join();
+}
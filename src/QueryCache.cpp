@@ -0,0 +1,94 @@
+// QueryCache.cpp
+// The process-wide product-id result cache
+
+#include "QueryCache.h"
+
+#include <fstream>
+#include <ctime>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+// map/list nodes and the three key strings, roughly
+const size_t ENTRY_OVERHEAD = 160;
+const size_t RESULT_CACHE_ENTRIES = 4096;
+
+long envLong(const char* name, long fallback) {
+    const char* v = getenv(name);
+    if (!v || !*v) return fallback;
+    char* end = nullptr;
+    long n = strtol(v, &end, 10);
+    return (end && *end == '\0' && n >= 0) ? n : fallback;
+}
+
+size_t mix(size_t h, size_t v) {
+    return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+} // namespace
+
+size_t ResultKey::Hash::operator()(const ResultKey &k) const {
+    hash<string> hs;
+    size_t h = (size_t)k.kind;
+    h = mix(h, hs(k.text1));
+    h = mix(h, hs(k.text2));
+    h = mix(h, hs(k.text3));
+    h = mix(h, hash<int64_t>()(k.low));
+    h = mix(h, hash<int64_t>()(k.high));
+    return h;
+}
+
+ProductResultCache& productResultCache() {
+    static ProductResultCache cache(
+        RESULT_CACHE_ENTRIES,
+        (size_t)envLong("PROJECT1_RESULT_CACHE_MB", 16) * 1024 * 1024,
+        chrono::seconds(envLong("PROJECT1_RESULT_CACHE_TTL", 60)));
+    return cache;
+}
+
+void cacheProductResult(const ResultKey &key, const vector<int> &ids, uint64_t readAt) {
+    size_t bytes = ENTRY_OVERHEAD + key.text1.size() + key.text2.size() + key.text3.size()
+                 + ids.size() * sizeof(int);
+    productResultCache().store(key, ids, bytes, readAt);
+}
+
+void invalidateStockResults() {
+    productResultCache().invalidate([](const ResultKey &k) { return k.kind == RQ_SORT_STOCK; });
+}
+
+void invalidatePriceResults() {
+    productResultCache().invalidate([](const ResultKey &k) {
+        return k.kind == RQ_SORT_PRICE_ASC || k.kind == RQ_SORT_PRICE_DESC ||
+               k.kind == RQ_FILTER_PRICE || k.kind == RQ_SEARCH_PRICE;
+    });
+}
+
+void invalidateProductResults() {
+    productResultCache().clear();
+}
+
+void logResultCacheStats() {
+    QueryCacheStats s = productResultCache().stats();
+    if (s.hits + s.misses == 0) return;
+
+    const char* env = getenv("PROJECT1_METRICS_LOG");
+    string path = (env && *env) ? env : "project1_metrics.log";
+
+    ofstream out(path, ios::app);
+    if (!out) return;
+
+    time_t now = time(nullptr);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    out << stamp << " result_cache"
+        << " hits=" << s.hits
+        << " misses=" << s.misses
+        << " hit_pct=" << (100 * s.hits / (s.hits + s.misses))
+        << " expired=" << s.expired
+        << " evictions=" << s.evictions
+        << " invalidations=" << s.invalidations
+        << " entries=" << s.entries
+        << " bytes=" << s.bytes << "\n";
+}
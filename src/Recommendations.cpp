@@ -0,0 +1,371 @@
+// Recommendations.cpp
+// Incremental co-purchase counts with bounded per-product top-k lists
+
+#include "Recommendations.h"
+#include "DBRouter.h"
+
+#include <fstream>
+#include <thread>
+#include <condition_variable>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <atomic>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+const char RECO_MAGIC[8] = {'P', '1', 'C', 'O', 'B', 'U', 'Y', '1'};
+const uint32_t RECO_VERSION = 1;
+
+// catch-up reads at most this many order lines per pass
+const int CATCHUP_ROWS = 200000;
+
+struct RecoHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slots;
+    int64_t lastOrderId;
+    uint64_t productCount;
+    uint64_t payloadSize;
+    uint64_t checksum;
+};
+
+uint64_t fnv1a(const char* p, size_t n) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < n; ++i) h = (h ^ (unsigned char)p[i]) * 0x100000001B3ULL;
+    return h;
+}
+
+// Temp file next to `path` that no other writer uses (pid + per-process counter)
+string tempPathFor(const string &path) {
+    static atomic<unsigned> counter{0};
+#ifdef _WIN32
+    long pid = (long)_getpid();
+#else
+    long pid = (long)getpid();
+#endif
+    return path + ".tmp." + to_string(pid) + "." + to_string(counter++);
+}
+
+template <typename T>
+void put(string &buf, const T &v) {
+    buf.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+bool get(const char* &p, const char* end, T &v) {
+    if ((size_t)(end - p) < sizeof(T)) return false;
+    memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+// background service
+mutex serviceMutex;
+condition_variable serviceWake;
+thread serviceThread;
+bool serviceStop = false;
+
+} // namespace
+
+// ---------------------------------------------
+// CoPurchaseIndex
+// ---------------------------------------------
+CoPurchaseIndex::CoPurchaseIndex() : lastOrderId(0), dirty(false) {}
+
+void CoPurchaseIndex::addPair(int a, int b) {
+    Neighbours &n = byProduct[a];
+    vector<Counter> &c = n.counters;
+
+    auto it = find_if(c.begin(), c.end(), [b](const Counter &x) { return x.productId == b; });
+    if (it != c.end()) {
+        it->count++;
+    } else if (c.size() < NEIGHBOUR_SLOTS) {
+        c.push_back({b, 1});
+        it = c.end() - 1;
+    } else {
+        // Space-Saving: recycle the smallest counter, inheriting its count
+        it = min_element(c.begin(), c.end(),
+                         [](const Counter &x, const Counter &y) { return x.count < y.count; });
+        it->productId = b;
+        it->count++;
+    }
+
+    // refresh the served list only when b can enter (or move within) it
+    uint32_t count = it->count;
+    bool inTop = find(n.top.begin(), n.top.end(), b) != n.top.end();
+    if (!inTop && n.top.size() >= TOP_NEIGHBOURS) {
+        auto last = find_if(c.begin(), c.end(),
+                            [&](const Counter &x) { return x.productId == n.top.back(); });
+        if (last != c.end() && last->count >= count) return;
+    }
+
+    vector<Counter> best(c);
+    size_t k = min(TOP_NEIGHBOURS, best.size());
+    partial_sort(best.begin(), best.begin() + k, best.end(),
+                 [](const Counter &x, const Counter &y) {
+                     return x.count != y.count ? x.count > y.count : x.productId < y.productId;
+                 });
+    n.top.clear();
+    for (size_t i = 0; i < k; ++i) n.top.push_back(best[i].productId);
+}
+
+void CoPurchaseIndex::recordLocked(const vector<int> &productIds) {
+    vector<int> items;
+    for (int id : productIds) {
+        if (items.size() >= MAX_ITEMS_PER_ORDER) break;
+        if (find(items.begin(), items.end(), id) == items.end()) items.push_back(id);
+    }
+    for (size_t i = 0; i < items.size(); ++i)
+        for (size_t j = i + 1; j < items.size(); ++j) {
+            addPair(items[i], items[j]);
+            addPair(items[j], items[i]);
+        }
+    if (items.size() > 1) dirty = true;
+}
+
+void CoPurchaseIndex::recordOrder(int64_t orderId, const vector<int> &productIds) {
+    lock_guard<mutex> lock(mtx);
+    if (orderId <= lastOrderId || !recordedAhead.insert(orderId).second) return;
+    recordLocked(productIds);
+}
+
+vector<int> CoPurchaseIndex::recommend(int productId, size_t k) const {
+    lock_guard<mutex> lock(mtx);
+    auto it = byProduct.find(productId);
+    if (it == byProduct.end()) return {};
+    const vector<int> &top = it->second.top;
+    return vector<int>(top.begin(), top.begin() + min(k, top.size()));
+}
+
+// Note: an order that commits after a higher OrderID has already been read
+// is missed by catch-up; recommendations tolerate that.
+size_t CoPurchaseIndex::catchUp(sql::Connection* con) {
+    int64_t from;
+    {
+        lock_guard<mutex> lock(mtx);
+        from = lastOrderId;
+    }
+
+    sql::PreparedStatement* pstmt = con->prepareStatement(
+        "SELECT OrderID, ProductID FROM OrderItems "
+        "WHERE OrderID > ? ORDER BY OrderID LIMIT ?"
+    );
+    size_t added = 0;
+    bool more = true;
+
+    while (more) {
+        pstmt->setInt64(1, from);
+        pstmt->setInt(2, CATCHUP_ROWS);
+        sql::ResultSet* res = pstmt->executeQuery();
+
+        // group consecutive rows per order; the last order of a full page
+        // may be cut off, so it is left for the next page
+        vector<pair<int64_t, vector<int>>> orders;
+        size_t rows = 0;
+        while (res->next()) {
+            int64_t oid = res->getInt64(1);
+            if (orders.empty() || orders.back().first != oid)
+                orders.push_back({oid, {}});
+            orders.back().second.push_back(res->getInt(2));
+            ++rows;
+        }
+        delete res;
+
+        more = rows == (size_t)CATCHUP_ROWS && orders.size() > 1;
+        if (more) orders.pop_back();
+
+        lock_guard<mutex> lock(mtx);
+        for (auto &o : orders) {
+            if (recordedAhead.erase(o.first) == 0) {
+                recordLocked(o.second);
+                ++added;
+            }
+            lastOrderId = max(lastOrderId, o.first);
+        }
+        if (!orders.empty()) {
+            dirty = true;
+            from = lastOrderId;
+        }
+        // local orders now at or below the watermark can be forgotten
+        for (auto it = recordedAhead.begin(); it != recordedAhead.end(); ) {
+            if (*it <= lastOrderId) it = recordedAhead.erase(it);
+            else ++it;
+        }
+    }
+    delete pstmt;
+    return added;
+}
+
+bool CoPurchaseIndex::save(const string &path) {
+    string payload;
+    RecoHeader h;
+    {
+        lock_guard<mutex> lock(mtx);
+        for (auto &kv : byProduct) {
+            put(payload, (int32_t)kv.first);
+            put(payload, (uint32_t)kv.second.counters.size());
+            for (auto &c : kv.second.counters) {
+                put(payload, (int32_t)c.productId);
+                put(payload, c.count);
+            }
+        }
+        memcpy(h.magic, RECO_MAGIC, sizeof(h.magic));
+        h.version = RECO_VERSION;
+        h.slots = (uint32_t)NEIGHBOUR_SLOTS;
+        h.lastOrderId = lastOrderId;
+        h.productCount = byProduct.size();
+        dirty = false;
+    }
+    h.payloadSize = payload.size();
+    h.checksum = fnv1a(payload.data(), payload.size());
+
+    string tmp = tempPathFor(path);
+    {
+        ofstream out(tmp, ios::binary | ios::trunc);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(payload.data(), (streamsize)payload.size());
+        out.close();
+        if (!out) {
+            cerr << "Failed writing recommendations: " << tmp << endl;
+            remove(tmp.c_str());
+            lock_guard<mutex> lock(mtx);
+            dirty = true;
+            return false;
+        }
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        cerr << "Cannot replace recommendations file: " << path << endl;
+        remove(tmp.c_str());
+        lock_guard<mutex> lock(mtx);
+        dirty = true;
+        return false;
+    }
+    return true;
+}
+
+bool CoPurchaseIndex::load(const string &path) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+    string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+
+    RecoHeader h;
+    if (data.size() < sizeof(h)) return false;
+    memcpy(&h, data.data(), sizeof(h));
+    if (memcmp(h.magic, RECO_MAGIC, sizeof(h.magic)) != 0 || h.version != RECO_VERSION ||
+        h.slots != NEIGHBOUR_SLOTS || h.payloadSize != data.size() - sizeof(h))
+        return false;
+
+    const char* p = data.data() + sizeof(h);
+    const char* end = p + h.payloadSize;
+    if (fnv1a(p, h.payloadSize) != h.checksum) return false;
+
+    unordered_map<int, Neighbours> loaded;
+    loaded.reserve(h.productCount);
+    for (uint64_t i = 0; i < h.productCount; ++i) {
+        int32_t id;
+        uint32_t n;
+        if (!get(p, end, id) || !get(p, end, n) || n > NEIGHBOUR_SLOTS) return false;
+
+        Neighbours &nb = loaded[id];
+        for (uint32_t j = 0; j < n; ++j) {
+            Counter c;
+            int32_t pid;
+            if (!get(p, end, pid) || !get(p, end, c.count)) return false;
+            c.productId = pid;
+            nb.counters.push_back(c);
+        }
+        vector<Counter> best(nb.counters);
+        size_t k = min(TOP_NEIGHBOURS, best.size());
+        partial_sort(best.begin(), best.begin() + k, best.end(),
+                     [](const Counter &x, const Counter &y) {
+                         return x.count != y.count ? x.count > y.count : x.productId < y.productId;
+                     });
+        for (size_t j = 0; j < k; ++j) nb.top.push_back(best[j].productId);
+    }
+
+    lock_guard<mutex> lock(mtx);
+    byProduct.swap(loaded);
+    lastOrderId = h.lastOrderId;
+    recordedAhead.clear();
+    dirty = false;
+    return true;
+}
+
+bool CoPurchaseIndex::isDirty() const {
+    lock_guard<mutex> lock(mtx);
+    return dirty;
+}
+
+size_t CoPurchaseIndex::productCount() const {
+    lock_guard<mutex> lock(mtx);
+    return byProduct.size();
+}
+
+CoPurchaseIndex& coPurchaseIndex() {
+    static CoPurchaseIndex index;
+    return index;
+}
+
+// ---------------------------------------------
+// Background service
+// ---------------------------------------------
+void startRecommendationService(const string &path, int intervalSeconds) {
+    lock_guard<mutex> lock(serviceMutex);
+    if (serviceThread.joinable()) return;
+    serviceStop = false;
+
+    serviceThread = thread([path, intervalSeconds] {
+        CoPurchaseIndex &index = coPurchaseIndex();
+        index.load(path);
+        sql::Connection* con = nullptr;
+
+        while (true) {
+            try {
+                if (!con) con = createReadConnection();
+                index.catchUp(con);
+            } catch (sql::SQLException &e) {
+                cerr << "Recommendations: " << e.what() << endl;
+                if (con) { delete con; con = nullptr; }
+            }
+            if (index.isDirty()) index.save(path);
+
+            unique_lock<mutex> lock(serviceMutex);
+            if (serviceWake.wait_for(lock, chrono::seconds(intervalSeconds),
+                                     [] { return serviceStop; }))
+                break;
+        }
+
+        if (index.isDirty()) index.save(path);
+        if (con) { con->close(); delete con; }
+    });
+}
+
+void stopRecommendationService() {
+    {
+        lock_guard<mutex> lock(serviceMutex);
+        if (!serviceThread.joinable()) return;
+        serviceStop = true;
+    }
+    serviceWake.notify_all();
+    serviceThread.join();
+}
+
+string defaultRecommendationsPath() {
+    const char* env = getenv("PROJECT1_RECOMMENDATIONS");
+    return (env && *env) ? string(env) : string("recommendations.bin");
+}
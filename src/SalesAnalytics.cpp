@@ -0,0 +1,380 @@
+// SalesAnalytics.cpp
+// Columnar order-line store and parallel aggregations
+
+#include "SalesAnalytics.h"
+#include "Date.h"
+
+#include <iostream>
+#include <thread>
+#include <algorithm>
+
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+// order lines fetched per round trip while loading
+const int LOAD_PAGE_ROWS = 500000;
+
+// below this many lines per thread, extra threads cost more than they save
+const size_t MIN_LINES_PER_THREAD = 1 << 16;
+
+// cap on the per-thread partial arrays of one query (all threads together)
+const size_t PARTIAL_BUDGET_BYTES = size_t(1) << 30;
+
+const string UNKNOWN = "(unknown)";
+
+// Runs scan(partial, begin, end) on `threads` contiguous slices of [0, rows)
+// and returns the per-thread partials (each starts as a copy of `init`).
+template <typename Partial, typename Scan>
+vector<Partial> scanParallel(size_t rows, int threads, const Partial &init, Scan scan) {
+    size_t useful = max<size_t>(1, rows / MIN_LINES_PER_THREAD);
+    size_t n = min<size_t>(max(threads, 1), useful);
+
+    vector<Partial> parts(n, init);
+    vector<thread> workers;
+    for (size_t t = 1; t < n; ++t)
+        workers.emplace_back([&, t] { scan(parts[t], rows * t / n, rows * (t + 1) / n); });
+    scan(parts[0], 0, rows / n);
+    for (auto &w : workers) w.join();
+    return parts;
+}
+
+struct Sums {
+    vector<double> revenue;
+    vector<long long> quantity;
+
+    explicit Sums(size_t n = 0) : revenue(n, 0.0), quantity(n, 0) {}
+
+    void add(const Sums &o) {
+        for (size_t i = 0; i < revenue.size(); ++i) {
+            revenue[i] += o.revenue[i];
+            quantity[i] += o.quantity[i];
+        }
+    }
+};
+
+Sums mergeSums(vector<Sums> &parts) {
+    for (size_t t = 1; t < parts.size(); ++t) parts[0].add(parts[t]);
+    return std::move(parts[0]);
+}
+
+} // namespace
+
+// ---------------------------------------------
+// Dates
+// ---------------------------------------------
+int dayNumber(const string &ymd) {
+    return Date::fromSQL(ymd).toDays();      // Date::NONE == INT_MIN
+}
+
+string dayString(int day) {
+    return Date::fromDays(day).toSQL();
+}
+
+// ---------------------------------------------
+// Columns
+// ---------------------------------------------
+void SalesColumns::reserve(size_t n) {
+    day.reserve(n);
+    product.reserve(n);
+    category.reserve(n);
+    company.reserve(n);
+    quantity.reserve(n);
+    price.reserve(n);
+}
+
+SalesAnalytics::SalesAnalytics(int threads)
+    : lastOrderId(0), minDay(INT_MAX), maxDay(INT_MIN),
+      threads(threads > 0 ? threads : max(1, (int)thread::hardware_concurrency())) {}
+
+uint32_t SalesAnalytics::codeFor(vector<string> &dict,
+                                 unordered_map<string, uint32_t> &codes,
+                                 const string &value) {
+    auto it = codes.find(value);
+    if (it != codes.end()) return it->second;
+    uint32_t code = (uint32_t)dict.size();
+    dict.push_back(value);
+    codes.emplace(value, code);
+    return code;
+}
+
+int32_t SalesAnalytics::productFor(int productId) {
+    auto it = productIndex.find(productId);
+    if (it != productIndex.end()) return it->second;
+
+    // line for a product no longer in PRODUCT
+    int32_t idx = (int32_t)productIds.size();
+    productIds.push_back(productId);
+    productNames.push_back("");
+    productCategory.push_back((uint16_t)codeFor(categories, categoryCodes, UNKNOWN));
+    productCompany.push_back(codeFor(companies, companyCodes, UNKNOWN));
+    productIndex.emplace(productId, idx);
+    return idx;
+}
+
+// Product attributes as of now; lines loaded earlier keep the category and
+// company they were loaded with.
+bool SalesAnalytics::loadProducts(sql::Connection* con) {
+    try {
+        sql::Statement* stmt = con->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT Product_ID, Product_Name, Category, Company_name FROM PRODUCT"
+        );
+        while (res->next()) {
+            int id = res->getInt(1);
+            uint32_t cat = codeFor(categories, categoryCodes, res->getString(3));
+            uint32_t comp = codeFor(companies, companyCodes, res->getString(4));
+            if (cat > UINT16_MAX) {
+                cerr << "Too many categories for sales analytics" << endl;
+                delete res;
+                delete stmt;
+                return false;
+            }
+
+            auto it = productIndex.find(id);
+            if (it == productIndex.end()) {
+                productIndex.emplace(id, (int32_t)productIds.size());
+                productIds.push_back(id);
+                productNames.push_back(res->getString(2));
+                productCategory.push_back((uint16_t)cat);
+                productCompany.push_back(comp);
+            } else {
+                productNames[it->second] = res->getString(2);
+                productCategory[it->second] = (uint16_t)cat;
+                productCompany[it->second] = comp;
+            }
+        }
+        delete res;
+        delete stmt;
+        return true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in loadProducts: " << e.what() << endl;
+        return false;
+    }
+}
+
+bool SalesAnalytics::refresh(sql::Connection* con) {
+    if (!con || !loadProducts(con)) return false;
+
+    try {
+        sql::PreparedStatement* pstmt = con->prepareStatement(
+            "SELECT oi.OrderID, o.OrderDate, oi.ProductID, oi.Quantity, oi.PriceAtPurchase "
+            "FROM OrderItems oi JOIN Orders o ON o.OrderID = oi.OrderID "
+            "WHERE oi.OrderID > ? ORDER BY oi.OrderID LIMIT ?"
+        );
+
+        bool more = true;
+        while (more) {
+            pstmt->setInt64(1, lastOrderId);
+            pstmt->setInt(2, LOAD_PAGE_ROWS);
+            sql::ResultSet* res = pstmt->executeQuery();
+
+            size_t rows = res->rowsCount();
+            size_t base = lines.size();
+            if (lines.day.capacity() < base + rows)
+                lines.reserve(max(base + rows, lines.day.capacity() * 2));
+
+            // the page may end part-way through an order: keep the lines of
+            // the last order out of this page and re-read them with the next
+            int64_t lastComplete = lastOrderId, current = lastOrderId;
+            size_t completeLines = base;
+            int date = 0;
+
+            while (res->next()) {
+                int64_t oid = res->getInt64(1);
+                if (oid != current) {
+                    lastComplete = current;
+                    completeLines = lines.size();
+                    current = oid;
+                    date = dayNumber(res->getString(2));
+                }
+                int32_t p = productFor(res->getInt(3));
+                lines.day.push_back(date);
+                lines.product.push_back(p);
+                lines.category.push_back(productCategory[p]);
+                lines.company.push_back(productCompany[p]);
+                lines.quantity.push_back(res->getInt(4));
+                lines.price.push_back(res->getDouble(5));
+            }
+            delete res;
+
+            more = rows == (size_t)LOAD_PAGE_ROWS && lastComplete > lastOrderId;
+            if (more) {
+                lines.day.resize(completeLines);
+                lines.product.resize(completeLines);
+                lines.category.resize(completeLines);
+                lines.company.resize(completeLines);
+                lines.quantity.resize(completeLines);
+                lines.price.resize(completeLines);
+                lastOrderId = lastComplete;
+            } else if (rows > 0) {
+                lastOrderId = current;
+            }
+
+            for (size_t i = base; i < lines.size(); ++i) {
+                if (lines.day[i] == INT_MIN) continue;   // unparsable date: never in range
+                minDay = min(minDay, lines.day[i]);
+                maxDay = max(maxDay, lines.day[i]);
+            }
+        }
+        delete pstmt;
+        return true;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in SalesAnalytics::refresh: " << e.what() << endl;
+        return false;
+    }
+}
+
+size_t SalesAnalytics::memoryBytes() const {
+    size_t n = lines.day.capacity() * sizeof(int32_t)
+             + lines.product.capacity() * sizeof(int32_t)
+             + lines.category.capacity() * sizeof(uint16_t)
+             + lines.company.capacity() * sizeof(uint32_t)
+             + lines.quantity.capacity() * sizeof(int32_t)
+             + lines.price.capacity() * sizeof(double);
+    n += productIds.capacity() * (sizeof(int) + sizeof(string) + sizeof(uint16_t) + sizeof(uint32_t));
+    for (auto &s : productNames) n += s.capacity();
+    return n;
+}
+
+int SalesAnalytics::threadsFor(size_t bytesPerThread) const {
+    if (bytesPerThread == 0) return threads;
+    return (int)max<size_t>(1, min<size_t>(threads, PARTIAL_BUDGET_BYTES / bytesPerThread));
+}
+
+// ---------------------------------------------
+// Queries
+// ---------------------------------------------
+vector<CategoryDayRevenue> SalesAnalytics::revenueByCategoryDay(int fromDay, int toDay) const {
+    vector<CategoryDayRevenue> out;
+    int from = max(fromDay, minDay), to = min(toDay, maxDay);
+    if (lines.size() == 0 || from > to) return out;
+
+    size_t span = (size_t)(to - from) + 1;
+    size_t cells = categories.size() * span;
+
+    const int32_t* day = lines.day.data();
+    const uint16_t* cat = lines.category.data();
+    const int32_t* qty = lines.quantity.data();
+    const double* price = lines.price.data();
+
+    auto parts = scanParallel(lines.size(), threadsFor(cells * 16), Sums(cells),
+        [&](Sums &s, size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                int d = day[i];
+                if (d < from || d > to) continue;
+                size_t cell = (size_t)cat[i] * span + (size_t)(d - from);
+                s.revenue[cell] += price[i] * qty[i];
+                s.quantity[cell] += qty[i];
+            }
+        });
+    Sums total = mergeSums(parts);
+
+    vector<size_t> order(categories.size());
+    for (size_t c = 0; c < order.size(); ++c) order[c] = c;
+    sort(order.begin(), order.end(),
+         [&](size_t a, size_t b) { return categories[a] < categories[b]; });
+
+    for (size_t c : order)
+        for (size_t d = 0; d < span; ++d) {
+            size_t cell = c * span + d;
+            if (total.quantity[cell] == 0) continue;
+            out.push_back({categories[c], from + (int)d, total.revenue[cell], total.quantity[cell]});
+        }
+    return out;
+}
+
+vector<ProductSales> SalesAnalytics::topSellers(size_t k, int fromDay, int toDay,
+                                                const string &category, bool byQuantity) const {
+    vector<ProductSales> out;
+    int catFilter = -1;
+    if (!category.empty()) {
+        auto it = categoryCodes.find(category);
+        if (it == categoryCodes.end()) return out;
+        catFilter = (int)it->second;
+    }
+    if (lines.size() == 0 || k == 0) return out;
+
+    size_t products = productIds.size();
+    const int32_t* day = lines.day.data();
+    const int32_t* prod = lines.product.data();
+    const uint16_t* cat = lines.category.data();
+    const int32_t* qty = lines.quantity.data();
+    const double* price = lines.price.data();
+
+    auto parts = scanParallel(lines.size(), threadsFor(products * 16), Sums(products),
+        [&](Sums &s, size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                if (day[i] < fromDay || day[i] > toDay) continue;
+                if (catFilter >= 0 && cat[i] != catFilter) continue;
+                s.revenue[prod[i]] += price[i] * qty[i];
+                s.quantity[prod[i]] += qty[i];
+            }
+        });
+    Sums total = mergeSums(parts);
+
+    vector<int32_t> sold;
+    for (size_t p = 0; p < products; ++p)
+        if (total.quantity[p] != 0) sold.push_back((int32_t)p);
+
+    auto better = [&](int32_t a, int32_t b) {
+        if (byQuantity && total.quantity[a] != total.quantity[b])
+            return total.quantity[a] > total.quantity[b];
+        if (total.revenue[a] != total.revenue[b]) return total.revenue[a] > total.revenue[b];
+        return productIds[a] < productIds[b];
+    };
+    k = min(k, sold.size());
+    partial_sort(sold.begin(), sold.begin() + k, sold.end(), better);
+
+    for (size_t i = 0; i < k; ++i) {
+        int32_t p = sold[i];
+        out.push_back({productIds[p], productNames[p], categories[productCategory[p]],
+                       total.revenue[p], total.quantity[p]});
+    }
+    return out;
+}
+
+vector<BrandShare> SalesAnalytics::brandShare(int fromDay, int toDay, const string &category) const {
+    vector<BrandShare> out;
+    int catFilter = -1;
+    if (!category.empty()) {
+        auto it = categoryCodes.find(category);
+        if (it == categoryCodes.end()) return out;
+        catFilter = (int)it->second;
+    }
+    if (lines.size() == 0) return out;
+
+    size_t n = companies.size();
+    const int32_t* day = lines.day.data();
+    const uint16_t* cat = lines.category.data();
+    const uint32_t* comp = lines.company.data();
+    const int32_t* qty = lines.quantity.data();
+    const double* price = lines.price.data();
+
+    auto parts = scanParallel(lines.size(), threadsFor(n * 16), Sums(n),
+        [&](Sums &s, size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                if (day[i] < fromDay || day[i] > toDay) continue;
+                if (catFilter >= 0 && cat[i] != catFilter) continue;
+                s.revenue[comp[i]] += price[i] * qty[i];
+                s.quantity[comp[i]] += qty[i];
+            }
+        });
+    Sums total = mergeSums(parts);
+
+    double sum = 0.0;
+    for (size_t c = 0; c < n; ++c) sum += total.revenue[c];
+    for (size_t c = 0; c < n; ++c)
+        if (total.quantity[c] != 0)
+            out.push_back({companies[c], total.revenue[c], sum > 0.0 ? total.revenue[c] / sum : 0.0});
+
+    sort(out.begin(), out.end(), [](const BrandShare &a, const BrandShare &b) {
+        return a.revenue != b.revenue ? a.revenue > b.revenue : a.company < b.company;
+    });
+    return out;
+}
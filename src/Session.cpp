@@ -0,0 +1,111 @@
+// Session.cpp
+// HMAC-signed session tokens and the remembered-session file
+
+#include "Session.h"
+#include "Crypto.h"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <ctime>
+#include <cstdlib>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+string homeFile(const char* name) {
+    const char* home = getenv("HOME");
+    return string(home && *home ? home : ".") + "/" + name;
+}
+
+void restrictToOwner(const string &path) {
+#ifndef _WIN32
+    chmod(path.c_str(), S_IRUSR | S_IWUSR);
+#else
+    (void)path;
+#endif
+}
+
+string sessionKey() {
+    static string key;
+    if (!key.empty()) return key;
+
+    const char* env = getenv("PROJECT1_SESSION_KEY");
+    if (env && *env) return key = env;
+
+    string path = homeFile(".project1_session_key");
+    ifstream in(path);
+    string hex;
+    if (in >> hex && fromHex(hex, key) && key.size() >= 32) return key;
+
+    key = randomBytes(32);
+    ofstream out(path, ios::trunc);
+    out << toHex(key) << "\n";
+    out.close();
+    restrictToOwner(path);
+    return key;
+}
+
+vector<string> split(const string &s, char sep) {
+    vector<string> parts;
+    string cur;
+    istringstream in(s);
+    while (getline(in, cur, sep)) parts.push_back(cur);
+    return parts;
+}
+
+} // namespace
+
+string issueSessionToken(const CustomerSession &s, long ttlSeconds) {
+    long expiry = (long)time(nullptr) + ttlSeconds;
+    string body = "1|" + to_string(s.customerId) + "|" + to_string(expiry) + "|"
+                + toHex(s.email) + "|" + toHex(s.name);
+    return body + "|" + toHex(hmacSha256(sessionKey(), body));
+}
+
+bool verifySessionToken(const string &token, CustomerSession &out) {
+    size_t cut = token.rfind('|');
+    if (cut == string::npos) return false;
+
+    string body = token.substr(0, cut);
+    string expected = toHex(hmacSha256(sessionKey(), body));
+    if (!constantTimeEquals(expected, token.substr(cut + 1))) return false;
+
+    vector<string> f = split(body, '|');
+    if (f.size() < 5 || f[0] != "1") return false;
+    if (atol(f[2].c_str()) < (long)time(nullptr)) return false;
+
+    CustomerSession s;
+    s.customerId = atoi(f[1].c_str());
+    if (s.customerId <= 0 || !fromHex(f[3], s.email) || !fromHex(f[4], s.name)) return false;
+
+    out = s;
+    return true;
+}
+
+bool saveSessionToken(const string &token) {
+    string path = homeFile(".project1_session");
+    ofstream out(path, ios::trunc);
+    if (!out) return false;
+    out << token << "\n";
+    out.close();
+    restrictToOwner(path);
+    return true;
+}
+
+bool loadSavedSession(CustomerSession &out) {
+    ifstream in(homeFile(".project1_session"));
+    string token;
+    if (!(in >> token)) return false;
+    return verifySessionToken(token, out);
+}
+
+void clearSavedSession() {
+    remove(homeFile(".project1_session").c_str());
+}
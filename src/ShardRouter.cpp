@@ -0,0 +1,341 @@
+// ShardRouter.cpp
+// Shard list, cached bucket map, per-thread shard connections
+
+#include "ShardRouter.h"
+#include "Statements.h"
+
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+#include <iostream>
+#include <mutex>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+const int DEFAULT_MAP_SECONDS = 10;
+const int MAP_RETRY_SECONDS = 1;          // after a failed SHARD_MAP read
+const int SHARD_PROBE_SECONDS = 10;       // ping a reused shard connection at most this often
+const int ER_NO_SUCH_TABLE = 1146;
+
+typedef chrono::steady_clock Clock;
+
+string trim(const string &s) {
+    size_t a = s.find_first_not_of(" \t");
+    if (a == string::npos) return "";
+    size_t b = s.find_last_not_of(" \t");
+    return s.substr(a, b - a + 1);
+}
+
+struct ShardConfig {
+    vector<DBEndpoint> shards;
+    vector<bool> global;
+};
+
+// PROJECT1_DB_SHARDS, parsed once
+const ShardConfig& config() {
+    static const ShardConfig cfg = [] {
+        ShardConfig c;
+        const char* list = getenv("PROJECT1_DB_SHARDS");
+        if (!list || !*list) return c;
+
+        DBEndpoint primary;
+        dbEndpoint(DB_PRIMARY, primary);
+
+        string all = list;
+        size_t start = 0;
+        while (start <= all.size()) {
+            size_t comma = all.find(',', start);
+            if (comma == string::npos) comma = all.size();
+            string entry = trim(all.substr(start, comma - start));
+            start = comma + 1;
+            if (entry.empty()) continue;
+
+            DBEndpoint ep = primary;
+            size_t scheme = entry.find("://");
+            if (scheme != string::npos) {
+                size_t slash = entry.find('/', scheme + 3);
+                if (slash == string::npos || slash + 1 == entry.size()) {
+                    cerr << "PROJECT1_DB_SHARDS: no schema in '" << entry << "', ignored\n";
+                    continue;
+                }
+                ep.url = entry.substr(0, slash);
+                ep.schema = entry.substr(slash + 1);
+            } else {
+                ep.schema = entry;
+            }
+            c.global.push_back(ep.url == primary.url && ep.schema == primary.schema);
+            c.shards.push_back(ep);
+        }
+        return c;
+    }();
+    return cfg;
+}
+
+// ---------------------------------------------
+// Bucket map (SHARD_MAP in the global schema)
+// ---------------------------------------------
+struct BucketMap {
+    int shard[SHARD_BUCKETS] = {};
+    bool moving[SHARD_BUCKETS] = {};
+};
+
+// the router's own global connection, for reading SHARD_MAP
+struct MapConnection {
+    sql::Connection* con = nullptr;
+    ~MapConnection() {
+        if (!con) return;
+        try {
+            con->close();
+        } catch (sql::SQLException &) {}
+        delete con;
+    }
+};
+
+mutex mapMutex;
+BucketMap bucketMap;
+bool mapLoaded = false;
+Clock::time_point mapLoadedAt;
+Clock::time_point mapRefreshAt;
+MapConnection mapConnection;
+
+// Caller holds mapMutex
+void refreshMapLocked() {
+    Clock::time_point now = Clock::now();
+    if (mapLoaded && now < mapRefreshAt) return;
+
+    BucketMap fresh;
+    try {
+        if (!mapConnection.con) {
+            DBEndpoint ep;
+            dbEndpoint(DB_PRIMARY, ep);
+            mapConnection.con = openConnection(ep);
+        }
+        sql::Statement* stmt = mapConnection.con->createStatement();
+        sql::ResultSet* res = nullptr;
+        try {
+            res = stmt->executeQuery("SELECT Bucket, Shard, Moving FROM SHARD_MAP");
+            while (res->next()) {
+                int bucket = res->getInt(1);
+                if (bucket < 0 || bucket >= SHARD_BUCKETS) continue;
+                fresh.shard[bucket] = res->getInt(2);
+                fresh.moving[bucket] = res->getInt(3) != 0;
+            }
+        } catch (sql::SQLException &e) {
+            delete res;
+            delete stmt;
+            if (e.getErrorCode() != ER_NO_SUCH_TABLE) throw;
+            // no SHARD_MAP yet: every bucket is on shard 0
+            fresh = BucketMap();
+            res = nullptr;
+            stmt = nullptr;
+        }
+        delete res;
+        delete stmt;
+    } catch (sql::SQLException &e) {
+        // keep the map we have and try again shortly
+        cerr << "SQL Error in shard map refresh: " << e.what() << endl;
+        delete mapConnection.con;
+        mapConnection.con = nullptr;
+        mapRefreshAt = now + chrono::seconds(MAP_RETRY_SECONDS);
+        if (mapLoaded) return;
+        throw;
+    }
+
+    bucketMap = fresh;
+    mapLoaded = true;
+    mapLoadedAt = now;
+    mapRefreshAt = now + chrono::seconds(shardMapSeconds());
+}
+
+// `current` is false when the map is older than shardMapMaxAge(): a move
+// may have started that this process has not seen
+int lookup(int customerId, bool &moving, bool &current) {
+    if (customerId <= 0) throw sql::SQLException("shard lookup without a customer id");
+    int bucket = shardBucket(customerId);
+    int shard;
+    {
+        lock_guard<mutex> lock(mapMutex);
+        refreshMapLocked();
+        shard = bucketMap.shard[bucket];
+        moving = bucketMap.moving[bucket];
+        current = Clock::now() - mapLoadedAt <= chrono::seconds(shardMapMaxAge());
+    }
+    if (shard < 0 || shard >= shardCount())
+        throw sql::SQLException("bucket " + to_string(bucket) + " is mapped to shard " +
+                                to_string(shard) + ", which is not in PROJECT1_DB_SHARDS");
+    return shard;
+}
+
+// ---------------------------------------------
+// Per-thread shard connections, closed when the thread exits
+// ---------------------------------------------
+struct ShardConnection {
+    sql::Connection* con = nullptr;
+    Clock::time_point probedAt;
+};
+
+struct ShardConnections {
+    vector<ShardConnection> cons;
+    ~ShardConnections() {
+        for (ShardConnection &c : cons) {
+            if (!c.con) continue;
+            try {
+                c.con->close();
+            } catch (sql::SQLException &) {}
+            delete c.con;
+        }
+    }
+};
+
+thread_local ShardConnections threadShards;
+
+sql::Connection* threadShard(int shard) {
+    vector<ShardConnection> &cons = threadShards.cons;
+    if (cons.size() <= (size_t)shard) cons.resize(shard + 1);
+
+    ShardConnection &c = cons[shard];
+    Clock::time_point now = Clock::now();
+    if (c.con) {
+        // reuse it as is; a server round trip only every SHARD_PROBE_SECONDS
+        if (now - c.probedAt < chrono::seconds(SHARD_PROBE_SECONDS)) return c.con;
+
+        bool alive = false;
+        try {
+            alive = c.con->isValid() || c.con->reconnect();
+        } catch (sql::SQLException &) {}
+        if (alive) {
+            c.probedAt = now;
+            return c.con;
+        }
+        delete c.con;
+        c.con = nullptr;
+    }
+    c.con = openShardConnection(shard);
+    c.probedAt = now;
+    return c.con;
+}
+
+} // namespace
+
+bool shardingEnabled() {
+    return !config().shards.empty();
+}
+
+int shardCount() {
+    size_t n = config().shards.size();
+    return n ? (int)n : 1;
+}
+
+int shardMapSeconds() {
+    static const int seconds = [] {
+        const char* v = getenv("PROJECT1_SHARD_MAP_SECONDS");
+        int s = (v && *v) ? atoi(v) : DEFAULT_MAP_SECONDS;
+        return s > 0 ? s : DEFAULT_MAP_SECONDS;
+    }();
+    return seconds;
+}
+
+int shardMapMaxAge() {
+    return shardMapSeconds() + MAP_RETRY_SECONDS;
+}
+
+bool shardEndpoint(int shard, DBEndpoint &out) {
+    const ShardConfig &c = config();
+    if (c.shards.empty()) {
+        if (shard != 0) return false;
+        return dbEndpoint(DB_PRIMARY, out);
+    }
+    if (shard < 0 || shard >= (int)c.shards.size()) return false;
+    out = c.shards[shard];
+    return true;
+}
+
+bool isGlobalShard(int shard) {
+    const ShardConfig &c = config();
+    if (c.shards.empty()) return shard == 0;
+    return shard >= 0 && shard < (int)c.global.size() && c.global[shard];
+}
+
+sql::Connection* openShardConnection(int shard) {
+    DBEndpoint ep;
+    if (!shardEndpoint(shard, ep))
+        throw sql::SQLException("no shard " + to_string(shard) + " in PROJECT1_DB_SHARDS");
+    return openConnection(ep);
+}
+
+int shardOf(int customerId) {
+    if (!shardingEnabled()) return 0;
+    bool moving, current;
+    return lookup(customerId, moving, current);
+}
+
+bool inGlobalSchema(int customerId) {
+    if (!shardingEnabled()) return true;
+    bool moving, current;
+    return isGlobalShard(lookup(customerId, moving, current));
+}
+
+sql::Connection* shardRead(sql::Connection* global, int customerId) {
+    if (!shardingEnabled()) return routeRead(global, customerId);
+
+    // reads may go by an old map; at worst they miss rows that just moved
+    bool moving, current;
+    int shard = lookup(customerId, moving, current);
+    if (isGlobalShard(shard)) return routeRead(global, customerId);
+    return threadShard(shard);
+}
+
+sql::Connection* shardWrite(sql::Connection* global, int customerId) {
+    if (!shardingEnabled()) return global;
+
+    bool moving, current;
+    int shard = lookup(customerId, moving, current);
+    if (moving)
+        throw sql::SQLException("this account is being moved to another shard; try again shortly");
+    if (!current)
+        throw sql::SQLException("the shard map could not be refreshed; try again shortly");
+    if (isGlobalShard(shard)) return global;
+    return threadShard(shard);
+}
+
+void reloadShardMap() {
+    lock_guard<mutex> lock(mapMutex);
+    mapRefreshAt = Clock::time_point();
+}
+
+void loadProductFacts(sql::Connection* global, int customerId, const vector<int> &productIds,
+                      unordered_map<int, ProductFacts> &out) {
+    out.clear();
+    if (productIds.empty()) return;
+
+    sql::Connection* con = routeRead(global, customerId);
+    string sql = string(stmts::PRODUCT_FACTS.sql) +
+                 " WHERE Product_ID IN (" + sqlreg::placeholders(productIds.size()) + ")";
+
+    sql::PreparedStatement* pstmt = con->prepareStatement(sql);
+    sql::ResultSet* res = nullptr;
+    try {
+        for (size_t i = 0; i < productIds.size(); ++i)
+            pstmt->setInt((unsigned int)i + 1, productIds[i]);
+        res = pstmt->executeQuery();
+        out.reserve(res->rowsCount());
+        while (res->next()) {
+            ProductFacts f = sqlreg::readAs<ProductFacts>(res, stmts::PRODUCT_FACTS);
+            int id = f.productId;
+            out.emplace(id, std::move(f));
+        }
+    } catch (...) {
+        delete res;
+        delete pstmt;
+        throw;
+    }
+
+    delete res;
+    delete pstmt;
+}
@@ -0,0 +1,59 @@
+// StringPool.cpp
+#include "StringPool.h"
+
+using namespace std;
+
+StringPool& StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool::Shard& StringPool::shardFor(string_view s) {
+    return shards[hash<string_view>()(s) % SHARDS];
+}
+
+const string* StringPool::intern(string_view s) {
+    if (s.empty()) return &emptyValue;
+
+    Shard &sh = shardFor(s);
+    lock_guard<mutex> lock(sh.mtx);
+    auto it = sh.index.find(s);
+    if (it != sh.index.end()) return it->second;
+
+    sh.values.emplace_back(s);
+    const string* p = &sh.values.back();
+    sh.index.emplace(string_view(*p), p);     // key views the pooled copy
+    const char* text = p->data();
+    if (text < (const char*)p || text >= (const char*)(p + 1))    // not stored inline
+        sh.bytes += p->capacity() + 1;
+    return p;
+}
+
+const string* StringPool::find(string_view s) {
+    if (s.empty()) return &emptyValue;
+
+    Shard &sh = shardFor(s);
+    lock_guard<mutex> lock(sh.mtx);
+    auto it = sh.index.find(s);
+    return it == sh.index.end() ? nullptr : it->second;
+}
+
+size_t StringPool::size() {
+    size_t n = 0;
+    for (auto &sh : shards) {
+        lock_guard<mutex> lock(sh.mtx);
+        n += sh.values.size();
+    }
+    return n;
+}
+
+size_t StringPool::memoryBytes() {
+    size_t bytes = 0;
+    for (auto &sh : shards) {
+        lock_guard<mutex> lock(sh.mtx);
+        // deque slot + out-of-line text + hash node and bucket
+        bytes += sh.values.size() * (sizeof(string) + sizeof(string_view) + 3 * sizeof(void*))
+               + sh.index.bucket_count() * sizeof(void*) + sh.bytes;
+    }
+    return bytes;
+}
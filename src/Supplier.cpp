@@ -1,13 +1,5 @@
 #include "Supplier.h"
 
-Supplier::Supplier() {
-    // default constructor (empty or give default values)
-}
-
-Supplier::Supplier(int i, string n, long int cnum, string e, string add) {
-    this->id = i;
-    this->name = n;
-    this->cont_num = cnum;
-    this->email = e;
-    this->address = add;
-}
+// strings are taken by value and moved in
+Supplier::Supplier(int i, string n, long int cnum, string e, string add)
+    : id(i), name(std::move(n)), cont_num(cnum), email(std::move(e)), address(std::move(add)) {}
@@ -1,34 +1,92 @@
 #include "WishlistFunctions.h"
+#include "RequestArena.h"
+#include "CartFunctions.h"
+#include "BatchInsert.h"
+#include "DBRouter.h"
+#include "ShardRouter.h"
+#include "Statements.h"
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <limits>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
 #include <cppconn/prepared_statement.h>
 #include <cppconn/resultset.h>
+#include <cppconn/exception.h>
 
 using namespace std;
 
+namespace {
+
+const int ER_DUP_ENTRY = 1062;
+const int ER_NO_REFERENCED_ROW_2 = 1452;    // foreign key: no such product
+
+// session membership (see loadWishlistMembership)
+mutex membershipMutex;
+int membershipCustomer = -1;
+unordered_set<int> membership;
+
+void noteMembership(int customerId, const vector<int> &productIds, bool present) {
+    lock_guard<mutex> lock(membershipMutex);
+    if (customerId != membershipCustomer) return;
+    for (int pid : productIds) {
+        if (present) membership.insert(pid);
+        else membership.erase(pid);
+    }
+}
+
+string placeholders(size_t n) {
+    string s = "?";
+    for (size_t i = 1; i < n; ++i) s += ", ?";
+    return s;
+}
+
+// Which of `productIds` exist in PRODUCT. Needed on a shard, where WISHLIST
+// has no foreign key to the global PRODUCT table.
+unordered_set<int> knownProducts(sql::Connection* global, int customerId, const vector<int> &productIds) {
+    unordered_map<int, ProductFacts> facts;
+    loadProductFacts(global, customerId, productIds, facts);
+    unordered_set<int> known;
+    for (auto &f : facts) known.insert(f.first);
+    return known;
+}
+
+} // namespace
+
 // ADD TO WISHLIST
 bool addToWishlist(sql::Connection* con, int customerId, int productId) {
     try {
-        sql::PreparedStatement* check =
-            con->prepareStatement("SELECT * FROM WISHLIST WHERE CustomerID = ? AND ProductID = ?");
-        check->setInt(1, customerId);
-        check->setInt(2, productId);
-
-        sql::ResultSet* res = check->executeQuery();
-        if (res->next()) {
-            cout << "⚠ Already in wishlist.\n";
-            delete res; delete check;
+        sql::Connection* wcon = shardWrite(con, customerId);
+        if (wcon != con && knownProducts(con, customerId, {productId}).empty()) {
+            cout << "⚠ No such product.\n";
             return false;
         }
-        delete res; delete check;
 
+        // one statement: the unique key turns a repeated add into ER_DUP_ENTRY
         sql::PreparedStatement* pstmt =
-            con->prepareStatement("INSERT INTO WISHLIST(CustomerID, ProductID) VALUES(?, ?)");
+            wcon->prepareStatement("INSERT INTO WISHLIST(CustomerID, ProductID) VALUES(?, ?)");
         pstmt->setInt(1, customerId);
         pstmt->setInt(2, productId);
-
-        pstmt->executeUpdate();
+        try {
+            pstmt->executeUpdate();
+        } catch (sql::SQLException &e) {
+            delete pstmt;
+            if (e.getErrorCode() == ER_DUP_ENTRY) {
+                noteMembership(customerId, {productId}, true);
+                cout << "⚠ Already in wishlist.\n";
+                return false;
+            }
+            if (e.getErrorCode() == ER_NO_REFERENCED_ROW_2) {
+                cout << "⚠ No such product.\n";
+                return false;
+            }
+            throw;
+        }
         delete pstmt;
+        noteMembership(customerId, {productId}, true);
+        noteWrite(customerId);
 
         cout << "✔ Added to wishlist.\n";
         return true;
@@ -42,6 +100,7 @@ bool addToWishlist(sql::Connection* con, int customerId, int productId) {
 // REMOVE
 bool removeFromWishlist(sql::Connection* con, int customerId, int productId) {
     try {
+        con = shardWrite(con, customerId);
         sql::PreparedStatement* pstmt =
             con->prepareStatement("DELETE FROM WISHLIST WHERE CustomerID = ? AND ProductID = ?");
         pstmt->setInt(1, customerId);
@@ -49,8 +108,10 @@ bool removeFromWishlist(sql::Connection* con, int customerId, int productId) {
 
         int rows = pstmt->executeUpdate();
         delete pstmt;
+        noteMembership(customerId, {productId}, false);
 
         if (rows > 0) {
+            noteWrite(customerId);
             cout << "✔ Removed from wishlist.\n";
             return true;
         }
@@ -64,51 +125,207 @@ bool removeFromWishlist(sql::Connection* con, int customerId, int productId) {
     }
 }
 
-// VIEW WISHLIST
-vector<Wishlist> viewWishlist(sql::Connection* con, int customerId) {
-    vector<Wishlist> items;
+// ADD MANY
+int addManyToWishlist(sql::Connection* con, int customerId, const vector<int> &productIds) {
+    if (productIds.empty()) return 0;
+    try {
+        sql::Connection* wcon = shardWrite(con, customerId);
 
+        // unknown products are skipped, ids already listed are kept as they are
+        unordered_set<int> known = knownProducts(con, customerId, productIds);
+        vector<int> wanted;
+        unordered_set<int> seen;
+        for (int pid : productIds)
+            if (known.count(pid) && seen.insert(pid).second) wanted.push_back(pid);
+        if (wanted.empty()) return 0;
+
+        unordered_set<int> present;
+        sql::PreparedStatement* pstmt = wcon->prepareStatement(
+            "SELECT ProductID FROM WISHLIST WHERE CustomerID = ? AND ProductID IN (" +
+            placeholders(wanted.size()) + ")"
+        );
+        pstmt->setInt(1, customerId);
+        for (size_t i = 0; i < wanted.size(); ++i) pstmt->setInt(i + 2, wanted[i]);
+        sql::ResultSet* res = pstmt->executeQuery();
+        while (res->next()) present.insert(res->getInt(1));
+        delete res;
+        delete pstmt;
+
+        vector<int> fresh;
+        for (int pid : wanted)
+            if (!present.count(pid)) fresh.push_back(pid);
+
+        if (!fresh.empty()) {
+            // a concurrent add of the same id is a no-op; anything else still fails
+            MultiRowStatement insert(wcon, "INSERT INTO WISHLIST(CustomerID, ProductID)",
+                                     2, fresh.size(), "ON DUPLICATE KEY UPDATE ProductID = ProductID");
+            pstmt = insert.begin(fresh.size());
+            for (size_t r = 0; r < fresh.size(); ++r) {
+                pstmt->setInt(insert.param(r, 0), customerId);
+                pstmt->setInt(insert.param(r, 1), fresh[r]);
+            }
+            pstmt->executeUpdate();
+            noteWrite(customerId);
+        }
+
+        noteMembership(customerId, wanted, true);
+        return (int)fresh.size();
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in addManyToWishlist: " << e.what() << endl;
+        return -1;
+    }
+}
+
+// REMOVE MANY
+int removeManyFromWishlist(sql::Connection* con, int customerId, const vector<int> &productIds) {
+    if (productIds.empty()) return 0;
     try {
-        sql::PreparedStatement* pstmt =
-            con->prepareStatement(
-                "SELECT W.WishlistID, W.ProductID, P.Product_Name, P.Price "
-                "FROM WISHLIST W JOIN PRODUCT P ON W.ProductID = P.Product_ID "
-                "WHERE W.CustomerID = ?"
-            );
+        con = shardWrite(con, customerId);
+        sql::PreparedStatement* pstmt = con->prepareStatement(
+            "DELETE FROM WISHLIST WHERE CustomerID = ? AND ProductID IN (" +
+            placeholders(productIds.size()) + ")"
+        );
         pstmt->setInt(1, customerId);
+        for (size_t i = 0; i < productIds.size(); ++i) pstmt->setInt(i + 2, productIds[i]);
+
+        int rows = pstmt->executeUpdate();
+        delete pstmt;
+
+        noteMembership(customerId, productIds, false);
+        if (rows > 0) noteWrite(customerId);
+        return rows;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in removeManyFromWishlist: " << e.what() << endl;
+        return -1;
+    }
+}
+
+// MOVE ALL TO CART
+bool moveWishlistToCart(sql::Connection* con, int customerId, int &moved,
+                        vector<StockShortfall> &unavailable) {
+    moved = 0;
+    unavailable.clear();
 
+    vector<pair<int, int>> lines;
+    try {
+        sql::PreparedStatement* pstmt = shardWrite(con, customerId)->prepareStatement(
+            "SELECT ProductID FROM WISHLIST WHERE CustomerID = ?"
+        );
+        pstmt->setInt(1, customerId);
         sql::ResultSet* res = pstmt->executeQuery();
+        while (res->next()) lines.push_back({res->getInt(1), 1});
+        delete res;
+        delete pstmt;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in moveWishlistToCart: " << e.what() << endl;
+        return false;
+    }
+    if (lines.empty()) return true;
 
-        cout << "\n========== YOUR WISHLIST ==========\n";
-        cout << left << setw(6) << "No."
-             << setw(10) << "PID"
-             << setw(35) << "Product Name"
-             << setw(10) << "Price"
-             << endl;
-        cout << string(70, '-') << endl;
-
-        int index = 1;
-        while (res->next()) {
-            int wid = res->getInt("WishlistID");
-            int pid = res->getInt("ProductID");
-            string name = res->getString("Product_Name");
-            double price = res->getDouble("Price");
-
-            cout << left << setw(6) << index
-                 << setw(10) << pid
-                 << setw(35) << name
-                 << setw(10) << price
-                 << endl;
-
-            items.push_back(Wishlist(wid, customerId, pid));
-            index++;
-        }
+    if (!addManyToCart(con, customerId, lines, unavailable, moved)) return false;
 
+    // quantity is 1, so a shortfall means nothing was added for that item
+    unordered_set<int> missing;
+    for (auto &s : unavailable) missing.insert(s.productId);
+    vector<int> done;
+    for (auto &l : lines)
+        if (!missing.count(l.first)) done.push_back(l.first);
+
+    return removeManyFromWishlist(con, customerId, done) >= 0;
+}
+
+// MEMBERSHIP
+void loadWishlistMembership(sql::Connection* con, int customerId) {
+    unordered_set<int> ids;
+    try {
+        con = shardRead(con, customerId);
+        sql::PreparedStatement* pstmt =
+            con->prepareStatement("SELECT ProductID FROM WISHLIST WHERE CustomerID = ?");
+        pstmt->setInt(1, customerId);
+        sql::ResultSet* res = pstmt->executeQuery();
+        while (res->next()) ids.insert(res->getInt(1));
         delete res;
         delete pstmt;
     }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in loadWishlistMembership: " << e.what() << endl;
+        return;
+    }
+
+    lock_guard<mutex> lock(membershipMutex);
+    membershipCustomer = customerId;
+    membership.swap(ids);
+}
+
+bool inSessionWishlist(int productId) {
+    lock_guard<mutex> lock(membershipMutex);
+    return membership.count(productId) != 0;
+}
+
+// VIEW WISHLIST
+pmr::vector<Wishlist> viewWishlist(sql::Connection* con, int customerId,
+                                   pmr::memory_resource* mr) {
+    pmr::vector<Wishlist> items(mr);
+
+    struct Line { int wid; int pid; string name; Money price; };
+    vector<Line> lines;
+    try {
+        if (inGlobalSchema(customerId)) {
+            sql::PreparedStatement* pstmt =
+                sqlreg::prepare(routeRead(con, customerId), stmts::WISHLIST_ITEMS, customerId);
+            sql::ResultSet* res = pstmt->executeQuery();
+            while (res->next()) {
+                auto [wid, pid, name, price] = sqlreg::readRow(res, stmts::WISHLIST_ITEMS);
+                lines.push_back({wid, pid, std::move(name), price});
+            }
+            delete res;
+            delete pstmt;
+        } else {
+            // WISHLIST rows from the shard, names and prices from PRODUCT
+            sql::PreparedStatement* pstmt =
+                sqlreg::prepare(shardRead(con, customerId), stmts::WISHLIST_ROWS, customerId);
+            sql::ResultSet* res = pstmt->executeQuery();
+            vector<pair<int, int>> rows;
+            while (res->next()) rows.push_back(sqlreg::readAs<pair<int, int>>(res, stmts::WISHLIST_ROWS));
+            delete res;
+            delete pstmt;
+
+            vector<int> ids;
+            for (auto &r : rows) ids.push_back(r.second);
+            unordered_map<int, ProductFacts> facts;
+            loadProductFacts(con, customerId, ids, facts);
+            for (auto &r : rows) {
+                auto it = facts.find(r.second);
+                if (it != facts.end()) lines.push_back({r.first, r.second, it->second.name, it->second.price});
+            }
+        }
+    }
     catch (sql::SQLException &e) {
         cerr << "SQL Error in viewWishlist: " << e.what() << endl;
+        return items;
+    }
+
+    cout << "\n========== YOUR WISHLIST ==========\n";
+    cout << left << setw(6) << "No."
+         << setw(10) << "PID"
+         << setw(35) << "Product Name"
+         << setw(10) << "Price"
+         << endl;
+    cout << string(70, '-') << endl;
+
+    int index = 1;
+    for (const Line &l : lines) {
+        cout << left << setw(6) << index
+             << setw(10) << l.pid
+             << setw(35) << l.name
+             << setw(10) << l.price
+             << endl;
+
+        items.emplace_back(l.wid, customerId, l.pid);
+        index++;
     }
 
     return items;
@@ -119,7 +336,8 @@ void runWishlistMenu(sql::Connection* con, int customerId) {
     while (true) {
         cout << "\n========== WISHLIST MENU ==========\n";
         cout << "1) View Wishlist\n";
-        cout << "2) Remove Item\n";
+        cout << "2) Remove Items\n";
+        cout << "3) Move All to Cart\n";
         cout << "0) Back\n";
         cout << "Enter choice: ";
 
@@ -129,13 +347,35 @@ void runWishlistMenu(sql::Connection* con, int customerId) {
         if (ch == 0) return;
 
         if (ch == 1) {
-            viewWishlist(con, customerId);
+            RequestArena arena;
+            viewWishlist(con, customerId, arena.resource());
         }
         else if (ch == 2) {
+            cout << "Enter Product IDs to remove (space separated): ";
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            string line;
+            getline(cin, line);
+
+            vector<int> ids;
+            istringstream in(line);
             int pid;
-            cout << "Enter Product ID to remove: ";
-            cin >> pid;
-            removeFromWishlist(con, customerId, pid);
+            while (in >> pid) ids.push_back(pid);
+
+            int rows = removeManyFromWishlist(con, customerId, ids);
+            if (rows > 0) cout << "✔ Removed " << rows << " item(s) from wishlist.\n";
+            else if (rows == 0) cout << "⚠ None of those are in your wishlist.\n";
+        }
+        else if (ch == 3) {
+            int moved = 0;
+            vector<StockShortfall> unavailable;
+            if (!moveWishlistToCart(con, customerId, moved, unavailable)) {
+                cout << "❌ Could not move items to cart.\n";
+                continue;
+            }
+            cout << "✔ Moved " << moved << " item(s) to cart.\n";
+            for (auto &s : unavailable)
+                cout << "⚠ Out of stock, kept in wishlist: " << s.name
+                     << " (PID " << s.productId << ")\n";
         }
         else {
             cout << "❌ Invalid choice.\n";
@@ -1,9 +1,12 @@
 #include "login.h"
+#include "PasswordHasher.h"
+#include "DBRouter.h"
 #include <iostream>
 #include <limits>
 #include <cppconn/prepared_statement.h>
 #include <cppconn/resultset.h>
 #include <cppconn/exception.h>
+#include <cppconn/statement.h>
 #include <cctype>
 
 using namespace std;
@@ -27,6 +30,28 @@ static bool isValidPassword(const string& pwd) {
     return hasUpper && hasLower && hasDigit && hasSpecial;
 }
 
+// Helper: replace a legacy / weaker stored value after a successful login.
+// Conditional on the old value so a concurrent password change is not undone.
+static void rehashStoredPassword(sql::Connection* con, const string& email,
+                                 const string& pass, const string& stored) {
+    string fresh = PasswordHasher::instance().hash(pass);
+    if (fresh.empty()) return;   // hasher busy: migrate on a later login
+
+    try {
+        sql::PreparedStatement* pstmt = con->prepareStatement(
+            "UPDATE `LOGIN` SET Password = ? WHERE Email = ? AND Password = ?"
+        );
+        pstmt->setString(1, fresh);
+        pstmt->setString(2, email);
+        pstmt->setString(3, stored);
+        pstmt->executeUpdate();
+        delete pstmt;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in rehashStoredPassword: " << e.what() << endl;
+    }
+}
+
 // -----------------------------------------------------------------
 // Low-level register for NEW USER (non-interactive)
 // -----------------------------------------------------------------
@@ -36,15 +61,22 @@ bool registerNewLogin(sql::Connection* con, const string& email, const string& p
         return false;
     }
 
+    string hashed = PasswordHasher::instance().hash(pass);
+    if (hashed.empty()) {
+        cerr << "Password hashing is busy, try again shortly.\n";
+        return false;
+    }
+
     try {
         sql::PreparedStatement* pstmt =
             con->prepareStatement("INSERT INTO `LOGIN` (Email, Password) VALUES (?, ?)");
 
         pstmt->setString(1, email);
-        pstmt->setString(2, pass);
+        pstmt->setString(2, hashed);
         pstmt->executeUpdate();
         delete pstmt;
 
+        noteWrite();
         return true;
     }
     catch (sql::SQLException &e) {
@@ -101,17 +133,20 @@ bool authenticateLogin(sql::Connection* con, const string& email, const string&
 
         sql::ResultSet* res = pstmt->executeQuery();
 
-        bool ok = false;
-
-        if (res->next()) {
-            string stored = res->getString("Password");
-            if (stored == pass) ok = true;  // plain-text compare
-        }
+        string stored;
+        bool found = res->next();
+        if (found) stored = res->getString("Password");
 
         delete res;
         delete pstmt;
 
-        return ok;
+        if (!found) return false;
+
+        VerifyResult v = PasswordHasher::instance().verify(pass, stored);
+        if (v == VERIFY_OK_NEEDS_REHASH)
+            rehashStoredPassword(con, email, pass, stored);
+
+        return v == VERIFY_OK || v == VERIFY_OK_NEEDS_REHASH;
     }
     catch (sql::SQLException &e) {
         cerr << "SQL Error in authenticateLogin: " << e.what() << endl;
@@ -151,3 +186,174 @@ bool loginWindow(sql::Connection* con, std::string& loggedInEmail) {
     loggedInEmail = email;
     return true;
 }
+
+// -----------------------------------------------------------------
+// One-query login: credentials + customer + default address + cart size
+// -----------------------------------------------------------------
+LoginResult loginAndResolve(sql::Connection* con, const string& email,
+                            const string& pass, CustomerSession& out) {
+    if (!con) return LOGIN_ERROR;
+
+    try {
+        sql::PreparedStatement* pstmt = con->prepareStatement(
+            "SELECT l.Password, c.ID, c.Name, c.Contact_Num, "
+            "       a.AddressID, a.AddressLine, a.City, a.State, a.PostalCode, "
+            "       (SELECT COALESCE(SUM(ct.Quantity), 0) FROM Cart ct "
+            "         WHERE ct.Customer_ID = c.ID) AS CartItems "
+            "FROM `LOGIN` l "
+            "LEFT JOIN CUSTOMER_DETAILS c ON c.Email = l.Email "
+            "LEFT JOIN ADDRESS a ON a.AddressID = ("
+            "       SELECT a2.AddressID FROM ADDRESS a2 WHERE a2.CustomerID = c.ID "
+            "       ORDER BY a2.IsDefault DESC, a2.AddressID ASC LIMIT 1) "
+            "WHERE l.Email = ?"
+        );
+        pstmt->setString(1, email);
+        sql::ResultSet* res = pstmt->executeQuery();
+
+        LoginResult result = LOGIN_BAD_CREDENTIALS;
+        string stored;
+        bool rehash = false;
+
+        if (res->next()) {
+            stored = res->getString("Password");
+            VerifyResult v = PasswordHasher::instance().verify(pass, stored);
+            rehash = (v == VERIFY_OK_NEEDS_REHASH);
+
+            if (v == VERIFY_BUSY) {
+                result = LOGIN_BUSY;
+            }
+            else if (v == VERIFY_MISMATCH) {
+                result = LOGIN_BAD_CREDENTIALS;
+            }
+            else if (res->isNull("ID")) {
+                result = LOGIN_NO_PROFILE;
+            }
+            else {
+                CustomerSession s;
+                s.customerId = res->getInt("ID");
+                s.email = email;
+                s.name = res->getString("Name");
+                s.contact = res->getString("Contact_Num");
+                if (!res->isNull("AddressID")) {
+                    s.defaultAddressId = res->getInt("AddressID");
+                    s.defaultAddress = string(res->getString("AddressLine")) + ", "
+                                     + string(res->getString("City")) + ", "
+                                     + string(res->getString("State")) + " "
+                                     + string(res->getString("PostalCode"));
+                }
+                s.cartItems = res->getInt("CartItems");
+                out = s;
+                result = LOGIN_OK;
+            }
+        }
+
+        delete res;
+        delete pstmt;
+
+        if (rehash && result != LOGIN_BAD_CREDENTIALS)
+            rehashStoredPassword(con, email, pass, stored);
+        return result;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in loginAndResolve: " << e.what() << endl;
+        return LOGIN_ERROR;
+    }
+}
+
+LoginResult loginWindow(sql::Connection* con, CustomerSession& session) {
+    if (!con) {
+        cout << "❌ No active DB connection.\n";
+        return LOGIN_ERROR;
+    }
+
+    string email;
+    string password;
+
+    cout << "=====================================\n";
+    cout << "            LOGIN WINDOW             \n";
+    cout << "=====================================\n\n";
+
+    cout << "Enter Email: ";
+    getline(cin, email);
+
+    if (email.empty()) getline(cin, email);  // fix leftover newline issue
+
+    cout << "Enter Password: ";
+    getline(cin, password);
+
+    LoginResult r = loginAndResolve(con, email, password, session);
+    if (r == LOGIN_BAD_CREDENTIALS)
+        cout << "\n❌ Incorrect email or password.\n";
+    else if (r == LOGIN_BUSY)
+        cout << "\n⚠ Too many logins right now, please try again in a moment.\n";
+    return r;
+}
+
+// -----------------------------------------------------------------
+// Registration: LOGIN + CUSTOMER_DETAILS as one transaction
+// -----------------------------------------------------------------
+bool registerCustomer(sql::Connection* con, const Customer& c,
+                      const string& pass, CustomerSession& out) {
+    if (!con) return false;
+
+    string hashed = PasswordHasher::instance().hash(pass);
+    if (hashed.empty()) {
+        cerr << "Password hashing is busy, try again shortly.\n";
+        return false;
+    }
+
+    bool autoCommit = true;
+    try {
+        autoCommit = con->getAutoCommit();
+        con->setAutoCommit(false);
+
+        sql::PreparedStatement* pstmt =
+            con->prepareStatement("INSERT INTO `LOGIN` (Email, Password) VALUES (?, ?)");
+        pstmt->setString(1, c.getEmail());
+        pstmt->setString(2, hashed);
+        pstmt->executeUpdate();
+        delete pstmt;
+
+        pstmt = con->prepareStatement(
+            "INSERT INTO CUSTOMER_DETAILS (Name, Contact_Num, Email, Address) VALUES (?, ?, ?, ?)"
+        );
+        pstmt->setString(1, c.getName());
+        pstmt->setString(2, c.getContactnumber());
+        pstmt->setString(3, c.getEmail());
+        pstmt->setString(4, c.getAddress());
+        pstmt->executeUpdate();
+        delete pstmt;
+
+        sql::Statement* stmt = con->createStatement();
+        sql::ResultSet* res = stmt->executeQuery("SELECT LAST_INSERT_ID()");
+        int id = res->next() ? res->getInt(1) : -1;
+        delete res;
+        delete stmt;
+
+        if (id <= 0) {
+            con->rollback();
+            con->setAutoCommit(autoCommit);
+            return false;
+        }
+
+        con->commit();
+        con->setAutoCommit(autoCommit);
+        noteWrite(id);
+
+        CustomerSession s;
+        s.customerId = id;
+        s.email = c.getEmail();
+        s.name = c.getName();
+        s.contact = c.getContactnumber();
+        out = s;
+        return true;
+    }
+    catch (sql::SQLException &e) {
+        cerr << "SQL Error in registerCustomer: " << e.what() << endl;
+        try {
+            con->rollback();
+            con->setAutoCommit(autoCommit);
+        } catch (sql::SQLException &) {}
+        return false;
+    }
+}
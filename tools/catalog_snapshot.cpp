@@ -0,0 +1,61 @@
+// catalog_snapshot.cpp
+// Writes (or inspects) the binary catalog snapshot; suitable for cron.
+//
+//   catalog_snapshot [path]            rebuild from the DB
+//   catalog_snapshot --check [path]    verify checksum and freshness
+
+#include "CatalogSnapshot.h"
+#include "DBFunctions.h"
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <ctime>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    bool check = argc > 1 && string(argv[1]) == "--check";
+    int pathArg = check ? 2 : 1;
+    string path = argc > pathArg ? argv[pathArg] : defaultSnapshotPath();
+
+    sql::Connection* con = nullptr;
+    try {
+        con = createConnection();
+    } catch (sql::SQLException &e) {
+        return 1;
+    }
+
+    int rc = 0;
+    if (check) {
+        auto t0 = chrono::steady_clock::now();
+        CatalogSnapshot snap;
+        bool ok = snap.open(path);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+        if (!ok) {
+            cout << "❌ " << path << " missing or corrupt.\n";
+            rc = 1;
+        } else {
+            cout << "Products  : " << snap.productCount() << "\n";
+            cout << "Age       : " << (long)time(nullptr) - (long)snap.createdAt() << " s\n";
+            cout << "Open time : " << ms << " ms\n";
+            bool stale = snap.isStale(con, 24 * 60 * 60);
+            cout << (stale ? "⚠ Stale (DB changed or too old)\n" : "✔ Up to date\n");
+            rc = stale ? 2 : 0;
+        }
+    } else {
+        auto t0 = chrono::steady_clock::now();
+        if (writeCatalogSnapshot(con, path)) {
+            double s = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+            cout << "✔ Wrote " << path << " in " << s << " s\n";
+        } else {
+            cout << "❌ Failed to write " << path << "\n";
+            rc = 1;
+        }
+    }
+
+    con->close();
+    delete con;
+    return rc;
+}
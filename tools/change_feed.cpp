@@ -0,0 +1,346 @@
+// change_feed.cpp
+// Sets up and inspects the CHANGE_LOG change feed the app's caches follow.
+//
+//   change_feed --install          create CHANGE_LOG and its triggers
+//   change_feed --uninstall        drop the triggers
+//   change_feed --prune HOURS      delete entries older than HOURS (cron)
+//   change_feed --tail [SECONDS]   print changes as they arrive (default 60 s)
+//   change_feed --self-test SCHEMA run the triggers and the consumer against
+//                                  a scratch schema (created, then dropped)
+//
+// --tail reads the way the app's consumer does (replica if configured), so
+// running it next to a mysql client shows what each statement will
+// invalidate.
+//
+// --self-test copies the PRODUCT and Supplier definitions of
+// PROJECT1_DB_SCHEMA into SCHEMA, which must not exist yet, installs the
+// triggers there and checks what a stock-only UPDATE, a price UPDATE, a name
+// UPDATE, an INSERT, a DELETE, a Supplier UPDATE and two out-of-order
+// commits log and invalidate. It reads the primary only and needs the
+// CREATE, DROP and TRIGGER privileges.
+
+#include "ChangeFeed.h"
+#include "CatalogCache.h"
+#include "QueryCache.h"
+#include "DBFunctions.h"
+#include "DBRouter.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+
+#include <cppconn/statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+static void usage() {
+    cout << "Usage: change_feed --install | --uninstall | --prune HOURS | --tail [SECONDS]"
+            " | --self-test SCHEMA\n";
+}
+
+static const char* describe(const ChangeEvent &e) {
+    if (e.table == "PRODUCT") {
+        switch (e.op) {
+            case 'Q': return "stock/price -> patch catalog row, drop stock/price results";
+            case 'I': return "insert -> clear results, re-warm catalog";
+            case 'D': return "delete -> clear results, re-warm catalog";
+            default:  return "update -> clear results, re-warm catalog";
+        }
+    }
+    if (e.table == "Supplier") return "supplier -> drop prefetched details, re-warm catalog";
+    return "";
+}
+
+static int tail(int seconds) {
+    sql::Connection* con = nullptr;
+    try {
+        con = createReadConnection();
+    } catch (sql::SQLException &e) {
+        cout << "Failed to connect to DB: " << e.what() << endl;
+        return 1;
+    }
+
+    int64_t last = changeLogPosition(con);
+    if (last < 0) {
+        cout << "❌ CHANGE_LOG not readable. Run change_feed --install first.\n";
+        delete con;
+        return 1;
+    }
+    cout << "Following CHANGE_LOG after Seq " << last << " for " << seconds << " s ...\n";
+
+    auto end = chrono::steady_clock::now() + chrono::seconds(seconds);
+    vector<ChangeEvent> events;
+    while (chrono::steady_clock::now() < end) {
+        try {
+            readChanges(con, last, {}, 1000, events);
+        } catch (sql::SQLException &e) {
+            cout << "❌ Reading CHANGE_LOG failed: " << e.what() << endl;
+            break;
+        }
+        for (const ChangeEvent &e : events) {
+            cout << e.seq << "  " << e.table << "  " << e.op << "  " << e.rowKey
+                 << "  " << describe(e) << "\n";
+            last = e.seq;
+        }
+        if (events.empty()) this_thread::sleep_for(chrono::milliseconds(500));
+    }
+
+    con->close();
+    delete con;
+    return 0;
+}
+
+// ---------------------------------------------
+// --self-test
+// ---------------------------------------------
+const int SELF_TEST_WAIT_SECONDS = 15;      // longer than a re-warm of 3 rows needs
+
+static void exec(sql::Connection* con, const string &sql) {
+    sql::Statement* stmt = con->createStatement();
+    try {
+        stmt->execute(sql);
+    } catch (...) {
+        delete stmt;
+        throw;
+    }
+    delete stmt;
+}
+
+// Polls `cond` until it holds or SELF_TEST_WAIT_SECONDS pass
+static bool waitFor(const function<bool()> &cond) {
+    auto end = chrono::steady_clock::now() + chrono::seconds(SELF_TEST_WAIT_SECONDS);
+    while (!cond()) {
+        if (chrono::steady_clock::now() >= end) return false;
+        this_thread::sleep_for(chrono::milliseconds(50));
+    }
+    return true;
+}
+
+// Copy of product `id` in the published catalog; false if it is not there
+static bool cachedProduct(int id, Product &out) {
+    shared_ptr<const CatalogData> cache = catalogCache();
+    const Product* p = cache ? cache->findProduct(id) : nullptr;
+    if (p) out = *p;
+    return p != nullptr;
+}
+
+static int cachedStock(int id) {
+    shared_ptr<const CatalogData> cache = catalogCache();
+    const Product* p = cache ? cache->findProduct(id) : nullptr;
+    return p ? cache->stockOf(*p) : -1;
+}
+
+static bool resultCached(const ResultKey &key) {
+    return productResultCache().find(key) != nullptr;
+}
+
+static void primeResult(const ResultKey &key) {
+    uint64_t readAt;
+    productResultCache().find(key, &readAt);
+    cacheProductResult(key, {1, 2, 3}, readAt);
+}
+
+static int failures = 0;
+
+static void check(bool ok, const string &what) {
+    cout << (ok ? "✔ " : "❌ ") << what << "\n";
+    if (!ok) ++failures;
+}
+
+static void runSelfTest(sql::Connection* con, sql::Connection* con2) {
+    const ResultKey byStock(RQ_SORT_STOCK, "C", "S");
+    const ResultKey byPrice(RQ_SORT_PRICE_ASC, "C", "S");
+    const ResultKey byName(RQ_SORT_NAME, "C", "S");
+    bool cacheOn = productResultCache().enabled();
+
+    exec(con, "INSERT INTO Supplier (SID, Sname, Contact_Num, Email, Address) "
+              "VALUES (1, 'Supplier', '9000000000', 's@example.com', 'Street')");
+    for (int id = 1; id <= 3; ++id)
+        exec(con, "INSERT INTO PRODUCT (Product_ID, Product_Name, Category, Subcategory, Price, "
+                  "Stock_Qtn, Company_name, ExpiryDate, SID) VALUES (" + to_string(id) +
+                  ", 'P" + to_string(id) + "', 'C', 'S', 10.00, 100, 'Co', '2030-01-01', 1)");
+
+    // what an older install left behind
+    exec(con, "CREATE TRIGGER trg_cl_cart_ins AFTER INSERT ON Cart FOR EACH ROW SET @cl_cart = 1");
+
+    check(installChangeFeed(con), "install");
+    check(installChangeFeed(con), "install again (replaces the triggers)");
+    {
+        set<string> names;
+        sql::Statement* stmt = con->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT TRIGGER_NAME FROM information_schema.TRIGGERS WHERE TRIGGER_SCHEMA = DATABASE()");
+        while (res->next()) names.insert(res->getString(1));
+        delete res;
+        delete stmt;
+        set<string> want = {"trg_cl_product_ins", "trg_cl_product_upd", "trg_cl_product_del",
+                            "trg_cl_supplier_ins", "trg_cl_supplier_upd", "trg_cl_supplier_del"};
+        check(names == want, "triggers are the six PRODUCT/Supplier ones, Cart trigger dropped");
+    }
+
+    WarmupStats warm = warmCatalogCache(2);
+    check(warm.ok && warm.products == 3, "catalog warmed from the scratch schema");
+    if (!warm.ok) return;
+
+    int64_t start = changeLogPosition(con);
+    check(start >= 0, "CHANGE_LOG readable");
+    startChangeFeed(start, 100, 2);
+    if (cacheOn) {
+        primeResult(byStock);
+        primeResult(byPrice);
+        primeResult(byName);
+    }
+
+    exec(con, "UPDATE PRODUCT SET Stock_Qtn = 7 WHERE Product_ID = 1");
+    check(waitFor([] { return cachedStock(1) == 7; }), "stock-only UPDATE patches the cached stock");
+    if (cacheOn)
+        check(!resultCached(byStock) && resultCached(byName),
+              "stock-only UPDATE drops the stock-ordered results only");
+
+    exec(con, "UPDATE PRODUCT SET Price = 12.50 WHERE Product_ID = 2");
+    check(waitFor([] {
+        Product p;
+        return cachedProduct(2, p) && p.getPrice() == Money::fromSQL("12.50");
+    }), "price UPDATE patches the cached price");
+    if (cacheOn)
+        check(!resultCached(byPrice) && resultCached(byName),
+              "price UPDATE drops the price-ordered results only");
+
+    exec(con, "UPDATE PRODUCT SET Product_Name = 'Renamed' WHERE Product_ID = 3");
+    check(waitFor([] {
+        Product p;
+        return cachedProduct(3, p) && p.getName() == "Renamed";
+    }), "name UPDATE re-warms the catalog");
+    if (cacheOn) check(!resultCached(byName), "name UPDATE clears the results");
+
+    exec(con, "INSERT INTO PRODUCT (Product_ID, Product_Name, Category, Subcategory, Price, "
+              "Stock_Qtn, Company_name, ExpiryDate, SID) "
+              "VALUES (4, 'P4', 'C', 'S', 1.00, 1, 'Co', '2030-01-01', 1)");
+    Product p4;
+    check(waitFor([&] { return cachedProduct(4, p4); }), "INSERT reaches the catalog");
+
+    exec(con, "DELETE FROM PRODUCT WHERE Product_ID = 4");
+    check(waitFor([&] { return !cachedProduct(4, p4); }), "DELETE reaches the catalog");
+
+    exec(con, "UPDATE Supplier SET Sname = 'Renamed' WHERE SID = 1");
+    check(waitFor([] {
+        shared_ptr<const CatalogData> cache = catalogCache();
+        const Supplier* s = cache ? cache->supplierFor(1) : nullptr;
+        return s && s->name == "Renamed";
+    }), "Supplier UPDATE re-warms the catalog");
+
+    vector<ChangeEvent> events;
+    readChanges(con, start, {}, 100, events);
+    string got;
+    for (const ChangeEvent &e : events)
+        got += e.table + " " + e.op + " " + to_string(e.rowKey) + "; ";
+    string want = "PRODUCT Q 1; PRODUCT Q 2; PRODUCT U 3; PRODUCT I 4; PRODUCT D 4; Supplier U 1; ";
+    check(got == want, "CHANGE_LOG holds the six events in order" +
+                       (got == want ? string() : " (got " + got + ")"));
+
+    // The lower Seq commits last: the consumer must come back for it
+    con2->setAutoCommit(false);
+    exec(con2, "UPDATE PRODUCT SET Stock_Qtn = 5 WHERE Product_ID = 2");
+    exec(con, "UPDATE PRODUCT SET Stock_Qtn = 6 WHERE Product_ID = 1");
+    check(waitFor([] { return cachedStock(1) == 6; }), "the later Seq is applied while the earlier is open");
+    con2->commit();
+    con2->setAutoCommit(true);
+    check(waitFor([] { return cachedStock(2) == 5; }), "the earlier Seq is applied once it commits");
+}
+
+static int selfTest(const string &schema) {
+    if (schema.empty() || schema.find('`') != string::npos) { usage(); return 1; }
+    const string q = "`" + schema + "`";
+
+    sql::Connection* con = nullptr;
+    try {
+        con = createConnection();
+        exec(con, "CREATE DATABASE " + q);
+    } catch (sql::SQLException &e) {
+        cout << "❌ Cannot create scratch schema " << schema << " (it must not exist yet): "
+             << e.what() << endl;
+        delete con;
+        return 1;
+    }
+
+    // everything below, the consumer and re-warms included, uses the scratch schema
+    // and the primary
+    setenv("PROJECT1_DB_SCHEMA", schema.c_str(), 1);
+    unsetenv("PROJECT1_DB_REPLICA");
+
+    sql::Connection* con2 = nullptr;
+    try {
+        for (const char* table : {"PRODUCT", "Supplier", "Cart"})
+            exec(con, string("CREATE TABLE ") + q + "." + table + " LIKE " + table);
+        con->setSchema(schema);
+        con2 = createConnection();
+        runSelfTest(con, con2);
+    } catch (sql::SQLException &e) {
+        cout << "❌ SQL error: " << e.what() << endl;
+        ++failures;
+    }
+    stopChangeFeed();
+
+    try {
+        if (con2) con2->rollback();
+        exec(con, "DROP DATABASE " + q);
+    } catch (sql::SQLException &e) {
+        cout << "⚠ Could not drop " << schema << ": " << e.what() << endl;
+    }
+    if (con2) { con2->close(); delete con2; }
+    con->close();
+    delete con;
+
+    if (failures) {
+        cout << "❌ " << failures << " check(s) failed.\n";
+        return 1;
+    }
+    cout << "✔ All checks passed.\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { usage(); return 1; }
+    string cmd = argv[1];
+
+    if (cmd == "--tail") return tail(argc > 2 ? atoi(argv[2]) : 60);
+    if (cmd == "--self-test" && argc > 2) return selfTest(argv[2]);
+
+    // setup and pruning write, so they go to the primary
+    sql::Connection* con = nullptr;
+    try {
+        con = createConnection();
+    } catch (sql::SQLException &e) {
+        cout << "Failed to connect to DB: " << e.what() << endl;
+        return 1;
+    }
+
+    int rc = 0;
+    if (cmd == "--install") {
+        bool ok = installChangeFeed(con);
+        cout << (ok ? "✔ CHANGE_LOG and triggers installed.\n" : "❌ Install failed.\n");
+        rc = ok ? 0 : 1;
+    } else if (cmd == "--uninstall") {
+        bool ok = uninstallChangeFeed(con);
+        cout << (ok ? "✔ Triggers dropped (CHANGE_LOG kept).\n" : "❌ Uninstall failed.\n");
+        rc = ok ? 0 : 1;
+    } else if (cmd == "--prune" && argc > 2) {
+        long rows = pruneChangeLog(con, atoi(argv[2]));
+        if (rows >= 0) cout << "✔ Deleted " << rows << " entries.\n";
+        rc = rows >= 0 ? 0 : 1;
+    } else {
+        usage();
+        rc = 1;
+    }
+
+    con->close();
+    delete con;
+    return rc;
+}
@@ -0,0 +1,95 @@
+// datagen.cpp
+// Command-line front end for the synthetic dataset generator.
+//
+//   datagen [--products N] [--suppliers N] [--brands N] [--customers N]
+//           [--orders N] [--order-items N] [--cart N] [--wishlist N]
+//           [--seed N] [--zipf S] [--as-of YYYY-MM-DD] [--password P]
+//           [--writers N] [--batch N] [--dry-run]
+//
+// Counts accept k / m suffixes (e.g. --products 10m --order-items 50m).
+
+#include "DataGenerator.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+
+using namespace std;
+
+static void usage() {
+    cout << "Usage: datagen [--products N] [--suppliers N] [--brands N] [--customers N]\n"
+            "               [--orders N] [--order-items N] [--cart N] [--wishlist N]\n"
+            "               [--seed N] [--zipf S] [--as-of YYYY-MM-DD] [--password P]\n"
+            "               [--writers N] [--batch N] [--dry-run]\n";
+}
+
+// "250000", "250k", "10m"
+static bool parseCount(const string &s, size_t &out) {
+    char* end = nullptr;
+    double v = strtod(s.c_str(), &end);
+    if (end == s.c_str() || v < 0) return false;
+    string unit = end;
+    if (unit == "k" || unit == "K") v *= 1e3;
+    else if (unit == "m" || unit == "M") v *= 1e6;
+    else if (!unit.empty()) return false;
+    out = (size_t)(v + 0.5);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    GenOptions opt;
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = true;
+
+        if (a == "--products" && hasValue) ok = parseCount(argv[++i], opt.products);
+        else if (a == "--suppliers" && hasValue) ok = parseCount(argv[++i], opt.suppliers);
+        else if (a == "--brands" && hasValue) ok = parseCount(argv[++i], opt.brands);
+        else if (a == "--customers" && hasValue) ok = parseCount(argv[++i], opt.customers);
+        else if (a == "--orders" && hasValue) ok = parseCount(argv[++i], opt.orders);
+        else if (a == "--order-items" && hasValue) ok = parseCount(argv[++i], opt.orderItems);
+        else if (a == "--cart" && hasValue) ok = parseCount(argv[++i], opt.cartRows);
+        else if (a == "--wishlist" && hasValue) ok = parseCount(argv[++i], opt.wishlistRows);
+        else if (a == "--seed" && hasValue) opt.seed = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--zipf" && hasValue) opt.zipfExponent = atof(argv[++i]);
+        else if (a == "--as-of" && hasValue) opt.asOf = argv[++i];
+        else if (a == "--password" && hasValue) opt.password = argv[++i];
+        else if (a == "--writers" && hasValue) opt.writerConnections = atoi(argv[++i]);
+        else if (a == "--batch" && hasValue) ok = parseCount(argv[++i], opt.batchRows);
+        else if (a == "--dry-run") opt.dryRun = true;
+        else ok = false;
+
+        if (!ok) {
+            usage();
+            return 1;
+        }
+    }
+    if (opt.orders == 0) opt.orderItems = 0;
+
+    GenStats stats;
+    bool ok = generateDataset(opt, stats);
+
+    cout << "\n============== DATASET SUMMARY ==============\n";
+    cout << left << setw(18) << "Table" << right << setw(12) << "Rows"
+         << setw(12) << "Rows/s" << "  Checksum\n";
+    cout << string(62, '-') << "\n";
+    for (auto &t : stats.tables) {
+        cout << left << setw(18) << t.table << right << setw(12) << t.rows
+             << setw(12) << fixed << setprecision(0) << t.rowsPerSecond()
+             << "  " << hex << setw(16) << setfill('0') << t.checksum
+             << dec << setfill(' ') << "\n";
+    }
+    cout << string(62, '-') << "\n";
+    cout << "Total time: " << setprecision(1) << stats.totalSeconds << " s"
+         << (opt.dryRun ? " (dry run, nothing written)" : "") << "\n";
+
+    if (!ok) {
+        cout << "\n❌ Generation did not complete.\n";
+        return 1;
+    }
+    cout << "\n✅ Dataset generated (seed " << opt.seed << ").\n";
+    return 0;
+}
@@ -0,0 +1,206 @@
+// footprint_bench.cpp
+// Per-object memory of Product and Address with interned string fields,
+// against the previous layout (one std::string per field). Runs offline on
+// synthetic rows shaped like the datagen catalog; no database needed.
+//
+//   footprint_bench [--products N] [--addresses N] [--brands N]
+//
+// Memory is measured by counting every allocation made while the rows are
+// built, so "after" includes the pooled strings themselves.
+
+#include "Product.h"
+#include "Address.h"
+#include "StringPool.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+// -----------------------------
+// Allocation counting
+// -----------------------------
+static atomic<long long> liveBytes(0);
+
+void* operator new(size_t n) {
+    size_t* p = (size_t*)malloc(n + sizeof(max_align_t));
+    if (!p) throw bad_alloc();
+    *p = n;
+    liveBytes += (long long)n;
+    return (char*)p + sizeof(max_align_t);
+}
+
+void operator delete(void* q) noexcept {
+    if (!q) return;
+    size_t* p = (size_t*)((char*)q - sizeof(max_align_t));
+    liveBytes -= (long long)*p;
+    free(p);
+}
+
+void operator delete(void* q, size_t) noexcept { operator delete(q); }
+
+// -----------------------------
+// Previous layouts
+// -----------------------------
+struct LegacyProduct {
+    int Product_id;
+    string Product_name;
+    string Category;
+    string Subcategory;
+    float Price;
+    int Stock_Qtn;
+    string Company_name;
+    Date ExpiryDate;
+};
+
+struct LegacyAddress {
+    int id;
+    string line, city, state, postalCode, country;
+    int isDefaultFlag;
+};
+
+// -----------------------------
+// Synthetic rows
+// -----------------------------
+struct Group { const char* category; const char* subcategory; };
+const Group GROUPS[] = {
+    {"Dairy", "Milk"}, {"Dairy", "Cheese"}, {"Bakery", "Bread"}, {"Bakery", "Cookies"},
+    {"Beverages", "Soft Drinks"}, {"Beverages", "Coffee"}, {"Snacks", "Chocolates"},
+    {"Staples", "Rice"}, {"Personal Care", "Toothpaste"}, {"Household", "Detergent"},
+    {"Baby Care", "Baby Food"}, {"Fruits & Vegetables", "Leafy Vegetables"},
+};
+const size_t GROUP_COUNT = sizeof(GROUPS) / sizeof(GROUPS[0]);
+
+struct City { const char* city; const char* state; };
+const City CITIES[] = {
+    {"Delhi", "Delhi"}, {"Mumbai", "Maharashtra"}, {"Bengaluru", "Karnataka"},
+    {"Chennai", "Tamil Nadu"}, {"Hyderabad", "Telangana"}, {"Kolkata", "West Bengal"},
+    {"Lucknow", "Uttar Pradesh"}, {"Indore", "Madhya Pradesh"},
+};
+const size_t CITY_COUNT = sizeof(CITIES) / sizeof(CITIES[0]);
+
+struct Rng {
+    uint64_t s = 88172645463325252ULL;
+    uint64_t next() { s ^= s << 13; s ^= s >> 7; s ^= s << 17; return s; }
+    size_t below(size_t n) { return (size_t)(next() % n); }
+};
+
+string brandName(size_t b) {
+    static const char* SYL[] = { "ka", "ve", "lo", "ra", "mi", "su", "ta", "no", "ri", "da" };
+    string s = "Brand ";
+    for (int i = 0; i < 3; ++i, b /= 10) s += SYL[b % 10];
+    return s + " Foods";
+}
+
+struct Measure {
+    long long heap = 0;
+    double ms = 0.0;
+};
+
+template <typename Fn>
+Measure measure(Fn fn) {
+    long long before = liveBytes.load();
+    auto t0 = chrono::steady_clock::now();
+    fn();
+    Measure m;
+    m.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    m.heap = liveBytes.load() - before;
+    return m;
+}
+
+void report(const string &what, size_t count, size_t oldSize, const Measure &before,
+            size_t newSize, const Measure &after) {
+    // the vectors are reserved up front, so heap / count covers sizeof too
+    double b = (double)before.heap / count;
+    double a = (double)after.heap / count;
+    cout << "\n" << what << " (" << count << " rows)\n";
+    cout << left << setw(24) << "" << right << setw(12) << "before" << setw(12) << "after" << "\n";
+    cout << left << setw(24) << "sizeof" << right << setw(12) << oldSize << setw(12) << newSize << "\n";
+    cout << fixed << setprecision(1);
+    cout << left << setw(24) << "bytes per row" << right << setw(12) << b << setw(12) << a << "\n";
+    cout << left << setw(24) << "build time (ms)" << right << setw(12) << before.ms << setw(12) << after.ms << "\n";
+    cout << left << setw(24) << "saved" << right << setw(11) << 100.0 * (1.0 - a / b) << "%\n";
+}
+
+int main(int argc, char** argv) {
+    size_t products = 1000000, addresses = 200000, brands = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--products" && hasValue) products = strtoul(argv[++i], nullptr, 10);
+        else if (a == "--addresses" && hasValue) addresses = strtoul(argv[++i], nullptr, 10);
+        else if (a == "--brands" && hasValue) brands = strtoul(argv[++i], nullptr, 10);
+        else {
+            cout << "Usage: footprint_bench [--products N] [--addresses N] [--brands N]\n";
+            return 1;
+        }
+    }
+    if (products == 0 || addresses == 0) return 1;
+    if (brands == 0) brands = max<size_t>(20, products / 100);
+
+    // source strings are generated once and shared by both layouts, so only
+    // the copies held by the rows are counted
+    vector<string> brandNames;
+    for (size_t b = 0; b < brands; ++b) brandNames.push_back(brandName(b));
+
+    // ----- Product -----
+    Rng rng;
+    vector<LegacyProduct> oldProducts;
+    Measure pBefore = measure([&] {
+        oldProducts.reserve(products);
+        for (size_t i = 0; i < products; ++i) {
+            const Group &g = GROUPS[rng.below(GROUP_COUNT)];
+            oldProducts.push_back({ (int)i + 1, "", g.category, g.subcategory, 99.0f, 10,
+                                    brandNames[rng.below(brands)], Date(1, 1, 2026) });
+        }
+    });
+
+    rng = Rng();
+    vector<Product> newProducts;
+    Measure pAfter = measure([&] {
+        newProducts.reserve(products);
+        for (size_t i = 0; i < products; ++i) {
+            const Group &g = GROUPS[rng.below(GROUP_COUNT)];
+            newProducts.push_back(Product((int)i + 1, "", g.category, g.subcategory, Money::fromPaise(9900), 10,
+                                          brandNames[rng.below(brands)], Date(1, 1, 2026)));
+        }
+    });
+
+    report("Product (name left empty)", products, sizeof(LegacyProduct), pBefore,
+           sizeof(Product), pAfter);
+
+    // ----- Address -----
+    rng = Rng();
+    vector<LegacyAddress> oldAddresses;
+    Measure aBefore = measure([&] {
+        oldAddresses.reserve(addresses);
+        for (size_t i = 0; i < addresses; ++i) {
+            const City &c = CITIES[rng.below(CITY_COUNT)];
+            oldAddresses.push_back({ (int)i + 1, "", c.city, c.state, "560001", "India", 0 });
+        }
+    });
+
+    rng = Rng();
+    vector<Address> newAddresses;
+    Measure aAfter = measure([&] {
+        newAddresses.reserve(addresses);
+        for (size_t i = 0; i < addresses; ++i) {
+            const City &c = CITIES[rng.below(CITY_COUNT)];
+            newAddresses.push_back(Address((int)i + 1, "", c.city, c.state, "560001", "India", 0));
+        }
+    });
+
+    report("Address (line left empty)", addresses, sizeof(LegacyAddress), aBefore,
+           sizeof(Address), aAfter);
+
+    cout << "\nString pool: " << StringPool::global().size() << " distinct values, "
+         << StringPool::global().memoryBytes() / 1024 << " KiB\n";
+    return 0;
+}
@@ -0,0 +1,427 @@
+// loadgen.cpp
+// Synthetic shopper load generator. Each simulated shopper owns a DB
+// connection and a customer account and loops over a weighted mix of the
+// same functions the menus call, minus the prompts. Reports throughput,
+// error counts and latency percentiles per operation.
+//
+//   loadgen [--shoppers N] [--seconds N] [--mix browse=40,search=30,...]
+//           [--think-ms N] [--seed N] [--warm]
+//
+// An operation fails when it returns false / nothing, or logs an SQL error.
+//
+// Operations: browse   loadCategories + loadSubcategories
+//             search   searchProductsByName (words taken from product names)
+//             cart     addToCart, qty 1
+//             checkout createOrderFromCart to the customer's first address
+//             orders   loadOrdersForCustomer
+//
+// cart and checkout write to Cart / Orders / PRODUCT: point it at a scratch
+// database, never at production.
+
+#include "DBFunctions.h"
+#include "CartFunctions.h"
+#include "CatalogCache.h"
+#include "RequestArena.h"
+#include "QueryCache.h"
+#include "ShardRouter.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+
+#include <cppconn/statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+namespace {
+
+enum Op { OP_BROWSE, OP_SEARCH, OP_CART, OP_CHECKOUT, OP_ORDERS, OP_COUNT };
+const char* OP_NAMES[OP_COUNT] = { "browse", "search", "cart", "checkout", "orders" };
+
+struct Options {
+    int shoppers = 8;
+    int seconds = 30;
+    int thinkMs = 0;
+    unsigned seed = 42;
+    bool warm = false;
+    int mix[OP_COUNT] = { 40, 30, 20, 5, 5 };
+};
+
+struct Shopper {
+    int customerId;
+    int addressId;
+};
+
+// Per-shopper results, merged after the run (no sharing while timing)
+struct OpSamples {
+    vector<double> micros[OP_COUNT];
+    long errors[OP_COUNT] = {};
+};
+
+// The library functions print receipts and confirmations to cout and SQL
+// errors to cerr. cout is discarded; cerr lines are counted (also per thread,
+// so an operation that logged an error counts as failed even when its return
+// value cannot say so) and the first few are kept for the report.
+thread_local long threadErrorLines = 0;
+
+class NullBuf : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+class ErrorBuf : public streambuf {
+    mutex mtx;
+    string line;
+public:
+    long lines = 0;
+    vector<string> first;
+
+protected:
+    int overflow(int c) override {
+        lock_guard<mutex> lock(mtx);
+        put((char)c);
+        return c;
+    }
+    streamsize xsputn(const char* s, streamsize n) override {
+        lock_guard<mutex> lock(mtx);
+        for (streamsize i = 0; i < n; ++i) put(s[i]);
+        return n;
+    }
+
+private:
+    void put(char c) {
+        if (c != '\n') { line += c; return; }
+        ++lines;
+        ++threadErrorLines;
+        if (first.size() < 5) first.push_back(line);
+        line.clear();
+    }
+};
+
+bool parseMix(const string &spec, int mix[OP_COUNT]) {
+    int parsed[OP_COUNT] = {};
+    stringstream ss(spec);
+    string item;
+    while (getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == string::npos) return false;
+        string name = item.substr(0, eq);
+        int w = atoi(item.substr(eq + 1).c_str());
+        int op = -1;
+        for (int i = 0; i < OP_COUNT; ++i)
+            if (name == OP_NAMES[i]) op = i;
+        if (op < 0 || w < 0) return false;
+        parsed[op] = w;
+    }
+    int total = 0;
+    for (int i = 0; i < OP_COUNT; ++i) total += parsed[i];
+    if (total == 0) return false;
+    copy(parsed, parsed + OP_COUNT, mix);
+    return true;
+}
+
+// Customers that can check out (have at least one address), and search
+// terms taken from the first word of in-stock product names
+bool loadFixtures(sql::Connection* con, size_t want, vector<Shopper> &shoppers,
+                  vector<int> &productIds, vector<string> &terms) {
+    try {
+        sql::Statement* stmt = con->createStatement();
+        sql::ResultSet* res = nullptr;
+        if (!shardingEnabled()) {
+            res = stmt->executeQuery(
+                "SELECT c.ID, MIN(a.AddressID) FROM CUSTOMER_DETAILS c "
+                "JOIN ADDRESS a ON a.CustomerID = c.ID "
+                "GROUP BY c.ID ORDER BY c.ID LIMIT " + to_string(want)
+            );
+            while (res->next()) shoppers.push_back({ res->getInt(1), res->getInt(2) });
+            delete res;
+        } else {
+            // addresses live on the shards; take customers from every shard
+            // that owns them, so the load spreads the way real traffic would
+            size_t perShard = (want + shardCount() - 1) / shardCount();
+            for (int k = 0; k < shardCount(); ++k) {
+                sql::Connection* sc = openShardConnection(k);
+                sql::Statement* ss = sc->createStatement();
+                res = ss->executeQuery(
+                    "SELECT CustomerID, MIN(AddressID) FROM ADDRESS "
+                    "GROUP BY CustomerID ORDER BY CustomerID"
+                );
+                size_t taken = 0;
+                while (taken < perShard && res->next()) {
+                    int id = res->getInt(1);
+                    if (shardOf(id) != k) continue;     // left over from a move
+                    shoppers.push_back({ id, res->getInt(2) });
+                    ++taken;
+                }
+                delete res;
+                delete ss;
+                sc->close();
+                delete sc;
+            }
+        }
+
+        res = stmt->executeQuery(
+            "SELECT Product_ID, Product_Name FROM PRODUCT WHERE Stock_Qtn > 0"
+        );
+        while (res->next()) {
+            productIds.push_back(res->getInt(1));
+            string name = res->getString(2);
+            string word = name.substr(0, name.find(' '));
+            if (word.size() >= 3) terms.push_back(word);
+        }
+        delete res;
+        delete stmt;
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error loading load-test fixtures: " << e.what() << endl;
+        return false;
+    }
+
+    sort(terms.begin(), terms.end());
+    terms.erase(unique(terms.begin(), terms.end()), terms.end());
+    return !shoppers.empty() && !productIds.empty();
+}
+
+void runShopper(const Options &opt, Shopper who, const vector<int> &productIds,
+                const vector<string> &terms, unsigned seed,
+                chrono::steady_clock::time_point deadline, OpSamples &out) {
+    sql::Connection* con = nullptr;
+    try {
+        con = createConnection();
+    } catch (sql::SQLException &) {
+        out.errors[OP_BROWSE]++;
+        return;
+    }
+
+    mt19937 rng(seed);
+    discrete_distribution<int> pickOp(opt.mix, opt.mix + OP_COUNT);
+    uniform_int_distribution<size_t> pickProduct(0, productIds.size() - 1);
+    uniform_int_distribution<size_t> pickTerm(0, terms.empty() ? 0 : terms.size() - 1);
+
+    // the shopper's cart is assumed empty at start; checkout needs an item
+    int cartLines = 0;
+    RequestArena arena;     // per-shopper, emptied after every operation
+
+    while (chrono::steady_clock::now() < deadline) {
+        int op = pickOp(rng);
+        if (op == OP_CHECKOUT && cartLines == 0) op = OP_CART;
+        if (op == OP_SEARCH && terms.empty()) op = OP_BROWSE;
+
+        bool ok = true;
+        long errorsBefore = threadErrorLines;
+        auto t0 = chrono::steady_clock::now();
+
+        switch (op) {
+        case OP_BROWSE: {
+            vector<string> cats = loadCategories(con);
+            ok = !cats.empty();
+            if (ok) loadSubcategories(con, cats[rng() % cats.size()]);
+            break;
+        }
+        case OP_SEARCH:
+            searchProductsByName(con, terms[pickTerm(rng)], arena.resource());
+            break;
+        case OP_CART:
+            ok = addToCart(con, who.customerId, productIds[pickProduct(rng)], 1);
+            if (ok) ++cartLines;
+            break;
+        case OP_CHECKOUT: {
+            int orderId = -1;
+            ok = createOrderFromCart(con, who.customerId, who.addressId, orderId);
+            if (ok) cartLines = 0;
+            break;
+        }
+        case OP_ORDERS:
+            loadOrdersForCustomer(con, who.customerId, arena.resource());
+            break;
+        }
+        arena.release();
+
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count();
+        out.micros[op].push_back(us);
+        if (!ok || threadErrorLines != errorsBefore) out.errors[op]++;
+
+        if (opt.thinkMs > 0)
+            this_thread::sleep_for(chrono::milliseconds(opt.thinkMs));
+    }
+
+    con->close();
+    delete con;
+}
+
+double percentile(const vector<double> &sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[min(idx, sorted.size() - 1)];
+}
+
+void appendMetrics(const Options &opt, const OpSamples &all, double seconds) {
+    const char* env = getenv("PROJECT1_METRICS_LOG");
+    string path = (env && *env) ? env : "project1_metrics.log";
+
+    ofstream out(path, ios::app);
+    if (!out) return;
+
+    time_t now = time(nullptr);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+
+    for (int op = 0; op < OP_COUNT; ++op) {
+        vector<double> v = all.micros[op];
+        if (v.empty()) continue;
+        sort(v.begin(), v.end());
+        out << stamp << " loadgen op=" << OP_NAMES[op]
+            << " shoppers=" << opt.shoppers
+            << " ops=" << v.size()
+            << " errors=" << all.errors[op]
+            << " ops_per_s=" << (long)(v.size() / seconds)
+            << " p50_us=" << (long)percentile(v, 0.50)
+            << " p99_us=" << (long)percentile(v, 0.99) << "\n";
+    }
+}
+
+void usage() {
+    cout << "Usage: loadgen [--shoppers N] [--seconds N] "
+            "[--mix browse=40,search=30,cart=20,checkout=5,orders=5] "
+            "[--think-ms N] [--seed N] [--warm]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (a == "--shoppers" && hasValue) opt.shoppers = max(1, atoi(argv[++i]));
+        else if (a == "--seconds" && hasValue) opt.seconds = max(1, atoi(argv[++i]));
+        else if (a == "--think-ms" && hasValue) opt.thinkMs = max(0, atoi(argv[++i]));
+        else if (a == "--seed" && hasValue) opt.seed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--warm") opt.warm = true;
+        else if (a == "--mix" && hasValue) {
+            if (!parseMix(argv[++i], opt.mix)) {
+                usage();
+                return 1;
+            }
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    sql::Connection* con = nullptr;
+    try {
+        con = createConnection();
+    } catch (sql::SQLException &e) {
+        return 1;
+    }
+
+    vector<Shopper> accounts;
+    vector<int> productIds;
+    vector<string> terms;
+    bool ready = loadFixtures(con, (size_t)opt.shoppers, accounts, productIds, terms);
+    con->close();
+    delete con;
+
+    if (!ready) {
+        cout << "❌ Need at least one customer with an address and one in-stock product.\n";
+        return 1;
+    }
+    if ((int)accounts.size() < opt.shoppers)
+        cout << "⚠ Only " << accounts.size() << " customers with an address; "
+             << "shoppers will share carts.\n";
+
+    if (opt.warm) {
+        WarmupStats w = warmCatalogCache(4);
+        cout << "Catalog cache warmed in " << (long)w.millis << " ms\n";
+    }
+
+    cout << "Running " << opt.shoppers << " shoppers for " << opt.seconds << " s ...\n";
+
+    NullBuf quiet;
+    ErrorBuf errors;
+    streambuf* oldOut = cout.rdbuf(&quiet);
+    streambuf* oldErr = cerr.rdbuf(&errors);
+
+    vector<OpSamples> samples((size_t)opt.shoppers);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    auto deadline = start + chrono::seconds(opt.seconds);
+
+    for (int i = 0; i < opt.shoppers; ++i)
+        threads.emplace_back(runShopper, cref(opt), accounts[(size_t)i % accounts.size()],
+                             cref(productIds), cref(terms), opt.seed + (unsigned)i,
+                             deadline, ref(samples[(size_t)i]));
+    for (auto &t : threads) t.join();
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(oldOut);
+    cerr.rdbuf(oldErr);
+
+    OpSamples all;
+    for (auto &s : samples)
+        for (int op = 0; op < OP_COUNT; ++op) {
+            all.micros[op].insert(all.micros[op].end(), s.micros[op].begin(), s.micros[op].end());
+            all.errors[op] += s.errors[op];
+        }
+
+    long totalOps = 0, totalErrors = 0;
+
+    cout << "\n================================ LOAD REPORT ================================\n";
+    cout << left << setw(10) << "Op" << right
+         << setw(9) << "Ops" << setw(8) << "Errors" << setw(10) << "Ops/s"
+         << setw(10) << "p50 ms" << setw(10) << "p90 ms"
+         << setw(10) << "p99 ms" << setw(10) << "max ms" << "\n";
+    cout << string(77, '-') << "\n";
+    cout << fixed;
+
+    for (int op = 0; op < OP_COUNT; ++op) {
+        vector<double> v = all.micros[op];
+        sort(v.begin(), v.end());
+        totalOps += (long)v.size();
+        totalErrors += all.errors[op];
+
+        cout << left << setw(10) << OP_NAMES[op] << right
+             << setw(9) << v.size() << setw(8) << all.errors[op]
+             << setw(10) << setprecision(1) << v.size() / elapsed
+             << setprecision(2)
+             << setw(10) << percentile(v, 0.50) / 1000
+             << setw(10) << percentile(v, 0.90) / 1000
+             << setw(10) << percentile(v, 0.99) / 1000
+             << setw(10) << (v.empty() ? 0.0 : v.back() / 1000) << "\n";
+    }
+
+    cout << string(77, '-') << "\n";
+    cout << "Total: " << totalOps << " ops in " << setprecision(1) << elapsed << " s = "
+         << totalOps / elapsed << " ops/s, " << totalErrors << " failed\n";
+
+    QueryCacheStats rc = productResultCache().stats();
+    if (rc.hits + rc.misses > 0)
+        cout << "Result cache: " << rc.hits << " hits, " << rc.misses << " misses ("
+             << 100 * rc.hits / (rc.hits + rc.misses) << "% hit), " << rc.evictions << " evicted, "
+             << rc.entries << " entries / " << rc.bytes / 1024 << " KB\n";
+
+    if (errors.lines > 0) {
+        cout << "\n" << errors.lines << " error line(s) logged, first:\n";
+        for (auto &l : errors.first) cout << "  " << l << "\n";
+    }
+
+    appendMetrics(opt, all, elapsed);
+    logResultCacheStats();
+    return totalErrors > 0 ? 2 : 0;
+}
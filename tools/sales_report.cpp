@@ -0,0 +1,158 @@
+// sales_report.cpp
+// Loads the order lines into the columnar analytics store (from the replica
+// when one is configured) and prints sales reports with query timings.
+//
+//   sales_report [--from YYYY-MM-DD] [--to YYYY-MM-DD] [--category C]
+//                [--top N] [--by-quantity] [--threads N] [--repeat N]
+//                [--report daily|top|brands|all]
+//
+// Without --from/--to the daily report covers the last 7 days with sales and
+// the other reports cover everything. --repeat runs every query N times and
+// reports the best time (the load itself is done once).
+
+#include "SalesAnalytics.h"
+#include "DBRouter.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+
+#include <cppconn/exception.h>
+
+using namespace std;
+
+static void usage() {
+    cout << "Usage: sales_report [--from YYYY-MM-DD] [--to YYYY-MM-DD] [--category C]\n"
+            "                    [--top N] [--by-quantity] [--threads N] [--repeat N]\n"
+            "                    [--report daily|top|brands|all]\n";
+}
+
+// Best wall time of `repeat` runs of fn, in milliseconds
+template <typename Fn>
+static double bestOf(int repeat, Fn fn) {
+    double best = 0.0;
+    for (int i = 0; i < repeat; ++i) {
+        auto t0 = chrono::steady_clock::now();
+        fn();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        if (i == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int from = INT_MIN, to = INT_MAX;
+    string category, report = "all";
+    size_t top = 10;
+    bool byQuantity = false;
+    int threads = 0, repeat = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = true;
+
+        if (a == "--from" && hasValue) ok = (from = dayNumber(argv[++i])) != INT_MIN;
+        else if (a == "--to" && hasValue) ok = (to = dayNumber(argv[++i])) != INT_MIN;
+        else if (a == "--category" && hasValue) category = argv[++i];
+        else if (a == "--top" && hasValue) top = strtoul(argv[++i], nullptr, 10);
+        else if (a == "--by-quantity") byQuantity = true;
+        else if (a == "--threads" && hasValue) threads = atoi(argv[++i]);
+        else if (a == "--repeat" && hasValue) ok = (repeat = atoi(argv[++i])) > 0;
+        else if (a == "--report" && hasValue) {
+            report = argv[++i];
+            ok = report == "daily" || report == "top" || report == "brands" || report == "all";
+        }
+        else ok = false;
+
+        if (!ok) {
+            usage();
+            return 1;
+        }
+    }
+
+    sql::Connection* con = nullptr;
+    try {
+        con = createReadConnection();
+    } catch (sql::SQLException &e) {
+        cout << "Failed to connect to DB: " << e.what() << endl;
+        return 1;
+    }
+
+    SalesAnalytics sales(threads);
+    auto t0 = chrono::steady_clock::now();
+    bool loaded = sales.refresh(con);
+    double loadSec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    con->close();
+    delete con;
+
+    if (!loaded) {
+        cout << "❌ Failed to load order lines.\n";
+        return 1;
+    }
+    cout << "Loaded " << sales.lineCount() << " order lines, " << sales.productCount()
+         << " products in " << fixed << setprecision(1) << loadSec << " s ("
+         << sales.memoryBytes() / (1024 * 1024) << " MiB, "
+         << sales.threadCount() << " query threads)\n";
+    if (sales.lineCount() == 0) return 0;
+
+    if (report == "daily" || report == "all") {
+        int dFrom = from, dTo = to;
+        if (from == INT_MIN && to == INT_MAX) dFrom = sales.lastDay() - 6;
+
+        vector<CategoryDayRevenue> rows;
+        double ms = bestOf(repeat, [&] { rows = sales.revenueByCategoryDay(dFrom, dTo); });
+
+        cout << "\n=========== REVENUE BY CATEGORY / DAY ===========\n";
+        cout << left << setw(24) << "Category" << setw(12) << "Day"
+             << right << setw(14) << "Revenue" << setw(10) << "Units" << "\n";
+        cout << string(60, '-') << "\n";
+        for (auto &r : rows) {
+            if (!category.empty() && r.category != category) continue;
+            cout << left << setw(24) << r.category << setw(12) << dayString(r.day)
+                 << right << setw(14) << setprecision(2) << r.revenue
+                 << setw(10) << r.quantity << "\n";
+        }
+        cout << "(" << setprecision(1) << ms << " ms)\n";
+    }
+
+    if (report == "top" || report == "all") {
+        vector<ProductSales> rows;
+        double ms = bestOf(repeat, [&] { rows = sales.topSellers(top, from, to, category, byQuantity); });
+
+        cout << "\n================== TOP SELLERS ==================\n";
+        cout << left << setw(5) << "#" << setw(10) << "PID" << setw(36) << "Product"
+             << right << setw(14) << "Revenue" << setw(10) << "Units" << "\n";
+        cout << string(75, '-') << "\n";
+        int rank = 1;
+        for (auto &r : rows) {
+            cout << left << setw(5) << rank++ << setw(10) << r.productId
+                 << setw(36) << r.name.substr(0, 34)
+                 << right << setw(14) << setprecision(2) << r.revenue
+                 << setw(10) << r.quantity << "\n";
+        }
+        cout << "(" << setprecision(1) << ms << " ms)\n";
+    }
+
+    if (report == "brands" || report == "all") {
+        vector<BrandShare> rows;
+        double ms = bestOf(repeat, [&] { rows = sales.brandShare(from, to, category); });
+
+        cout << "\n================== BRAND SHARE ==================\n";
+        cout << left << setw(30) << "Company" << right << setw(14) << "Revenue"
+             << setw(9) << "Share" << "\n";
+        cout << string(53, '-') << "\n";
+        for (size_t i = 0; i < rows.size() && i < top; ++i) {
+            cout << left << setw(30) << rows[i].company.substr(0, 28)
+                 << right << setw(14) << setprecision(2) << rows[i].revenue
+                 << setw(8) << setprecision(1) << rows[i].share * 100 << "%\n";
+        }
+        if (rows.size() > top) cout << "... " << rows.size() - top << " more\n";
+        cout << "(" << setprecision(1) << ms << " ms)\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,487 @@
+// shard_rebalance.cpp
+// Sets up customer shards and moves customers between them (see ShardRouter.h).
+//
+//   shard_rebalance --init                  create SHARD_MAP (every bucket on shard 0),
+//                                           the customer tables in local shard
+//                                           schemas, and each shard's id range
+//   shard_rebalance --status                buckets and rows per shard
+//   shard_rebalance --move BUCKET SHARD     move one bucket
+//   shard_rebalance --balance [--dry-run] [--batch N]
+//                                           spread buckets evenly (bucket % shards),
+//                                           N buckets per step (default 32)
+//   shard_rebalance --cleanup               delete rows left on shards that no
+//                                           longer own their bucket (not while
+//                                           a move is running)
+//
+// A move marks its buckets as moving and waits until every process has
+// reloaded the shard map (PROJECT1_SHARD_MAP_SECONDS + 2), so their customers
+// can read but not write. A process that cannot reload it stops writing by
+// then (shardMapMaxAge()). It then copies the rows in one transaction on the
+// new shard, points the buckets there, waits again until nobody reads the old
+// copies, and deletes them. An interrupted move can be run again.
+//
+// For a local test: PROJECT1_DB_SHARDS="shop,shop_s1,shop_s2" with shop the
+// global schema, then --init, --balance, and loadgen.
+
+#include "ShardRouter.h"
+#include "DBFunctions.h"
+#include "DBRouter.h"
+#include "BatchInsert.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/exception.h>
+
+using namespace std;
+
+static const int DEFAULT_BATCH = 32;
+static const size_t COPY_ROWS = 500;        // rows per multi-row INSERT
+
+// Customer-owned tables in insert order (deletes run in reverse).
+// OrderItems has no customer column; its rows follow their Orders row.
+struct OwnedTable {
+    const char* name;
+    const char* customerColumn;
+};
+
+static const OwnedTable TABLES[] = {
+    {"Cart", "Customer_ID"},
+    {"WISHLIST", "CustomerID"},
+    {"ADDRESS", "CustomerID"},
+    {"Orders", "CustomerID"},
+    {"OrderItems", nullptr},
+};
+static const int TABLE_COUNT = sizeof(TABLES) / sizeof(TABLES[0]);
+
+static void usage() {
+    cout << "Usage: shard_rebalance --init | --status | --move BUCKET SHARD |\n"
+            "                       --balance [--dry-run] [--batch N] | --cleanup\n";
+}
+
+static int execUpdate(sql::Connection* con, const string &sql) {
+    sql::Statement* stmt = con->createStatement();
+    int rows = 0;
+    try {
+        rows = stmt->executeUpdate(sql);
+    } catch (...) {
+        delete stmt;
+        throw;
+    }
+    delete stmt;
+    return rows;
+}
+
+// Bucket numbers are ints we produced, so they are inlined
+static string bucketList(const vector<int> &buckets) {
+    string s;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        if (i) s += ", ";
+        s += to_string(buckets[i]);
+    }
+    return s;
+}
+
+static string inBuckets(const string &column, const string &buckets) {
+    return column + " % " + to_string(SHARD_BUCKETS) + " IN (" + buckets + ")";
+}
+
+static string deleteSQL(const OwnedTable &t, const string &buckets) {
+    if (t.customerColumn)
+        return string("DELETE FROM ") + t.name + " WHERE " + inBuckets(t.customerColumn, buckets);
+    return "DELETE oi FROM OrderItems oi JOIN Orders o ON oi.OrderID = o.OrderID "
+           "WHERE " + inBuckets("o.CustomerID", buckets);
+}
+
+static vector<string> columnsOf(sql::Connection* con, const string &table) {
+    vector<string> cols;
+    sql::PreparedStatement* pstmt = con->prepareStatement(
+        "SELECT COLUMN_NAME FROM information_schema.COLUMNS "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? ORDER BY ORDINAL_POSITION"
+    );
+    pstmt->setString(1, table);
+    sql::ResultSet* res = pstmt->executeQuery();
+    while (res->next()) cols.push_back(res->getString(1));
+    delete res;
+    delete pstmt;
+    return cols;
+}
+
+// Copies the buckets' rows of one table; returns rows copied
+static long copyTable(sql::Connection* from, sql::Connection* to, const OwnedTable &t,
+                      const string &buckets) {
+    vector<string> cols = columnsOf(from, t.name);
+    if (cols.empty()) throw sql::SQLException(string("table ") + t.name + " not found on the source shard");
+
+    string list, selected;
+    for (size_t i = 0; i < cols.size(); ++i) {
+        string c = "`" + cols[i] + "`";
+        list += (i ? ", " : "") + c;
+        selected += (i ? ", " : "") + (t.customerColumn ? c : "oi." + c);
+    }
+    string select = t.customerColumn
+        ? "SELECT " + selected + " FROM " + t.name + " WHERE " + inBuckets(t.customerColumn, buckets)
+        : "SELECT " + selected + " FROM OrderItems oi JOIN Orders o ON oi.OrderID = o.OrderID "
+          "WHERE " + inBuckets("o.CustomerID", buckets);
+
+    int ncols = (int)cols.size();
+    MultiRowStatement insert(to, string("INSERT INTO ") + t.name + " (" + list + ")", ncols, COPY_ROWS);
+    vector<string> values;
+    vector<char> nulls;
+    values.reserve(COPY_ROWS * ncols);
+    nulls.reserve(COPY_ROWS * ncols);
+
+    auto flush = [&]() {
+        size_t rows = values.size() / ncols;
+        if (rows == 0) return;
+        sql::PreparedStatement* ps = insert.begin(rows);
+        for (size_t r = 0; r < rows; ++r) {
+            for (int c = 0; c < ncols; ++c) {
+                size_t i = r * ncols + c;
+                if (nulls[i]) ps->setNull(insert.param(r, c), sql::DataType::VARCHAR);
+                else ps->setString(insert.param(r, c), values[i]);
+            }
+        }
+        ps->executeUpdate();
+        values.clear();
+        nulls.clear();
+    };
+
+    long copied = 0;
+    sql::Statement* stmt = from->createStatement();
+    sql::ResultSet* res = nullptr;
+    try {
+        res = stmt->executeQuery(select);
+        while (res->next()) {
+            for (int c = 1; c <= ncols; ++c) {
+                bool isNull = res->isNull(c);
+                nulls.push_back(isNull);
+                values.push_back(isNull ? string() : string(res->getString(c)));
+            }
+            ++copied;
+            if (values.size() == COPY_ROWS * ncols) flush();
+        }
+        flush();
+    } catch (...) {
+        delete res;
+        delete stmt;
+        throw;
+    }
+    delete res;
+    delete stmt;
+    return copied;
+}
+
+// Deletes the buckets' rows from one shard in one transaction; returns rows deleted
+static long deleteBuckets(sql::Connection* con, const string &buckets) {
+    long rows = 0;
+    con->setAutoCommit(false);
+    try {
+        for (int i = TABLE_COUNT - 1; i >= 0; --i) rows += execUpdate(con, deleteSQL(TABLES[i], buckets));
+        con->commit();
+    } catch (...) {
+        try {
+            con->rollback();
+        } catch (sql::SQLException &) {}
+        con->setAutoCommit(true);
+        throw;
+    }
+    con->setAutoCommit(true);
+    return rows;
+}
+
+static bool loadMap(sql::Connection* global, vector<int> &shard, vector<bool> &moving) {
+    shard.assign(SHARD_BUCKETS, 0);
+    moving.assign(SHARD_BUCKETS, false);
+    sql::Statement* stmt = global->createStatement();
+    sql::ResultSet* res = nullptr;
+    try {
+        res = stmt->executeQuery("SELECT Bucket, Shard, Moving FROM SHARD_MAP");
+        while (res->next()) {
+            int b = res->getInt(1);
+            if (b < 0 || b >= SHARD_BUCKETS) continue;
+            shard[b] = res->getInt(2);
+            moving[b] = res->getInt(3) != 0;
+        }
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error reading SHARD_MAP: " << e.what() << endl;
+        cout << "❌ Run shard_rebalance --init first.\n";
+        delete res;
+        delete stmt;
+        return false;
+    }
+    delete res;
+    delete stmt;
+    return true;
+}
+
+static void waitForProcesses(const char* why) {
+    int seconds = shardMapMaxAge() + 1;
+    cout << "   waiting " << seconds << " s " << why << " ...\n";
+    this_thread::sleep_for(chrono::seconds(seconds));
+}
+
+// ---------------------------------------------
+// Moving buckets
+// ---------------------------------------------
+static bool moveBuckets(sql::Connection* global, vector<sql::Connection*> &shards,
+                        int from, int to, const vector<int> &buckets) {
+    string in = bucketList(buckets);
+    cout << "Shard " << from << " -> " << to << ": " << buckets.size() << " bucket(s)\n";
+
+    // 1) stop writes to these customers
+    execUpdate(global, "UPDATE SHARD_MAP SET Moving = 1 WHERE Bucket IN (" + in + ")");
+    waitForProcesses("for every process to stop writing to them");
+
+    // 2) copy; rows already on the target are from an interrupted move
+    sql::Connection* dst = shards[to];
+    long copied = 0;
+    try {
+        dst->setAutoCommit(false);
+        for (int i = TABLE_COUNT - 1; i >= 0; --i) execUpdate(dst, deleteSQL(TABLES[i], in));
+        for (int i = 0; i < TABLE_COUNT; ++i) copied += copyTable(shards[from], dst, TABLES[i], in);
+        dst->commit();
+        dst->setAutoCommit(true);
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error copying buckets: " << e.what() << endl;
+        try {
+            dst->rollback();
+            dst->setAutoCommit(true);
+        } catch (sql::SQLException &) {}
+        execUpdate(global, "UPDATE SHARD_MAP SET Moving = 0 WHERE Bucket IN (" + in + ")");
+        cout << "❌ Move abandoned; the buckets stay on shard " << from << ".\n";
+        return false;
+    }
+    cout << "   copied " << copied << " rows\n";
+
+    // 3) switch
+    execUpdate(global, "UPDATE SHARD_MAP SET Shard = " + to_string(to) +
+                       ", Moving = 0 WHERE Bucket IN (" + in + ")");
+
+    // 4) drop the old copies once nobody reads them
+    waitForProcesses("for every process to read from the new shard");
+    long removed = deleteBuckets(shards[from], in);
+    cout << "   deleted " << removed << " rows from shard " << from << "\n";
+    return true;
+}
+
+// Buckets whose shard differs from `target`, grouped by (from, to), in steps of `batch`
+static bool moveToLayout(sql::Connection* global, vector<sql::Connection*> &shards,
+                         const vector<int> &target, int batch, bool dryRun) {
+    vector<int> current;
+    vector<bool> moving;
+    if (!loadMap(global, current, moving)) return false;
+
+    map<pair<int, int>, vector<int>> plan;
+    int total = 0;
+    for (int b = 0; b < SHARD_BUCKETS; ++b) {
+        if (target[b] < 0 || current[b] == target[b]) continue;
+        if (current[b] < 0 || current[b] >= (int)shards.size()) {
+            cout << "⚠ Bucket " << b << " is on unknown shard " << current[b] << ", skipped.\n";
+            continue;
+        }
+        plan[{current[b], target[b]}].push_back(b);
+        ++total;
+    }
+
+    if (total == 0) {
+        cout << "✔ Nothing to move.\n";
+        return true;
+    }
+    for (auto &step : plan)
+        cout << "shard " << step.first.first << " -> " << step.first.second << ": "
+             << step.second.size() << " bucket(s)\n";
+    cout << total << " bucket(s) to move.\n";
+    if (dryRun) return true;
+
+    for (auto &step : plan) {
+        const vector<int> &buckets = step.second;
+        for (size_t i = 0; i < buckets.size(); i += batch) {
+            vector<int> part(buckets.begin() + i,
+                             buckets.begin() + min(buckets.size(), i + (size_t)batch));
+            if (!moveBuckets(global, shards, step.first.first, step.first.second, part)) return false;
+        }
+    }
+    cout << "✔ Done.\n";
+    return true;
+}
+
+// ---------------------------------------------
+// Setup and reporting
+// ---------------------------------------------
+static bool init(sql::Connection* global, vector<sql::Connection*> &shards) {
+    execUpdate(global,
+        "CREATE TABLE IF NOT EXISTS SHARD_MAP ("
+        "  Bucket INT NOT NULL PRIMARY KEY,"
+        "  Shard INT NOT NULL DEFAULT 0,"
+        "  Moving TINYINT NOT NULL DEFAULT 0"
+        ")");
+    {
+        MultiRowStatement insert(global, "INSERT IGNORE INTO SHARD_MAP (Bucket, Shard)", 2, SHARD_BUCKETS);
+        sql::PreparedStatement* ps = insert.begin(SHARD_BUCKETS);
+        for (int b = 0; b < SHARD_BUCKETS; ++b) {
+            ps->setInt(insert.param(b, 0), b);
+            ps->setInt(insert.param(b, 1), 0);
+        }
+        ps->executeUpdate();
+    }
+    cout << "✔ SHARD_MAP ready (buckets without a row start on shard 0).\n";
+
+    DBEndpoint primary;
+    dbEndpoint(DB_PRIMARY, primary);
+
+    for (int k = 0; k < (int)shards.size(); ++k) {
+        DBEndpoint ep;
+        shardEndpoint(k, ep);
+
+        // schemas on the primary get their tables from the global schema
+        if (!isGlobalShard(k) && ep.url == primary.url) {
+            execUpdate(global, "CREATE DATABASE IF NOT EXISTS `" + ep.schema + "`");
+            for (const OwnedTable &t : TABLES)
+                execUpdate(global, "CREATE TABLE IF NOT EXISTS `" + ep.schema + "`." + t.name +
+                                   " LIKE " + t.name);
+        }
+
+        for (const OwnedTable &t : TABLES) {
+            if (columnsOf(shards[k], t.name).empty()) {
+                cout << "⚠ Shard " << k << " (" << ep.schema << ") has no " << t.name
+                     << " table; create it there before moving customers.\n";
+                continue;
+            }
+            // disjoint id ranges, so moved rows keep their ids
+            if (k > 0)
+                execUpdate(shards[k], string("ALTER TABLE ") + t.name + " AUTO_INCREMENT = " +
+                                      to_string(k * SHARD_ID_STRIDE + 1));
+        }
+        cout << "✔ Shard " << k << " (" << ep.schema << ") ready.\n";
+    }
+    return true;
+}
+
+static bool status(sql::Connection* global, vector<sql::Connection*> &shards) {
+    vector<int> current;
+    vector<bool> moving;
+    if (!loadMap(global, current, moving)) return false;
+
+    cout << left << setw(7) << "Shard" << setw(20) << "Schema" << setw(9) << "Buckets";
+    for (const OwnedTable &t : TABLES) cout << setw(12) << t.name;
+    cout << "\n" << string(36 + 12 * TABLE_COUNT, '-') << "\n";
+
+    for (int k = 0; k < (int)shards.size(); ++k) {
+        DBEndpoint ep;
+        shardEndpoint(k, ep);
+        int buckets = 0;
+        for (int b = 0; b < SHARD_BUCKETS; ++b) buckets += current[b] == k;
+
+        cout << left << setw(7) << k << setw(20) << ep.schema << setw(9) << buckets;
+        for (const OwnedTable &t : TABLES) {
+            string count = "-";
+            try {
+                sql::Statement* stmt = shards[k]->createStatement();
+                sql::ResultSet* res = stmt->executeQuery(string("SELECT COUNT(*) FROM ") + t.name);
+                if (res->next()) count = to_string(res->getInt64(1));
+                delete res;
+                delete stmt;
+            } catch (sql::SQLException &) {}
+            cout << setw(12) << count;
+        }
+        cout << "\n";
+    }
+
+    vector<int> inFlight;
+    for (int b = 0; b < SHARD_BUCKETS; ++b)
+        if (moving[b]) inFlight.push_back(b);
+    if (!inFlight.empty())
+        cout << "\n⚠ Moving (writes refused): buckets " << bucketList(inFlight)
+             << ". If no move is running, run --move again for them.\n";
+    return true;
+}
+
+static bool cleanup(sql::Connection* global, vector<sql::Connection*> &shards) {
+    vector<int> current;
+    vector<bool> moving;
+    if (!loadMap(global, current, moving)) return false;
+
+    for (int k = 0; k < (int)shards.size(); ++k) {
+        vector<int> foreign;
+        for (int b = 0; b < SHARD_BUCKETS; ++b)
+            if (current[b] != k && !moving[b]) foreign.push_back(b);
+        if (foreign.empty()) continue;
+        long removed = deleteBuckets(shards[k], bucketList(foreign));
+        cout << "Shard " << k << ": deleted " << removed << " stray rows\n";
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { usage(); return 1; }
+    string cmd = argv[1];
+
+    if (!shardingEnabled()) {
+        cout << "❌ PROJECT1_DB_SHARDS is not set; nothing to rebalance.\n";
+        return 1;
+    }
+
+    sql::Connection* global = nullptr;
+    vector<sql::Connection*> shards;
+    int rc = 0;
+    try {
+        global = createConnection();
+        for (int k = 0; k < shardCount(); ++k) shards.push_back(openShardConnection(k));
+
+        if (cmd == "--init") {
+            rc = init(global, shards) ? 0 : 1;
+        } else if (cmd == "--status") {
+            rc = status(global, shards) ? 0 : 1;
+        } else if (cmd == "--move" && argc > 3) {
+            int bucket = atoi(argv[2]);
+            int to = atoi(argv[3]);
+            if (bucket < 0 || bucket >= SHARD_BUCKETS || to < 0 || to >= shardCount()) {
+                usage();
+                rc = 1;
+            } else {
+                vector<int> target(SHARD_BUCKETS, -1);
+                target[bucket] = to;
+                rc = moveToLayout(global, shards, target, 1, false) ? 0 : 1;
+            }
+        } else if (cmd == "--balance") {
+            bool dryRun = false;
+            int batch = DEFAULT_BATCH;
+            for (int i = 2; i < argc; ++i) {
+                string a = argv[i];
+                if (a == "--dry-run") dryRun = true;
+                else if (a == "--batch" && i + 1 < argc) batch = max(1, atoi(argv[++i]));
+            }
+            vector<int> target(SHARD_BUCKETS);
+            for (int b = 0; b < SHARD_BUCKETS; ++b) target[b] = b % shardCount();
+            rc = moveToLayout(global, shards, target, batch, dryRun) ? 0 : 1;
+        } else if (cmd == "--cleanup") {
+            rc = cleanup(global, shards) ? 0 : 1;
+        } else {
+            usage();
+            rc = 1;
+        }
+    } catch (sql::SQLException &e) {
+        cerr << "SQL Error in shard_rebalance: " << e.what() << endl;
+        rc = 1;
+    }
+
+    for (sql::Connection* con : shards) {
+        con->close();
+        delete con;
+    }
+    if (global) {
+        global->close();
+        delete global;
+    }
+    return rc;
+}